@@ -17,6 +17,9 @@ static CircularBuffer::Spec LoadSpec(std::string_view exeName) {
         std::getline(fin, spec.dataSharedMemoryName);
         std::getline(fin, tmp);
         spec.bufferCapacity = std::stoul(tmp);
+        if (std::getline(fin, tmp) && !tmp.empty()) {
+            spec.enableStats = std::stoi(tmp) != 0;
+        }
     };
 
     CircularBuffer::Spec spec;
@@ -0,0 +1,90 @@
+#include "circularbuffer/BasicRing.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Reader.hpp"
+#include "circularbuffer/RingPolicies.hpp"
+#include "circularbuffer/Spec.hpp"
+#include "circularbuffer/Writer.hpp"
+#include "spdlog/common.h"
+#include "spdlog/spdlog.h"
+
+using namespace CircularBuffer;
+
+static constexpr size_t CAPACITY = 1024 * 1024;
+
+// Lossy ring with runtime capacity, to isolate the cost of the mask
+using DynamicLossyRing = BasicRing<Size32Header, DynamicCapacity, Overwrite,
+                                   SpinWait, NoInstrumentation>;
+
+// Writes a message of `state.range(0)` bytes per iteration to a 1 MiB ring,
+// read back in the same thread
+template <typename Ring>
+void BM_BasicRingWriteRead(benchmark::State& state) {
+    // Disable logging
+    spdlog::set_level(spdlog::level::off);
+
+    const int msgSize = state.range(0);
+    std::vector<DataT> writeBuffer(msgSize, DataT{'\1'});
+    std::vector<DataT> readBuffer(msgSize);
+
+    const BasicRingSpec spec{"/bench-basic-ring", CAPACITY};
+    typename Ring::Writer writer(spec);
+    typename Ring::Reader reader(spec);
+
+    for (auto _ : state) {
+        writer.Write(writeBuffer);
+        benchmark::DoNotOptimize(reader.Read(readBuffer));
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * msgSize);
+}
+
+// Same as `BM_BasicRingWriteRead` with the spec-framed rings: `Writer` and
+// `Reader`, or `LeanWriter` and `LeanReader`
+template <typename Ring>
+void BM_SpecRingWriteRead(benchmark::State& state) {
+    // Disable logging
+    spdlog::set_level(spdlog::level::off);
+
+    const int msgSize = state.range(0);
+    std::vector<DataT> writeBuffer(msgSize, DataT{'\1'});
+    std::vector<DataT> readBuffer(msgSize);
+
+    const Spec spec{"/bench-index", "/bench-data", CAPACITY};
+    typename Ring::Writer writer(spec);
+    typename Ring::Reader reader(spec);
+
+    for (auto _ : state) {
+        writer.Write(writeBuffer);
+        benchmark::DoNotOptimize(reader.Read(readBuffer));
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * msgSize);
+}
+
+BENCHMARK(BM_BasicRingWriteRead<LossyRing<CAPACITY>>)
+    ->Name("BM_LossyRingWriteRead")
+    ->RangeMultiplier(8)
+    ->Range(8, 512);  // Message size
+BENCHMARK(BM_BasicRingWriteRead<DynamicLossyRing>)
+    ->Name("BM_DynamicLossyRingWriteRead")
+    ->RangeMultiplier(8)
+    ->Range(8, 512);  // Message size
+BENCHMARK(BM_BasicRingWriteRead<LosslessRing>)
+    ->Name("BM_LosslessRingWriteRead")
+    ->RangeMultiplier(8)
+    ->Range(8, 512);  // Message size
+BENCHMARK(BM_SpecRingWriteRead<SpecRing>)
+    ->Name("BM_WriterReaderWriteRead")
+    ->RangeMultiplier(8)
+    ->Range(8, 512);  // Message size
+BENCHMARK(BM_SpecRingWriteRead<LeanSpecRing>)
+    ->Name("BM_LeanWriterReaderWriteRead")
+    ->RangeMultiplier(8)
+    ->Range(8, 512);  // Message size
+
+BENCHMARK_MAIN();
@@ -0,0 +1,103 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <thread>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/BridgePublisher.hpp"
+#include "circularbuffer/BridgeSubscriber.hpp"
+#include "circularbuffer/Reader.hpp"
+#include "circularbuffer/Spec.hpp"
+#include "circularbuffer/Writer.hpp"
+#include "spdlog/common.h"
+#include "spdlog/spdlog.h"
+
+using namespace CircularBuffer;
+
+namespace {
+
+// The bridge needs message numbers
+const Spec publisherSpec = [] {
+    Spec spec{"/bench-index", "/bench-data", 16 * 1024 * 1024};
+    spec.seekInterval = 64;
+    return spec;
+}();
+const Spec subscriberSpec{"/bench-index-2", "/bench-data-2",
+                          16 * 1024 * 1024};
+
+// Replicates a ring over loopback, into a second ring read by `reader`
+struct Loopback {
+    Loopback()
+        : writer(publisherSpec),
+          publisher(publisherSpec, 0, {.address = "127.0.0.1"}),
+          subscriber(subscriberSpec, "127.0.0.1", publisher.Port()),
+          reader(subscriberSpec) {
+        while (publisher.Connections() == 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    Writer writer;
+    BridgePublisher publisher;
+    BridgeSubscriber subscriber;
+    Reader reader;
+};
+
+}  // namespace
+
+// Time from writing a message of `state.range(0)` bytes to reading it from the
+// subscriber's ring: the latency the bridge adds over loopback
+void BM_BridgeLatency(benchmark::State& state) {
+    // Disable logging
+    spdlog::set_level(spdlog::level::off);
+
+    const int msgSize = state.range(0);
+    DataT* buffer = new DataT[MAX_MESSAGE_SIZE]{};
+    Loopback loopback;
+
+    // Benchmark
+    for (auto _ : state) {
+        loopback.writer.Write(buffer, msgSize);
+        while (loopback.reader.Read(buffer, MAX_MESSAGE_SIZE) == 0) {
+            std::this_thread::yield();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    delete[] buffer;
+}
+
+// Writes batches of 1000 messages of `state.range(0)` bytes and waits for them
+// to be read from the subscriber's ring: throughput with batched socket writes
+void BM_BridgeThroughput(benchmark::State& state) {
+    // Disable logging
+    spdlog::set_level(spdlog::level::off);
+
+    const int msgSize = state.range(0);
+    const int batchSize = 1000;
+    DataT* buffer = new DataT[MAX_MESSAGE_SIZE]{};
+    Loopback loopback;
+
+    // Benchmark
+    for (auto _ : state) {
+        for (int i = 0; i < batchSize; i++) {
+            loopback.writer.Write(buffer, msgSize);
+        }
+        for (int i = 0; i < batchSize;) {
+            if (loopback.reader.Read(buffer, MAX_MESSAGE_SIZE) > 0) {
+                i++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * batchSize);
+    state.SetBytesProcessed(state.iterations() * batchSize * msgSize);
+
+    delete[] buffer;
+}
+
+BENCHMARK(BM_BridgeLatency)->Arg(64)->Arg(1024)->UseRealTime();
+BENCHMARK(BM_BridgeThroughput)->Arg(64)->Arg(1024)->UseRealTime();
+
+BENCHMARK_MAIN();
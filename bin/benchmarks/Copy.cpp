@@ -0,0 +1,82 @@
+#include "circularbuffer/Copy.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace CircularBuffer;
+
+// Number of sizes cycled through by the random-size benchmarks
+static constexpr size_t NUM_RANDOM_SIZES = 4096;
+
+static std::vector<size_t> RandomSizes(size_t max) {
+    std::default_random_engine rng(42);
+    std::uniform_int_distribution<size_t> dist(1, max);
+
+    std::vector<size_t> sizes(NUM_RANDOM_SIZES);
+    for (size_t& size : sizes) {
+        size = dist(rng);
+    }
+    return sizes;
+}
+
+// Fixed size per benchmark: best case for branch prediction
+template <void (*Copy)(void*, const void*, size_t)>
+void BM_CopyFixed(benchmark::State& state) {
+    const size_t size = state.range(0);
+    std::vector<char> src(size, '\1');
+    std::vector<char> dst(size);
+
+    for (auto _ : state) {
+        Copy(dst.data(), src.data(), size);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * size);
+}
+
+// Sizes drawn uniformly from [1, range(0)]: realistic mix of size classes
+template <void (*Copy)(void*, const void*, size_t)>
+void BM_CopyRandom(benchmark::State& state) {
+    const std::vector<size_t> sizes = RandomSizes(state.range(0));
+    std::vector<char> src(state.range(0), '\1');
+    std::vector<char> dst(state.range(0));
+
+    size_t i = 0;
+    for (auto _ : state) {
+        Copy(dst.data(), src.data(), sizes[i++ % NUM_RANDOM_SIZES]);
+        benchmark::ClobberMemory();
+    }
+}
+
+// Out-of-line wrapper so the size isn't known at the call site, as in
+// Writer::Write/Reader::Read
+static void Memcpy(void* dst, const void* src, size_t size) {
+    std::memcpy(dst, src, size);
+}
+
+// CopySmall only handles up to SMALL_COPY_MAX bytes; CopyMessage is the
+// dispatcher Writer::Write/Reader::Read call, covering larger sizes too
+BENCHMARK(BM_CopyFixed<Memcpy>)->Name("BM_Memcpy")->DenseRange(1, 256, 15);
+BENCHMARK(BM_CopyFixed<CopySmall>)
+    ->Name("BM_CopySmall")
+    ->DenseRange(1, SMALL_COPY_MAX, 15);
+BENCHMARK(BM_CopyFixed<CopyMessage>)
+    ->Name("BM_CopyMessage")
+    ->DenseRange(1, 256, 15);
+BENCHMARK(BM_CopyRandom<Memcpy>)
+    ->Name("BM_MemcpyRandom")
+    ->RangeMultiplier(2)
+    ->Range(16, 256);
+BENCHMARK(BM_CopyRandom<CopySmall>)
+    ->Name("BM_CopySmallRandom")
+    ->RangeMultiplier(2)
+    ->Range(16, SMALL_COPY_MAX);
+BENCHMARK(BM_CopyRandom<CopyMessage>)
+    ->Name("BM_CopyMessageRandom")
+    ->RangeMultiplier(2)
+    ->Range(16, 256);
+
+BENCHMARK_MAIN();
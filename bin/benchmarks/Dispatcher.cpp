@@ -0,0 +1,84 @@
+#include "circularbuffer/Dispatcher.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <thread>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Spec.hpp"
+#include "circularbuffer/Writer.hpp"
+#include "spdlog/common.h"
+#include "spdlog/spdlog.h"
+
+using namespace CircularBuffer;
+
+namespace {
+
+constexpr int BATCH_SIZE = 1000;
+constexpr int MESSAGE_SIZE = 64;
+
+// Simulated per-message decode cost
+void Decode(std::span<const DataT> message, int iterations) {
+    uint64_t hash = 0;
+    for (int i = 0; i < iterations; i++) {
+        hash = hash * 31 + static_cast<uint64_t>(message[i % message.size()]);
+    }
+    benchmark::DoNotOptimize(hash);
+}
+
+}  // namespace
+
+// Writes batches of `BATCH_SIZE` messages over 64 keys and waits for
+// `state.range(0)` workers to handle them, each message costing
+// `state.range(1)` iterations of simulated decoding. Throughput should scale
+// with workers up to the number of free cores, until the dispatcher thread
+// becomes the bottleneck.
+void BM_Dispatch(benchmark::State& state) {
+    // Disable logging
+    spdlog::set_level(spdlog::level::off);
+
+    const int workers = state.range(0);
+    const int decodeIterations = state.range(1);
+
+    Spec spec{"/bench-index", "/bench-data", 16 * 1024 * 1024};
+    Writer writer(spec);
+    Dispatcher dispatcher(
+        spec,
+        [](std::span<const DataT> message) {
+            uint64_t key;
+            std::memcpy(&key, message.data(), sizeof(key));
+            return key;
+        },
+        [decodeIterations](std::span<const DataT> message, int) {
+            Decode(message, decodeIterations);
+        },
+        {.workers = workers});
+    dispatcher.Start();
+
+    DataT message[MESSAGE_SIZE]{};
+    uint64_t written = 0;
+
+    // Benchmark
+    for (auto _ : state) {
+        for (int i = 0; i < BATCH_SIZE; i++) {
+            const uint64_t key = written++ % 64;
+            std::memcpy(message, &key, sizeof(key));
+            writer.Write(message, MESSAGE_SIZE);
+        }
+        while (dispatcher.Handled() < written) {
+            std::this_thread::yield();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+
+    dispatcher.Stop();
+}
+
+BENCHMARK(BM_Dispatch)
+    ->ArgsProduct({{1, 2, 4}, {0, 1000}})
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
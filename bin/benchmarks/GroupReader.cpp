@@ -0,0 +1,94 @@
+#include "circularbuffer/GroupReader.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Spec.hpp"
+#include "circularbuffer/Writer.hpp"
+#include "spdlog/common.h"
+#include "spdlog/spdlog.h"
+
+using namespace CircularBuffer;
+
+namespace {
+
+constexpr int BATCH_SIZE = 1000;
+constexpr int MESSAGE_SIZE = 64;
+
+// Per-member count of messages read, on its own cacheline
+struct alignas(CACHELINE_SIZE) MemberCount {
+    std::atomic<uint64_t> messages{0};
+};
+
+}  // namespace
+
+// Writes batches of `BATCH_SIZE` messages and waits for a group of
+// `state.range(0)` members, claiming `state.range(1)` messages at a time, to
+// read them. Small claims balance load finely but contend on the group cursor;
+// with more members than free cores, members only time-share.
+void BM_GroupRead(benchmark::State& state) {
+    // Disable logging
+    spdlog::set_level(spdlog::level::off);
+
+    const int numMembers = state.range(0);
+    const uint64_t claimBatch = state.range(1);
+
+    Spec spec{"/bench-index", "/bench-data", 16 * 1024 * 1024};
+    spec.seekInterval = claimBatch;
+    Writer writer(spec);
+
+    std::atomic_bool running{true};
+    std::vector<MemberCount> counts(numMembers);
+    std::vector<std::thread> members;
+    for (int i = 0; i < numMembers; i++) {
+        members.emplace_back([&, i] {
+            GroupReader member(spec, 0, claimBatch);
+            DataT buffer[MESSAGE_SIZE];
+            uint64_t read = 0;
+            while (running.load(std::memory_order_relaxed)) {
+                if (member.Read(buffer, MESSAGE_SIZE) > 0) {
+                    counts[i].messages.store(++read,
+                                             std::memory_order_release);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    DataT message[MESSAGE_SIZE]{};
+    uint64_t written = 0;
+    const auto totalRead = [&] {
+        uint64_t total = 0;
+        for (const MemberCount& count : counts) {
+            total += count.messages.load(std::memory_order_acquire);
+        }
+        return total;
+    };
+
+    // Benchmark
+    for (auto _ : state) {
+        for (int i = 0; i < BATCH_SIZE; i++) {
+            writer.Write(message, MESSAGE_SIZE);
+        }
+        written += BATCH_SIZE;
+        while (totalRead() < written) {
+            std::this_thread::yield();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+
+    running.store(false, std::memory_order_relaxed);
+    for (std::thread& member : members) {
+        member.join();
+    }
+}
+
+BENCHMARK(BM_GroupRead)->ArgsProduct({{1, 2, 4}, {1, 16, 64}})->UseRealTime();
+
+BENCHMARK_MAIN();
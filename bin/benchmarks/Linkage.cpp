@@ -0,0 +1,65 @@
+// Built twice: as `LinkageBenchmarks`, against the shared library, and as
+// `StaticLinkageBenchmarks`, against the static library with link-time
+// optimization (in Release), where `Write()` and `Read()` can be inlined and
+// the message size is a constant at the call site.
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Reader.hpp"
+#include "circularbuffer/Spec.hpp"
+#include "circularbuffer/Writer.hpp"
+#include "spdlog/spdlog.h"
+
+using namespace CircularBuffer;
+
+static constexpr size_t BUFFER_SIZE = 1024 * 1024;
+
+static Spec MakeSpec() {
+    return Spec{"/bench-index", "/bench-data", BUFFER_SIZE};
+}
+
+// Writes of a message whose size is known at compile time
+template <size_t Size>
+void BM_CallWrite(benchmark::State& state) {
+    spdlog::set_level(spdlog::level::off);
+    std::array<DataT, Size> message{};
+    Writer writer(MakeSpec());
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(writer.Write(message));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Write-read round trips, same thread
+template <size_t Size>
+void BM_CallWriteRead(benchmark::State& state) {
+    spdlog::set_level(spdlog::level::off);
+    std::array<DataT, Size> message{};
+    std::array<DataT, Size> readBuffer{};
+    Writer writer(MakeSpec());
+    Reader reader(MakeSpec());
+
+    for (auto _ : state) {
+        writer.Write(message);
+        benchmark::DoNotOptimize(reader.Read(readBuffer));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_CallWrite<1>);
+BENCHMARK(BM_CallWrite<8>);
+BENCHMARK(BM_CallWrite<16>);
+BENCHMARK(BM_CallWrite<32>);
+BENCHMARK(BM_CallWrite<64>);
+BENCHMARK(BM_CallWriteRead<1>);
+BENCHMARK(BM_CallWriteRead<8>);
+BENCHMARK(BM_CallWriteRead<16>);
+BENCHMARK(BM_CallWriteRead<32>);
+BENCHMARK(BM_CallWriteRead<64>);
+
+BENCHMARK_MAIN();
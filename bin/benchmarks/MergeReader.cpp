@@ -0,0 +1,62 @@
+#include "circularbuffer/MergeReader.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Clock.hpp"
+#include "circularbuffer/Spec.hpp"
+#include "circularbuffer/Writer.hpp"
+#include "spdlog/common.h"
+#include "spdlog/spdlog.h"
+
+using namespace CircularBuffer;
+
+// Merges `state.range(0)` rings: each iteration writes 1000 64-byte messages
+// round-robin across the rings (untimed), then merges them. Reports the cost
+// per merged message as the number of inputs grows.
+void BM_Merge(benchmark::State& state) {
+    // Disable logging
+    spdlog::set_level(spdlog::level::off);
+
+    const int numInputs = state.range(0);
+    const int batchSize = 1000;
+    const int msgSize = 64;
+
+    std::vector<Spec> specs;
+    std::vector<Writer*> writers;
+    for (int i = 0; i < numInputs; i++) {
+        Spec spec{"/bench-index-" + std::to_string(i),
+                  "/bench-data-" + std::to_string(i), 1024 * 1024};
+        spec.timestamps = ClockSource::TSC;
+        specs.push_back(spec);
+        writers.push_back(new Writer(spec));
+    }
+    // Nothing is written while merging, so nothing needs holding back
+    MergeReader merge(specs, {.maxDelayNanos = 0});
+    DataT buffer[msgSize]{};
+
+    // Benchmark
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (int i = 0; i < batchSize; i++) {
+            writers[i % numInputs]->Write(buffer, msgSize);
+        }
+        state.ResumeTiming();
+
+        for (int i = 0; i < batchSize; i++) {
+            benchmark::DoNotOptimize(merge.Read(buffer, msgSize));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * batchSize);
+
+    for (Writer* writer : writers) {
+        delete writer;
+    }
+}
+
+BENCHMARK(BM_Merge)->RangeMultiplier(2)->Range(1, 32);
+
+BENCHMARK_MAIN();
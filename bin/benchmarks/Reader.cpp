@@ -0,0 +1,261 @@
+#include "circularbuffer/Reader.hpp"
+
+#include <benchmark/benchmark.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Clock.hpp"
+#include "circularbuffer/SharedMemory.hpp"
+#include "circularbuffer/Spec.hpp"
+#include "circularbuffer/State.hpp"
+#include "circularbuffer/Writer.hpp"
+#include "spdlog/common.h"
+#include "spdlog/spdlog.h"
+
+using namespace CircularBuffer;
+
+// Writes and reads back a message of `state.range(0)` bytes per iteration, with
+// records padded to `state.range(1)` bytes. Reports how many buffer bytes each
+// record occupies so the padding overhead can be weighed against the speedup
+// from aligned header loads and copies.
+void BM_WriteReadAligned(benchmark::State& state) {
+    // Disable logging
+    spdlog::set_level(spdlog::level::off);
+
+    const int msgSize = state.range(0);
+    const int alignment = state.range(1);
+
+    // Set up buffers
+    DataT* writeData = new DataT[msgSize];
+    std::fill_n(writeData, msgSize, DataT{'\1'});
+    BufferT writeBuffer(writeData, msgSize);
+    DataT* readData = new DataT[msgSize]{};
+    BufferT readBuffer(readData, msgSize);
+
+    // Set up writer and reader
+    Spec spec{"/bench-index", "/bench-data", 1024 * 1024};
+    spec.recordAlignment = alignment;
+    Writer writer(spec);
+    Reader reader(spec);
+
+    // Benchmark
+    for (auto _ : state) {
+        writer.Write(writeBuffer);
+        benchmark::DoNotOptimize(reader.Read(readBuffer));
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * msgSize);
+
+    // Space used in the buffer per record
+    const int payloadOffset = (HEADER_SIZE + alignment - 1) & -alignment;
+    const int recordBytes = (payloadOffset + msgSize + alignment - 1) &
+                            -alignment;
+    state.counters["recordBytes"] = recordBytes;
+    state.counters["padding%"] =
+        100.0 * (recordBytes - HEADER_SIZE - msgSize) / recordBytes;
+
+    // Free buffer data
+    delete[] writeData;
+    delete[] readData;
+}
+
+// Message sizes drawn from distribution `distribution`: 64 B fixed, uniform
+// over 16-1024 B, bimodal (mostly 32 B, 10% 4000 B) or uniform over 4-16 KiB
+static std::vector<int> MessageSizes(int distribution) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> uniform(16, 1024);
+    std::bernoulli_distribution large(0.1);
+    std::uniform_int_distribution<int> huge(4096, 16384);
+
+    std::vector<int> sizes(4096);
+    for (int& size : sizes) {
+        switch (distribution) {
+            case 0:
+                size = 64;
+                break;
+            case 1:
+                size = uniform(rng);
+                break;
+            case 2:
+                size = large(rng) ? 4000 : 32;
+                break;
+            default:
+                size = huge(rng);
+                break;
+        }
+    }
+    return sizes;
+}
+
+// Writes and reads back a message per iteration, with sizes from distribution
+// `state.range(0)` (see `MessageSizes()`), to a 64 KiB buffer. Records are
+// split across the end of the buffer (`state.range(1)` = 0), or kept
+// contiguous and read with a copy (1) or in place (2). Reports the share of
+// the buffer lost to skipped space at its end.
+void BM_WriteReadContiguous(benchmark::State& state) {
+    // Disable logging
+    spdlog::set_level(spdlog::level::off);
+
+    static constexpr size_t capacity = 64 * 1024;
+    const std::vector<int> sizes = MessageSizes(state.range(0));
+    const int mode = state.range(1);
+
+    Spec spec{"/bench-index", "/bench-data", capacity};
+    spec.enableStats = true;
+    spec.contiguousRecords = mode != 0;
+    Writer writer(spec);
+    Reader reader(spec);
+    const SharedMemory stateShMem(spec.indexSharedMemoryName, sizeof(State));
+    const State* bufferState = stateShMem.AsStruct<State>();
+
+    std::vector<DataT> writeBuffer(16384, DataT{'\1'});
+    std::vector<DataT> readBuffer(16384);
+    std::span<const DataT> view;
+    uint64_t recordBytes = 0;
+    size_t i = 0;
+    for (auto _ : state) {
+        const int msgSize = sizes[i++ % sizes.size()];
+        writer.Write({writeBuffer.data(), static_cast<size_t>(msgSize)});
+        if (mode == 2) {
+            benchmark::DoNotOptimize(reader.ReadView(view));
+            benchmark::DoNotOptimize(view.data());
+            benchmark::DoNotOptimize(reader.ViewIntact());
+        } else {
+            benchmark::DoNotOptimize(reader.Read(readBuffer));
+        }
+        recordBytes += HEADER_SIZE + msgSize;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(recordBytes - HEADER_SIZE * state.iterations());
+
+    // Space the records took up in the buffer, from its start
+    const uint64_t usedBytes =
+        bufferState->stats.wraps * capacity + bufferState->writeIdx;
+    state.counters["skipped%"] = 100.0 * (usedBytes - recordBytes) / usedBytes;
+}
+
+// Time from a write to an epoll-waiting reader waking up, through the eventfd
+// bridge. The writer thread stamps each message with the time of the write.
+void BM_EventFdWakeup(benchmark::State& state) {
+    // Disable logging
+    spdlog::set_level(spdlog::level::off);
+
+    Spec spec{"/bench-index", "/bench-data", 1024 * 1024};
+    spec.enableNotifications = true;
+    Writer writer(spec);
+    Reader reader(spec, {.eventFd = true});
+
+    const int epollFd = epoll_create1(0);
+    epoll_event event{.events = EPOLLIN, .data = {}};
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, reader.EventFd(), &event);
+
+    // Writer thread writes whenever the reader is armed
+    std::atomic_bool running{true};
+    std::atomic_bool armed{false};
+    std::thread writerThread([&] {
+        while (running.load(std::memory_order_acquire)) {
+            if (!armed.exchange(false, std::memory_order_acq_rel)) {
+                continue;
+            }
+            uint64_t now = MonotonicNanos();
+            writer.Write({reinterpret_cast<DataT*>(&now), sizeof(now)});
+        }
+    });
+
+    DataT readData[sizeof(uint64_t)];
+    for (auto _ : state) {
+        while (!reader.Arm()) {
+            reader.Read(readData);
+        }
+        armed.store(true, std::memory_order_release);
+
+        epoll_wait(epollFd, &event, 1, -1);
+        const uint64_t now = MonotonicNanos();
+        while (reader.Read(readData) > 0) {
+        }
+
+        uint64_t written;
+        std::memcpy(&written, readData, sizeof(written));
+        state.SetIterationTime(static_cast<double>(now - written) * 1e-9);
+    }
+
+    running.store(false, std::memory_order_release);
+    writerThread.join();
+    close(epollFd);
+}
+
+// Time for a reader `state.range(0)` bytes behind to read the newest message,
+// reading every message in between or, with `state.range(1)` set, skipping
+// straight to it by conflation
+void BM_CatchUp(benchmark::State& state) {
+    // Disable logging
+    spdlog::set_level(spdlog::level::off);
+
+    const size_t lag = state.range(0);
+    const bool conflate = state.range(1) != 0;
+
+    Spec spec{"/bench-index", "/bench-data", 1024 * 1024};
+    spec.enableConflation = conflate;
+    Writer writer(spec);
+    Reader reader(spec, {.conflateLag = conflate ? size_t{4096} : 0});
+
+    DataT data[64]{};
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (size_t written = 0; written < lag; written += HEADER_SIZE + 64) {
+            writer.Write(data);
+        }
+        state.ResumeTiming();
+
+        while (reader.Read(data) > 0) {
+        }
+    }
+    state.counters["conflations"] = reader.Conflations();
+}
+
+// Cost of checking writer liveness, with and without a heartbeat to check
+void BM_WriterAlive(benchmark::State& state) {
+    // Disable logging
+    spdlog::set_level(spdlog::level::off);
+
+    Spec spec{"/bench-index", "/bench-data", 1024 * 1024};
+    spec.heartbeatMs = state.range(0);
+    Writer writer(spec);
+    Reader reader(spec);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(reader.WriterAlive());
+    }
+}
+
+BENCHMARK(BM_EventFdWakeup)->UseManualTime();
+BENCHMARK(BM_WriterAlive)->Arg(0)->Arg(10);
+BENCHMARK(BM_CatchUp)
+    ->ArgsProduct({
+        {64 * 1024, 512 * 1024},  // Lag in bytes
+        {0, 1},                   // Conflation off/on
+    });
+
+BENCHMARK(BM_WriteReadAligned)
+    ->ArgsProduct({
+        {8, 12, 24, 60, 100, 250, 1000},  // Message size
+        {1, 8, 16, 64},                   // Record alignment
+    });
+
+BENCHMARK(BM_WriteReadContiguous)
+    ->ArgsProduct({
+        {0, 1, 2, 3},  // Message size distribution
+        {0, 1, 2},     // Split, contiguous, contiguous in place
+    });
+
+BENCHMARK_MAIN();
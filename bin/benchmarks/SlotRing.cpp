@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Reader.hpp"
+#include "circularbuffer/SlotReader.hpp"
+#include "circularbuffer/SlotRing.hpp"
+#include "circularbuffer/SlotWriter.hpp"
+#include "circularbuffer/Spec.hpp"
+#include "circularbuffer/Writer.hpp"
+#include "spdlog/common.h"
+#include "spdlog/spdlog.h"
+
+using namespace CircularBuffer;
+
+// Writes a message of `state.range(0)` bytes per iteration to a fixed-slot ring
+// of 256 B slots, read back by each of `state.range(1)` readers. Compare with
+// `BM_RingWriteRead`: readers check the stamp of the slot they read instead of
+// the shared read index, and the writer publishes no index.
+void BM_SlotWriteRead(benchmark::State& state) {
+    // Disable logging
+    spdlog::set_level(spdlog::level::off);
+
+    const int msgSize = state.range(0);
+    const int numReaders = state.range(1);
+
+    std::vector<DataT> writeBuffer(msgSize, DataT{'\1'});
+    std::vector<DataT> readBuffer(msgSize);
+
+    const SlotSpec spec{"/bench-slots", 256, 4096};
+    SlotWriter writer(spec);
+    std::vector<SlotReader*> readers;
+    for (int i = 0; i < numReaders; i++) {
+        readers.push_back(new SlotReader(spec));
+    }
+
+    for (auto _ : state) {
+        writer.Write(writeBuffer);
+        for (SlotReader* reader : readers) {
+            benchmark::DoNotOptimize(reader->Read(readBuffer));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * msgSize);
+
+    for (SlotReader* reader : readers) {
+        delete reader;
+    }
+}
+
+// Same as `BM_SlotWriteRead` with the variable-size ring
+void BM_RingWriteRead(benchmark::State& state) {
+    // Disable logging
+    spdlog::set_level(spdlog::level::off);
+
+    const int msgSize = state.range(0);
+    const int numReaders = state.range(1);
+
+    std::vector<DataT> writeBuffer(msgSize, DataT{'\1'});
+    std::vector<DataT> readBuffer(msgSize);
+
+    const Spec spec{"/bench-index", "/bench-data", 1024 * 1024};
+    Writer writer(spec);
+    std::vector<Reader*> readers;
+    for (int i = 0; i < numReaders; i++) {
+        readers.push_back(new Reader(spec));
+    }
+
+    for (auto _ : state) {
+        writer.Write(writeBuffer);
+        for (Reader* reader : readers) {
+            benchmark::DoNotOptimize(reader->Read(readBuffer));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * msgSize);
+
+    for (Reader* reader : readers) {
+        delete reader;
+    }
+}
+
+BENCHMARK(BM_SlotWriteRead)
+    ->ArgsProduct({
+        {8, 64, 200},  // Message size
+        {1, 4},        // Readers
+    });
+BENCHMARK(BM_RingWriteRead)
+    ->ArgsProduct({
+        {8, 64, 200},  // Message size
+        {1, 4},        // Readers
+    });
+
+BENCHMARK_MAIN();
@@ -2,17 +2,29 @@
 
 #include <benchmark/benchmark.h>
 
+#include <cstdint>
 #include <cstring>
+#include <vector>
 
 #include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Reader.hpp"
 #include "circularbuffer/SharedMemory.hpp"
+#include "circularbuffer/SizeField.hpp"
 #include "circularbuffer/Spec.hpp"
+#include "circularbuffer/Trace.hpp"
 #include "spdlog/common.h"
 #include "spdlog/spdlog.h"
 
 using namespace CircularBuffer;
 
-void BM_Write(benchmark::State& state) {
+// Size of the co-running workload's working set: fits in a typical L2
+static constexpr size_t WORKING_SET_BYTES = 256 * 1024;
+
+// Benchmarks writes of `state.range(0)` bytes to a buffer of `state.range(1)`
+// bytes. If `workingSet` is not empty, it is traversed after every write to
+// simulate a co-running workload competing with the writer for cache.
+static void RunWriteBenchmark(benchmark::State& state, Spec spec,
+                              std::vector<uint64_t> workingSet = {}) {
     // Disable logging
     spdlog::set_level(spdlog::level::off);
 
@@ -23,13 +35,20 @@ void BM_Write(benchmark::State& state) {
     BufferT writeBuffer(msgData, msgSize);
 
     // Set up writer
-    const size_t bufferSize = state.range(1);
-    Spec spec{"/bench-index", "/bench-data", bufferSize};
+    spec.bufferCapacity = state.range(1);
     Writer writer(spec);
 
     // Benchmark
     for (auto _ : state) {
         writer.Write(writeBuffer);
+
+        // Touch every cacheline of the working set
+        uint64_t sum = 0;
+        for (size_t i = 0; i < workingSet.size();
+             i += CACHELINE_SIZE / sizeof(uint64_t)) {
+            sum += workingSet[i];
+        }
+        benchmark::DoNotOptimize(sum);
     }
     state.SetItemsProcessed(state.iterations());
     state.SetBytesProcessed(state.iterations() * writeBuffer.size_bytes());
@@ -38,10 +57,220 @@ void BM_Write(benchmark::State& state) {
     delete[] msgData;
 }
 
+void BM_Write(benchmark::State& state) {
+    RunWriteBenchmark(state, Spec{"/bench-index", "/bench-data"});
+}
+
+// All messages written with non-temporal stores
+void BM_WriteStreaming(benchmark::State& state) {
+    Spec spec{"/bench-index", "/bench-data"};
+    spec.streamingStoreThreshold = 1;
+    RunWriteBenchmark(state, spec);
+}
+
+// Notifications enabled, but no reader waiting: costs a fence, no syscall
+void BM_WriteNotify(benchmark::State& state) {
+    Spec spec{"/bench-index", "/bench-data"};
+    spec.enableNotifications = true;
+    RunWriteBenchmark(state, spec);
+}
+
+// Writer publishing the newest record for conflating readers: a seqlock
+// update on a cacheline of its own per write
+void BM_WriteConflation(benchmark::State& state) {
+    Spec spec{"/bench-index", "/bench-data"};
+    spec.enableConflation = true;
+    RunWriteBenchmark(state, spec);
+}
+
+// Small writes with the message size encoded as `SizeField` `state.range(2)`.
+// Reports the bytes each record occupies in the buffer (`recordBytes`) and how
+// many records the buffer holds (`ringMessages`), i.e. its effective capacity.
+void BM_WriteTraced(benchmark::State& state) {
+    const bool traced = state.range(2) != 0;
+    if (traced) {
+        Tracer::Start("/bench-trace");
+    }
+    RunWriteBenchmark(state, Spec{"/bench-index", "/bench-data"});
+    Tracer::Stop();
+}
+
+void BM_WriteSizeField(benchmark::State& state) {
+    Spec spec{"/bench-index", "/bench-data"};
+    spec.sizeField = static_cast<SizeField>(state.range(2));
+    RunWriteBenchmark(state, spec);
+
+    const MessageSizeT msgSize = state.range(0);
+    const int recordBytes = SizeFieldBytes(spec.sizeField, msgSize) + msgSize;
+    state.counters["recordBytes"] = recordBytes;
+    state.counters["ringMessages"] =
+        static_cast<double>(state.range(1)) / recordBytes;
+}
+
+// Writer with a co-running workload. Third arg toggles non-temporal stores:
+// compare the per-iteration time (dominated by the workload's cache misses),
+// or run with `--benchmark_perf_counters=CACHE-MISSES` if libbenchmark was
+// built with libpfm.
+void BM_WriteWithWorkingSet(benchmark::State& state) {
+    Spec spec{"/bench-index", "/bench-data"};
+    spec.streamingStoreThreshold = state.range(2) != 0 ? 1 : 0;
+    RunWriteBenchmark(state, spec,
+                      std::vector<uint64_t>(WORKING_SET_BYTES / sizeof(uint64_t),
+                                            1));
+}
+
+// Writes of `state.range(0)` bytes to multi-GB buffers of `state.range(1)`
+// bytes, backed by huge pages or not (third arg). The buffer is written through
+// once first so that page faults aren't timed, leaving TLB misses as the
+// difference. Needs as much free memory and /dev/shm space as the buffer size.
+void BM_WriteLarge(benchmark::State& state) {
+    // Disable logging
+    spdlog::set_level(spdlog::level::off);
+
+    const size_t msgSize = state.range(0);
+    DataT* msgData = new DataT[msgSize]{};
+    const BufferT writeBuffer(msgData, msgSize);
+
+    Spec spec{"/bench-index", "/bench-data", size_t(state.range(1))};
+    spec.maxBufferCapacity = spec.bufferCapacity;
+    spec.hugePages = state.range(2) != 0;
+    Writer writer(spec);
+
+    // Fault in every page
+    for (size_t written = 0; written < spec.bufferCapacity;
+         written += msgSize) {
+        writer.Write(writeBuffer);
+    }
+
+    for (auto _ : state) {
+        writer.Write(writeBuffer);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * msgSize);
+
+    delete[] msgData;
+}
+
+// Cost of restarting a writer under a live reader: resetting the buffer or
+// resuming its stream (second arg), which walks up to `seekInterval - 1`
+// records (first arg)
+void BM_WriterRestart(benchmark::State& state) {
+    // Disable logging
+    spdlog::set_level(spdlog::level::off);
+
+    Spec spec{"/bench-index", "/bench-data", 1024 * 1024};
+    spec.seekInterval = state.range(0);
+    spec.resume = state.range(1) != 0;
+
+    // Leave the stream just short of the next seek index entry
+    DataT msgData[100]{};
+    Writer* writer = new Writer(spec);
+    for (int64_t i = 0; i < 10 * state.range(0) - 1; i++) {
+        writer->Write({msgData, sizeof(msgData)});
+    }
+
+    // Reader keeps the buffer alive between writers
+    Reader reader(spec);
+    for (auto _ : state) {
+        delete writer;
+        writer = new Writer(spec);
+    }
+    delete writer;
+}
+
+// Cost of growing a 1 MB buffer to the given capacity under a live reader,
+// which stalls the writer for the duration
+void BM_WriterGrow(benchmark::State& state) {
+    // Disable logging
+    spdlog::set_level(spdlog::level::off);
+
+    const Spec spec{"/bench-index", "/bench-data", 1024 * 1024};
+    DataT msgData[100]{};
+    for (auto _ : state) {
+        state.PauseTiming();
+        Writer* writer = new Writer(spec);
+        writer->Write({msgData, sizeof(msgData)});
+        Reader reader(spec);
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(writer->Grow(state.range(0)));
+
+        state.PauseTiming();
+        delete writer;
+        state.ResumeTiming();
+    }
+}
+
 BENCHMARK(BM_Write)->Ranges({
     {1, MAX_MESSAGE_SIZE},  // Message size range
     {HEADER_SIZE + MAX_MESSAGE_SIZE,
      SharedMemory::MAX_SIZE_BYTES},  // Buffer size range
 });
 
+// Small messages, where copy call overhead dominates
+BENCHMARK(BM_Write)
+    ->Name("BM_WriteSmall")
+    ->ArgsProduct({
+        benchmark::CreateDenseRange(1, 256, 15),  // Message size
+        {1024 * 1024},                            // Buffer size
+    });
+
+BENCHMARK(BM_WriteNotify)
+    ->ArgsProduct({
+        {8, 64, 512, 4096},  // Message size
+        {1024 * 1024},       // Buffer size
+    });
+
+BENCHMARK(BM_WriteConflation)
+    ->ArgsProduct({
+        {8, 64, 512, 4096},  // Message size
+        {1024 * 1024},       // Buffer size
+    });
+
+BENCHMARK(BM_WriteTraced)
+    ->ArgsProduct({
+        {8, 64, 512},   // Message size
+        {1024 * 1024},  // Buffer size
+        {0, 1},         // Tracing off/on
+    });
+
+BENCHMARK(BM_WriteSizeField)
+    ->ArgsProduct({
+        {8, 16, 24, 32, 64, 128},  // Message size
+        {1024 * 1024},             // Buffer size
+        {0, 1, 2},                 // Int32/Uint16/Varint size field
+    });
+
+BENCHMARK(BM_WriteStreaming)
+    ->Ranges({
+        {1, MAX_MESSAGE_SIZE},  // Message size range
+        {HEADER_SIZE + MAX_MESSAGE_SIZE,
+         SharedMemory::MAX_SIZE_BYTES},  // Buffer size range
+    });
+
+BENCHMARK(BM_WriteWithWorkingSet)
+    ->ArgsProduct({
+        benchmark::CreateRange(1024, MAX_MESSAGE_SIZE, 4),  // Message size
+        {SharedMemory::MAX_SIZE_BYTES},                     // Buffer size
+        {0, 1},  // Non-temporal stores off/on
+    });
+
+BENCHMARK(BM_WriteLarge)
+    ->ArgsProduct({
+        {64, 4096},  // Message size
+        {int64_t{64} << 20, int64_t{1} << 30, int64_t{8} << 30,
+         int64_t{32} << 30},  // Buffer size: 64 MiB to 32 GiB
+        {0, 1},               // Huge pages off/on
+    });
+
+BENCHMARK(BM_WriterRestart)
+    ->ArgsProduct({
+        {1, 64, 1024},  // Seek interval
+        {0, 1},         // Reset/resume
+    });
+
+BENCHMARK(BM_WriterGrow)
+    ->RangeMultiplier(4)
+    ->Range(2 * 1024 * 1024, SharedMemory::MAX_SIZE_BYTES / 2);  // New capacity
+
 BENCHMARK_MAIN();
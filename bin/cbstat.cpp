@@ -0,0 +1,304 @@
+// cbstat: attaches read-only to a buffer's state shared memory and prints
+// per-second rates and per-reader lag from the statistics block.
+//
+// Usage: cbstat <state shm name> [--interval <ms>] [--count <n>]
+//               [--prometheus <file>]
+
+#include <signal.h>
+
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+
+#include "circularbuffer/SharedMemory.hpp"
+#include "circularbuffer/State.hpp"
+#include "circularbuffer/Stats.hpp"
+#include "spdlog/spdlog.h"
+
+using namespace CircularBuffer;
+
+std::atomic_bool g_Running{true};
+void Stop(int) { g_Running.store(false, std::memory_order_release); }
+
+namespace {
+
+struct Options {
+    std::string stateName;
+    std::chrono::milliseconds interval{1000};
+    uint64_t count{0};  // 0 = run until signaled
+    std::string prometheusFile;
+};
+
+// Point-in-time copy of the shared statistics
+struct Sample {
+    std::chrono::steady_clock::time_point time;
+    SeqNumT writerSeqNum{0};
+    uint64_t capacity{0};
+    uint64_t messages{0};
+    uint64_t bytes{0};
+    uint64_t wraps{0};
+    uint64_t maxMessageSize{0};
+
+    struct Reader {
+        pid_t pid{0};
+        SeqNumT seqNum{0};
+        uint64_t messages{0};
+        uint64_t overwrites{0};
+    } readers[MAX_TRACKED_READERS];
+};
+
+void Usage(const char* exe) {
+    std::cerr << std::format(
+        "Usage: {} <state shm name> [--interval <ms>] [--count <n>] "
+        "[--prometheus <file>]\n",
+        exe);
+}
+
+// Parses a whole argument as an unsigned number, rejecting signs and trailing
+// characters
+bool ParseNumber(std::string_view arg, uint64_t& value) {
+    const char* end = arg.data() + arg.size();
+    const auto [ptr, ec] = std::from_chars(arg.data(), end, value);
+    if (ec != std::errc() || ptr != end) {
+        std::cerr << std::format("Invalid number: '{}'\n", arg);
+        return false;
+    }
+    return true;
+}
+
+bool ParseArgs(int argc, char* argv[], Options& opts) {
+    if (argc < 2) {
+        return false;
+    }
+
+    opts.stateName = argv[1];
+    for (int i = 2; i < argc; i++) {
+        const std::string_view arg = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+
+        if (arg == "--interval") {
+            uint64_t ms;
+            if (!ParseNumber(argv[++i], ms)) {
+                return false;
+            }
+            opts.interval = std::chrono::milliseconds(ms);
+        } else if (arg == "--count") {
+            if (!ParseNumber(argv[++i], opts.count)) {
+                return false;
+            }
+        } else if (arg == "--prometheus") {
+            opts.prometheusFile = argv[++i];
+        } else {
+            return false;
+        }
+    }
+
+    return opts.interval.count() > 0;
+}
+
+Sample TakeSample(const State& state) {
+    static constexpr auto relaxed = std::memory_order_relaxed;
+    const Stats& stats = state.stats;
+
+    Sample sample;
+    sample.time = std::chrono::steady_clock::now();
+    sample.writerSeqNum = state.seqNum.load(std::memory_order_acquire);
+    sample.capacity = stats.capacity.load(relaxed);
+    sample.messages = stats.messages.load(relaxed);
+    sample.bytes = stats.bytes.load(relaxed);
+    sample.wraps = stats.wraps.load(relaxed);
+    sample.maxMessageSize = stats.maxMessageSize.load(relaxed);
+
+    for (int i = 0; i < MAX_TRACKED_READERS; i++) {
+        const ReaderStats& slot = stats.readers[i];
+        sample.readers[i].pid = slot.pid.load(std::memory_order_acquire);
+        sample.readers[i].seqNum = slot.seqNum.load(relaxed);
+        sample.readers[i].messages = slot.messages.load(relaxed);
+        sample.readers[i].overwrites = slot.overwrites.load(relaxed);
+    }
+
+    return sample;
+}
+
+bool ProcessAlive(pid_t pid) { return kill(pid, 0) == 0 || errno == EPERM; }
+
+SeqNumT Lag(const Sample& sample, const Sample::Reader& reader) {
+    // Readers can briefly be ahead of our snapshot of the writer
+    return sample.writerSeqNum > reader.seqNum
+               ? sample.writerSeqNum - reader.seqNum
+               : 0;
+}
+
+void Print(const Options& opts, const Sample& prev, const Sample& cur) {
+    const double secs =
+        std::chrono::duration<double>(cur.time - prev.time).count();
+    const auto rate = [secs](uint64_t a, uint64_t b) {
+        return static_cast<double>(b - a) / secs;
+    };
+
+    std::cout << std::format(
+        "{} capacity={}B msgs={} ({:.0f}/s) bytes={} ({:.0f}B/s) wraps={} "
+        "({:.1f}/s) max_msg={}B\n",
+        opts.stateName, cur.capacity, cur.messages,
+        rate(prev.messages, cur.messages), cur.bytes,
+        rate(prev.bytes, cur.bytes), cur.wraps, rate(prev.wraps, cur.wraps),
+        cur.maxMessageSize);
+
+    for (int i = 0; i < MAX_TRACKED_READERS; i++) {
+        const Sample::Reader& reader = cur.readers[i];
+        if (reader.pid == 0) {
+            continue;
+        }
+
+        const SeqNumT lag = Lag(cur, reader);
+        const double lagPct =
+            cur.capacity > 0 ? 100.0 * lag / cur.capacity : 0.0;
+        const uint64_t prevMessages = prev.readers[i].pid == reader.pid
+                                          ? prev.readers[i].messages
+                                          : reader.messages;
+
+        std::cout << std::format(
+            "  reader[{}] pid={}{} lag={}B ({:.1f}%) msgs={} ({:.0f}/s) "
+            "overwrites={}\n",
+            i, reader.pid, ProcessAlive(reader.pid) ? "" : " (dead)", lag,
+            lagPct, reader.messages, rate(prevMessages, reader.messages),
+            reader.overwrites);
+    }
+}
+
+void WritePrometheus(const Options& opts, const Sample& cur) {
+    const std::string ring = std::format("ring=\"{}\"", opts.stateName);
+    std::string out;
+
+    const auto metric = [&out](std::string_view name, std::string_view type,
+                               std::string_view help) {
+        out += std::format("# HELP {} {}\n# TYPE {} {}\n", name, help, name,
+                           type);
+    };
+
+    metric("circularbuffer_capacity_bytes", "gauge", "Buffer capacity");
+    out += std::format("circularbuffer_capacity_bytes{{{}}} {}\n", ring,
+                       cur.capacity);
+    metric("circularbuffer_messages_total", "counter", "Messages written");
+    out += std::format("circularbuffer_messages_total{{{}}} {}\n", ring,
+                       cur.messages);
+    metric("circularbuffer_bytes_total", "counter", "Message bytes written");
+    out += std::format("circularbuffer_bytes_total{{{}}} {}\n", ring,
+                       cur.bytes);
+    metric("circularbuffer_wraps_total", "counter", "Writer wraparounds");
+    out += std::format("circularbuffer_wraps_total{{{}}} {}\n", ring,
+                       cur.wraps);
+    metric("circularbuffer_max_message_bytes", "gauge",
+           "Largest message written");
+    out += std::format("circularbuffer_max_message_bytes{{{}}} {}\n", ring,
+                       cur.maxMessageSize);
+
+    metric("circularbuffer_reader_lag_bytes", "gauge",
+           "Bytes the writer is ahead of the reader");
+    for (int i = 0; i < MAX_TRACKED_READERS; i++) {
+        if (cur.readers[i].pid != 0) {
+            out += std::format(
+                "circularbuffer_reader_lag_bytes{{{},slot=\"{}\",pid=\"{}\"}} "
+                "{}\n",
+                ring, i, cur.readers[i].pid, Lag(cur, cur.readers[i]));
+        }
+    }
+    metric("circularbuffer_reader_alive", "gauge",
+           "1 if the reader process is alive, 0 if it died holding its slot");
+    for (int i = 0; i < MAX_TRACKED_READERS; i++) {
+        if (cur.readers[i].pid != 0) {
+            out += std::format(
+                "circularbuffer_reader_alive{{{},slot=\"{}\",pid=\"{}\"}} "
+                "{}\n",
+                ring, i, cur.readers[i].pid,
+                ProcessAlive(cur.readers[i].pid) ? 1 : 0);
+        }
+    }
+    metric("circularbuffer_reader_messages_total", "counter",
+           "Messages read");
+    for (int i = 0; i < MAX_TRACKED_READERS; i++) {
+        if (cur.readers[i].pid != 0) {
+            out += std::format(
+                "circularbuffer_reader_messages_total{{{},slot=\"{}\",pid=\"{}"
+                "\"}} {}\n",
+                ring, i, cur.readers[i].pid, cur.readers[i].messages);
+        }
+    }
+    metric("circularbuffer_reader_overwrites_total", "counter",
+           "Times the reader was overwritten by the writer");
+    for (int i = 0; i < MAX_TRACKED_READERS; i++) {
+        if (cur.readers[i].pid != 0) {
+            out += std::format(
+                "circularbuffer_reader_overwrites_total{{{},slot=\"{}\",pid=\""
+                "{}\"}} {}\n",
+                ring, i, cur.readers[i].pid, cur.readers[i].overwrites);
+        }
+    }
+
+    // Write to a temporary file and rename so scrapers never see a partial
+    // file
+    const std::filesystem::path path(opts.prometheusFile);
+    std::filesystem::path tmp(path);
+    tmp += ".tmp";
+    {
+        std::ofstream fout(tmp, std::ios::trunc);
+        fout << out;
+    }
+    std::filesystem::rename(tmp, path);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Options opts;
+    if (!ParseArgs(argc, argv, opts)) {
+        Usage(argv[0]);
+        return 1;
+    }
+
+    std::signal(SIGINT, Stop);
+    std::signal(SIGTERM, Stop);
+    spdlog::set_level(spdlog::level::off);
+
+    try {
+        SharedMemory shmem(opts.stateName, sizeof(State), true);
+        const State* state = shmem.AsStruct<const State>();
+
+        if (state->stats.enabled.load(std::memory_order_acquire) == 0) {
+            std::cerr << std::format(
+                "Statistics are not enabled for {}: set "
+                "Spec::enableStats in the writer\n",
+                opts.stateName);
+            return 1;
+        }
+
+        Sample prev = TakeSample(*state);
+        for (uint64_t i = 0; g_Running && (opts.count == 0 || i < opts.count);
+             i++) {
+            std::this_thread::sleep_for(opts.interval);
+
+            const Sample cur = TakeSample(*state);
+            Print(opts, prev, cur);
+            if (!opts.prometheusFile.empty()) {
+                WritePrometheus(opts, cur);
+            }
+            prev = cur;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+}
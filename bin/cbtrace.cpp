@@ -0,0 +1,179 @@
+// cbtrace: attaches read-only to a process's trace ring and prints the events
+// it holds as a timeline, oldest first.
+//
+// Usage: cbtrace <trace shm name> [--last <n>] [--event <name>]
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <format>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "circularbuffer/SharedMemory.hpp"
+#include "circularbuffer/Trace.hpp"
+#include "spdlog/spdlog.h"
+
+using namespace CircularBuffer;
+
+namespace {
+
+struct Options {
+    std::string traceName;
+    uint64_t last{TRACE_RING_CAPACITY};
+    TraceEvent event{TraceEvent::None};  // None = all events
+};
+
+// Copy of a trace record
+struct Event {
+    uint64_t position{0};
+    uint64_t ticks{0};
+    uint64_t index{0};
+    uint32_t size{0};
+    TraceEvent event{TraceEvent::None};
+};
+
+void Usage(const char* exe) {
+    std::cerr << std::format(
+        "Usage: {} <trace shm name> [--last <n>] [--event <name>]\n", exe);
+}
+
+// Parses a whole argument as an unsigned number, rejecting signs and trailing
+// characters
+bool ParseNumber(std::string_view arg, uint64_t& value) {
+    const char* end = arg.data() + arg.size();
+    const auto [ptr, ec] = std::from_chars(arg.data(), end, value);
+    if (ec != std::errc() || ptr != end) {
+        std::cerr << std::format("Invalid number: '{}'\n", arg);
+        return false;
+    }
+    return true;
+}
+
+bool ParseEvent(std::string_view name, TraceEvent& event) {
+    for (auto e = static_cast<uint16_t>(TraceEvent::Publish);
+         e <= static_cast<uint16_t>(TraceEvent::Conflate); e++) {
+        if (TraceEventName(static_cast<TraceEvent>(e)) == name) {
+            event = static_cast<TraceEvent>(e);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ParseArgs(int argc, char* argv[], Options& opts) {
+    if (argc < 2) {
+        return false;
+    }
+
+    opts.traceName = argv[1];
+    for (int i = 2; i < argc; i++) {
+        const std::string_view arg = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+
+        if (arg == "--last") {
+            if (!ParseNumber(argv[++i], opts.last)) {
+                return false;
+            }
+        } else if (arg == "--event") {
+            if (!ParseEvent(argv[++i], opts.event)) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Copies record `position`. Returns false if it has been overwritten, or is
+// being written.
+bool LoadEvent(const TraceRing& ring, uint64_t position, Event& event) {
+    const TraceRecord& record =
+        ring.records[position % TRACE_RING_CAPACITY];
+    if (record.stamp.load(std::memory_order_acquire) != position + 1) {
+        return false;
+    }
+
+    event.position = position;
+    event.ticks = record.ticks.load(std::memory_order_relaxed);
+    event.index = record.index.load(std::memory_order_relaxed);
+    event.size = record.size.load(std::memory_order_relaxed);
+    event.event = record.event.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return record.stamp.load(std::memory_order_relaxed) == position + 1;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Options opts;
+    if (!ParseArgs(argc, argv, opts)) {
+        Usage(argv[0]);
+        return 1;
+    }
+
+    spdlog::set_level(spdlog::level::off);
+
+    try {
+        SharedMemory shmem(opts.traceName, sizeof(TraceRing), true);
+        const TraceRing* ring = shmem.AsStruct<const TraceRing>();
+
+        // Newest records, up to a ring's worth
+        const uint64_t head = ring->head.load(std::memory_order_acquire);
+        const uint64_t count = std::min<uint64_t>(
+            {head, opts.last, uint64_t{TRACE_RING_CAPACITY}});
+        const double nanosPerTick =
+            ring->nanosPerTick.load(std::memory_order_relaxed);
+        const uint64_t startTicks =
+            ring->startTicks.load(std::memory_order_relaxed);
+
+        std::cout << std::format(
+            "{} pid={} events={} showing={}\n{:>16} {:>12}  {:<10} {:>12} "
+            "{:>10}\n",
+            opts.traceName, ring->pid.load(std::memory_order_relaxed), head,
+            count, "time_us", "delta_us", "event", "index", "size");
+
+        // Times since tracing started, from the TSC, and since the previous
+        // event printed
+        double previousMicros = 0.0;
+        bool printed = false;
+        uint64_t skipped = 0;
+        Event event;
+        for (uint64_t position = head - count; position < head; position++) {
+            if (!LoadEvent(*ring, position, event)) {
+                skipped++;
+                continue;
+            }
+            if (opts.event != TraceEvent::None && event.event != opts.event) {
+                continue;
+            }
+
+            const double micros =
+                static_cast<double>(static_cast<int64_t>(event.ticks -
+                                                         startTicks)) *
+                nanosPerTick / 1000.0;
+            std::cout << std::format(
+                "{:>16.3f} {:>12.3f}  {:<10} {:>12} {:>10}\n", micros,
+                printed ? micros - previousMicros : 0.0,
+                TraceEventName(event.event), event.index, event.size);
+            previousMicros = micros;
+            printed = true;
+        }
+
+        // Overwritten by the traced process while we were reading
+        if (skipped != 0) {
+            std::cout << std::format("{} events overwritten while reading\n",
+                                     skipped);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+}
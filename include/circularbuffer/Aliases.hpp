@@ -14,9 +14,20 @@ using IndexT = uint64_t;
 using IterT = BufferT::iterator;
 using MessageSizeT = int32_t;
 using SeqNumT = uint64_t;
+using TimestampT = uint64_t;
+using MessageNumberT = uint64_t;
 
 static constexpr int CACHELINE_SIZE = CB_CACHELINE_SIZE_BYTES;
 static constexpr int MAX_MESSAGE_SIZE = CB_MAX_MESSAGE_SIZE_BYTES;
 static constexpr int HEADER_SIZE = sizeof(MessageSizeT);
+static constexpr int TIMESTAMP_SIZE = sizeof(TimestampT);
+static constexpr int MESSAGE_NUMBER_SIZE = sizeof(MessageNumberT);
+static constexpr MessageNumberT INVALID_MESSAGE_NUMBER = UINT64_MAX;
+// Message size of the record marking the end of a data region, written when
+// the writer moves to a bigger one (see `Writer::Grow()`)
+static constexpr MessageSizeT GROW_MARKER = -1;
+// Largest record header: message size followed by optional fields
+static constexpr int MAX_HEADER_SIZE =
+    HEADER_SIZE + TIMESTAMP_SIZE + MESSAGE_NUMBER_SIZE;
 
 }  // namespace CircularBuffer
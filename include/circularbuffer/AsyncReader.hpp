@@ -0,0 +1,160 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <vector>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Macros.hpp"
+#include "circularbuffer/Reader.hpp"
+#include "circularbuffer/Spec.hpp"
+
+namespace CircularBuffer {
+
+// Top-level coroutine run by a `Scheduler`. Starts suspended and is owned by
+// the scheduler once spawned.
+class Task {
+public:
+    struct promise_type {
+        Task get_return_object() noexcept {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        // Stay suspended when done so the scheduler can reap the frame
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept {
+            exception = std::current_exception();
+        }
+
+        std::exception_ptr exception;
+    };
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Task(Task &&other) noexcept : m_Handle(other.m_Handle) {
+        other.m_Handle = nullptr;
+    }
+    ~Task();
+
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+    Task &operator=(Task &&) = delete;
+
+private:
+    friend class Scheduler;
+
+    explicit Task(Handle handle) noexcept : m_Handle(handle) {}
+    // Gives up ownership of the coroutine frame
+    Handle Release() noexcept;
+
+    Handle m_Handle;
+};
+
+class AsyncReader;
+
+// Single-threaded scheduler for coroutines awaiting `AsyncReader`s. Each
+// `Poll()` checks the rings of suspended readers with one cacheline each and
+// resumes only the coroutines whose ring has new data, so one thread can
+// service many channels without a spin loop per channel.
+class Scheduler {
+public:
+    Scheduler() = default;
+    // Destroys coroutines that haven't finished
+    ~Scheduler();
+
+    // No copy/move
+    CB_EXPLICIT_DELETE_COPY_MOVE(Scheduler);
+
+    // Takes ownership of a task and schedules it to start on the next poll
+    void Spawn(Task task);
+    // Resumes every coroutine that is ready to run. Returns the number of
+    // coroutines resumed. Rethrows exceptions escaping a coroutine (after
+    // destroying it).
+    size_t Poll();
+    // Busy-polls until all tasks are done or `Stop()` is called
+    void Run();
+    // Makes `Run()` return after the current poll
+    void Stop() noexcept { m_Stopped = true; }
+
+    // Number of tasks that haven't finished
+    [[nodiscard]] size_t Size() const noexcept { return m_Tasks.size(); }
+
+    // Awaitable that moves the calling coroutine to the back of the run queue,
+    // so a coroutine whose ring always has data doesn't starve the others
+    struct YieldAwaiter {
+        Scheduler &scheduler;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(Task::Handle handle) {
+            scheduler.m_Ready.push_back(handle);
+        }
+        void await_resume() const noexcept {}
+    };
+    [[nodiscard]] YieldAwaiter Yield() noexcept { return {*this}; }
+
+private:
+    friend class AsyncReader;
+
+    // Coroutine suspended until a message is read from its reader into
+    // `buffer`, with the result of the read stored in `*result`
+    struct Waiter {
+        Reader *reader;
+        BufferT buffer;
+        int *result;
+        Task::Handle handle;
+    };
+
+    // Parks a coroutine until a message can be read from `reader`
+    void Wait(Reader &reader, BufferT buffer, int *result,
+              Task::Handle handle);
+    // Destroys a finished task and rethrows its exception, if any
+    void Reap(Task::Handle handle);
+
+    // Coroutines to resume on the next poll, and those being resumed
+    std::vector<Task::Handle> m_Ready;
+    std::vector<Task::Handle> m_Resuming;
+    // Coroutines waiting for data
+    std::vector<Waiter> m_Waiting;
+    // Frames of spawned tasks that haven't finished
+    std::vector<Task::Handle> m_Tasks;
+    bool m_Stopped{false};
+};
+
+// Reader with an awaitable read interface for coroutines run by a `Scheduler`
+class AsyncReader : public Reader {
+public:
+    AsyncReader(Scheduler &scheduler, const Spec &spec,
+                const ReaderOptions &options = {});
+    ~AsyncReader() override = default;
+
+    // No default/copy/move construction
+    CB_EXPLICIT_DELETE_CONSTRUCTORS(AsyncReader);
+
+    // Result of `co_await reader.Next(buffer)` is the result of `Read()`,
+    // except it is never 0: the coroutine is suspended until a read returns
+    // something. Doesn't suspend if there is data already.
+    struct NextAwaiter {
+        AsyncReader &reader;
+        BufferT buffer;
+        int result{0};
+
+        bool await_ready() {
+            result = reader.Read(buffer);
+            return result != 0;
+        }
+        void await_suspend(Task::Handle handle) {
+            reader.m_Scheduler.Wait(reader, buffer, &result, handle);
+        }
+        // Only resumed once the scheduler has read a message
+        int await_resume() const noexcept { return result; }
+    };
+    [[nodiscard]] NextAwaiter Next(BufferT buffer) noexcept {
+        return {*this, buffer};
+    }
+
+private:
+    Scheduler &m_Scheduler;
+};
+
+}  // namespace CircularBuffer
@@ -0,0 +1,421 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Copy.hpp"
+#include "circularbuffer/Macros.hpp"
+#include "circularbuffer/RingPolicies.hpp"
+#include "circularbuffer/SemaphoreLock.hpp"
+#include "circularbuffer/SharedMemory.hpp"
+#include "circularbuffer/Utils.hpp"
+#include "spdlog/spdlog.h"
+
+namespace CircularBuffer {
+
+// POD struct for policy-based ring specification (see `BasicRing`)
+struct BasicRingSpec {
+    // Name of shared memory region holding the ring
+    std::string sharedMemoryName;
+    // Ring size in bytes, a power of two. 0 for a `FixedCapacity` ring's own.
+    size_t capacity{0};
+};
+
+// POD struct at the start of the ring, followed by the data
+struct BasicRingHeader {
+    // Layout, set by the writer so readers can check it (0 until then)
+    alignas(CACHELINE_SIZE) std::atomic<uint64_t> capacity;
+    std::atomic<uint32_t> headerSize;
+    std::atomic<uint32_t> lossless;
+    // Positions are byte counts since the ring was created, wrapped into the
+    // ring with the capacity mask. End of the last record published.
+    alignas(CACHELINE_SIZE) std::atomic<uint64_t> head;
+    // End of the record being written, for `Overwrite` readers to detect
+    // being lapped while copying
+    std::atomic<uint64_t> reserved;
+    // For readers waiting for data
+    RingSignal data;
+    // Position of the reader, for a `Block` writer to wait on
+    alignas(CACHELINE_SIZE) std::atomic<uint64_t> consumed;
+    // For the writer waiting for space
+    RingSignal space;
+};
+
+template <typename Ring>
+class BasicWriter;
+template <typename Ring>
+class BasicReader;
+template <typename Ring>
+class SpecWriter;
+template <typename Ring>
+class SpecReader;
+
+// A family of single-writer rings in shared memory, put together from
+// policies (see `RingPolicies.hpp`):
+// - `HeaderPolicy`: record header encoding (`Size32Header`, `Size16Header`,
+//   `SpecHeader`)
+// - `CapacityPolicy`: ring size (`FixedCapacity<N>`, `DynamicCapacity`,
+//   `SpecCapacity`)
+// - `OverflowPolicy`: lossy or lossless (`Overwrite`, `Block`)
+// - `WaitPolicy`: how to wait for data or space (`SpinWait`, `FutexWait`,
+//   `EventWait`)
+// - `Instrumentation`: event hooks (`NoInstrumentation`,
+//   `CountingInstrumentation`, `SharedStats`)
+//
+// Branches on policies are resolved at compile time, so a ring pays only for
+// the features it uses.
+//
+// `SpecHeader` rings are read and written by `SpecReader`/`SpecWriter`, with
+// the layout, framing and runtime features of `Spec`. The library
+// instantiates them for `SpecRing` (`Writer`/`Reader`) and `LeanSpecRing`.
+//
+// Other rings are header-only, with a layout of their own. Records are a
+// header followed by the message, and are always contiguous: a record that
+// doesn't fit before the end of the ring is written at the start, and the
+// space left is marked as skipped.
+template <typename HeaderPolicy, typename CapacityPolicy,
+          typename OverflowPolicy, typename WaitPolicy,
+          typename Instrumentation_ = NoInstrumentation>
+struct BasicRing {
+    using Header = HeaderPolicy;
+    using Capacity = CapacityPolicy;
+    using Overflow = OverflowPolicy;
+    using Wait = WaitPolicy;
+    using Instrumentation = Instrumentation_;
+
+    static constexpr bool SPEC = std::is_same_v<Header, SpecHeader>;
+    using Writer = std::conditional_t<SPEC, SpecWriter<BasicRing>,
+                                      BasicWriter<BasicRing>>;
+    using Reader = std::conditional_t<SPEC, SpecReader<BasicRing>,
+                                      BasicReader<BasicRing>>;
+};
+
+// Lossy, spinning, uninstrumented: readers never hold up the writer, e.g. for
+// market data
+template <size_t Capacity = 1024 * 1024>
+using LossyRing = BasicRing<Size32Header, FixedCapacity<Capacity>, Overwrite,
+                            SpinWait, NoInstrumentation>;
+
+// Lossless, blocking, instrumented: nothing is dropped, e.g. for an audit
+// trail
+using LosslessRing = BasicRing<Size32Header, DynamicCapacity, Block,
+                               FutexWait, CountingInstrumentation>;
+
+// `Writer`/`Reader`: notifications and shared statistics available, and
+// enabled at runtime through `Spec`
+using SpecRing = BasicRing<SpecHeader, SpecCapacity, Overwrite, EventWait,
+                           SharedStats>;
+
+// `LeanWriter`/`LeanReader`: `Spec` framing without notifications or shared
+// statistics, whose branches compile away
+using LeanSpecRing = BasicRing<SpecHeader, SpecCapacity, Overwrite, SpinWait,
+                               NoInstrumentation>;
+
+// Base of `BasicWriter` and `BasicReader`: maps the ring
+template <typename Ring>
+class BasicRingRegion {
+public:
+    using Header = typename Ring::Header;
+    using Instrumentation = typename Ring::Instrumentation;
+
+    virtual ~BasicRingRegion() { delete m_Region; }
+
+    // No default/copy/move construction
+    CB_EXPLICIT_DELETE_CONSTRUCTORS(BasicRingRegion);
+
+    [[nodiscard]] size_t Capacity() const noexcept {
+        return m_Capacity.Capacity();
+    }
+    // Largest message that fits. A record is at most half the ring, so that
+    // it always fits once the reader catches up, even after skipping the end,
+    // and no message is bigger than `INT_MAX` so `Read()` can return its size.
+    [[nodiscard]] size_t MaxMessageSize() const noexcept {
+        return std::min<uint64_t>({Header::MAX_MESSAGE_SIZE, INT_MAX,
+                                   Capacity() / 2 - Header::SIZE});
+    }
+    [[nodiscard]] const Instrumentation &Instruments() const noexcept {
+        return m_Instrumentation;
+    }
+
+protected:
+    explicit BasicRingRegion(const BasicRingSpec &spec)
+        : m_Capacity(spec.capacity) {
+        SetupSpdlog();
+
+        static_assert(sizeof(BasicRingHeader) % CACHELINE_SIZE == 0);
+        m_Region = new SharedMemory(spec.sharedMemoryName,
+                                    sizeof(BasicRingHeader) + Capacity());
+        m_Header = reinterpret_cast<BasicRingHeader *>(
+            m_Region->AsSpan<DataT>().data());
+        m_Data = reinterpret_cast<DataT *>(m_Header) + sizeof(BasicRingHeader);
+    }
+
+    // Checks the layout published by the writer, if any, against ours
+    void CheckLayout() const {
+        const uint64_t capacity =
+            m_Header->capacity.load(std::memory_order_acquire);
+        const uint32_t headerSize =
+            m_Header->headerSize.load(std::memory_order_relaxed);
+        const bool lossless =
+            m_Header->lossless.load(std::memory_order_relaxed) != 0;
+        if (capacity == 0 ||
+            (capacity == Capacity() && headerSize == Header::SIZE &&
+             lossless == Ring::Overflow::LOSSLESS)) {
+            return;
+        }
+
+        CB_CONSTEXPR_SV fmt =
+            "({}:{}) Ring has capacity {}, {} B headers, lossless={}; expected "
+            "capacity {}, {} B headers, lossless={}";
+        SPDLOG_ERROR(fmt.substr(8), capacity, headerSize, lossless, Capacity(),
+                     Header::SIZE, Ring::Overflow::LOSSLESS);
+        throw std::invalid_argument(std::format(
+            fmt, __FILE__, __LINE__, capacity, headerSize, lossless,
+            Capacity(), Header::SIZE, Ring::Overflow::LOSSLESS));
+    }
+
+    SharedMemory *m_Region{nullptr};
+    BasicRingHeader *m_Header{nullptr};
+    DataT *m_Data{nullptr};
+    [[no_unique_address]] typename Ring::Capacity m_Capacity;
+    [[no_unique_address]] Instrumentation m_Instrumentation;
+};
+
+// Writer of a `BasicRing`. One writer per ring. A new writer continues where
+// the previous one stopped if the ring is still in shared memory.
+template <typename Ring>
+class BasicWriter : public BasicRingRegion<Ring> {
+    using Base = BasicRingRegion<Ring>;
+    using Header = typename Ring::Header;
+    using Wait = typename Ring::Wait;
+
+public:
+    explicit BasicWriter(const BasicRingSpec &spec)
+        : Base(spec), m_SemLock(spec.sharedMemoryName + "-writer") {
+        if (!m_SemLock.Acquire()) {
+            throw std::logic_error(std::format(
+                "({}:{}) Another writer has locked the semaphore \"{}\"",
+                __FILE__, __LINE__, m_SemLock.Name()));
+        }
+        this->CheckLayout();
+
+        BasicRingHeader &header = *this->m_Header;
+        m_Head = header.head.load(std::memory_order_acquire);
+        header.reserved.store(m_Head, std::memory_order_relaxed);
+        header.headerSize.store(Header::SIZE, std::memory_order_relaxed);
+        header.lossless.store(Ring::Overflow::LOSSLESS,
+                              std::memory_order_relaxed);
+        header.capacity.store(this->Capacity(), std::memory_order_release);
+    }
+    ~BasicWriter() override = default;
+
+    // No default/copy/move construction
+    CB_EXPLICIT_DELETE_CONSTRUCTORS(BasicWriter);
+
+    // Writes a message. Returns false if it's bigger than `MaxMessageSize()`.
+    // With `Block`, waits for the reader to free enough space first.
+    bool Write(BufferT writeBuffer) {
+        const size_t msgSize = writeBuffer.size_bytes();
+        if (msgSize > this->MaxMessageSize()) [[unlikely]] {
+            SPDLOG_ERROR("Can't write message of size {} B: max size is {} B",
+                         msgSize, this->MaxMessageSize());
+            return false;
+        }
+
+        // Records don't wrap: skip the end of the ring if it's too short
+        BasicRingHeader &header = *this->m_Header;
+        const size_t recordBytes = Header::SIZE + msgSize;
+        size_t index = this->m_Capacity.Index(m_Head);
+        const size_t spaceToEnd = this->Capacity() - index;
+        const size_t skipBytes = recordBytes > spaceToEnd ? spaceToEnd : 0;
+        const uint64_t end = m_Head + skipBytes + recordBytes;
+
+        if constexpr (Ring::Overflow::LOSSLESS) {
+            auto hasSpace = [&header, end, this] {
+                return end - header.consumed.load(std::memory_order_acquire) <=
+                       this->Capacity();
+            };
+            if (!hasSpace()) [[unlikely]] {
+                this->m_Instrumentation.OnWait();
+                Wait::WaitUntil(header.space, hasSpace);
+            }
+        } else {
+            // Seqlock write, for readers checking after copying that the
+            // writer hasn't reached them. The fence keeps this store ahead of
+            // the record.
+            header.reserved.store(end, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+
+        if (skipBytes != 0) {
+            // Too short for a header: readers skip it anyway
+            if (spaceToEnd >= Header::SIZE) {
+                Header::Encode(this->m_Data + index, Header::SKIP);
+            }
+            index = 0;
+        }
+        Header::Encode(this->m_Data + index, msgSize);
+        CopyMessage(this->m_Data + index + Header::SIZE, writeBuffer.data(),
+                    msgSize);
+
+        m_Head = end;
+        header.head.store(end, std::memory_order_release);
+        Wait::Notify(header.data);
+        this->m_Instrumentation.OnWrite(msgSize);
+        return true;
+    }
+    // Compatibility interface
+    bool Write(DataT *data, size_t size) { return Write({data, size}); }
+
+    // Position after the last record written
+    [[nodiscard]] uint64_t Head() const noexcept { return m_Head; }
+
+private:
+    SemaphoreLock m_SemLock;
+    uint64_t m_Head{0};
+};
+
+// Reader of a `BasicRing`. With `Overwrite`, any number of readers, starting
+// at the next message written. With `Block`, one reader at a time, starting
+// where the previous one stopped.
+template <typename Ring>
+class BasicReader : public BasicRingRegion<Ring> {
+    using Base = BasicRingRegion<Ring>;
+    using Header = typename Ring::Header;
+    using Wait = typename Ring::Wait;
+
+public:
+    explicit BasicReader(const BasicRingSpec &spec) : Base(spec) {
+        if constexpr (Ring::Overflow::LOSSLESS) {
+            m_SemLock.emplace(spec.sharedMemoryName + "-reader");
+            if (!m_SemLock->Acquire()) {
+                throw std::logic_error(std::format(
+                    "({}:{}) Another reader has locked the semaphore \"{}\"",
+                    __FILE__, __LINE__, m_SemLock->Name()));
+            }
+        }
+        this->CheckLayout();
+
+        m_Position =
+            Ring::Overflow::LOSSLESS
+                ? this->m_Header->consumed.load(std::memory_order_acquire)
+                : this->m_Header->head.load(std::memory_order_acquire);
+    }
+    ~BasicReader() override = default;
+
+    // No default/copy/move construction
+    CB_EXPLICIT_DELETE_CONSTRUCTORS(BasicReader);
+
+    // Reads the next message into `readBuffer`. Returns its size, 0 if there
+    // is nothing to read, -1 if `readBuffer` is too small, or with
+    // `Overwrite`, `INT_MIN` if the writer has lapped the reader: the reader
+    // then skips to the next message written.
+    int Read(BufferT readBuffer) {
+        BasicRingHeader &header = *this->m_Header;
+        const uint64_t head = header.head.load(std::memory_order_acquire);
+        if (m_Position == head) {
+            return 0;
+        }
+        if constexpr (!Ring::Overflow::LOSSLESS) {
+            if (head - m_Position > this->Capacity()) [[unlikely]] {
+                return Overwritten();
+            }
+        }
+
+        // Skip the end of the ring if the writer did
+        uint64_t position = m_Position;
+        size_t index = this->m_Capacity.Index(position);
+        const size_t spaceToEnd = this->Capacity() - index;
+        if (spaceToEnd < Header::SIZE ||
+            Header::Decode(this->m_Data + index) == Header::SKIP) {
+            position += spaceToEnd;
+            index = 0;
+        }
+
+        // A size read from a lapped record may be garbage
+        const uint64_t msgSize = Header::Decode(this->m_Data + index);
+        const bool sizeValid =
+            msgSize <= this->Capacity() - index - Header::SIZE &&
+            msgSize <= this->MaxMessageSize();
+        if (!sizeValid || msgSize > readBuffer.size_bytes()) [[unlikely]] {
+            if (Lapped()) {
+                return Overwritten();
+            }
+            if (!sizeValid) {
+                SPDLOG_CRITICAL("Message size error: {} is invalid", msgSize);
+                return -1;
+            }
+            SPDLOG_ERROR("Read buffer too small: {} B vs message size of {} B",
+                         readBuffer.size_bytes(), msgSize);
+            return -1;
+        }
+        CopyMessage(readBuffer.data(), this->m_Data + index + Header::SIZE,
+                    msgSize);
+        if (Lapped()) [[unlikely]] {
+            return Overwritten();
+        }
+
+        m_Position = position + Header::SIZE + msgSize;
+        if constexpr (Ring::Overflow::LOSSLESS) {
+            header.consumed.store(m_Position, std::memory_order_release);
+            Wait::Notify(header.space);
+        }
+        this->m_Instrumentation.OnRead(msgSize);
+        return static_cast<int>(msgSize);
+    }
+
+    // Same as `Read()`, but waits for a message if there is none
+    int ReadWait(BufferT readBuffer) {
+        int ret = Read(readBuffer);
+        while (ret == 0) {
+            this->m_Instrumentation.OnWait();
+            Wait::WaitUntil(this->m_Header->data, [this] {
+                return this->m_Header->head.load(std::memory_order_acquire) !=
+                       m_Position;
+            });
+            ret = Read(readBuffer);
+        }
+        return ret;
+    }
+
+    // Position of the next record to read
+    [[nodiscard]] uint64_t Position() const noexcept { return m_Position; }
+
+private:
+    // Whether the writer may have written over the record at `m_Position`
+    // since we started reading it. Pairs with the writer's seqlock write of
+    // `reserved`.
+    [[nodiscard]] bool Lapped() const noexcept {
+        if constexpr (Ring::Overflow::LOSSLESS) {
+            return false;
+        } else {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return this->m_Header->reserved.load(std::memory_order_relaxed) -
+                       m_Position >
+                   this->Capacity();
+        }
+    }
+
+    int Overwritten() noexcept {
+        SPDLOG_CRITICAL("Overwrite detected: reader at {} lapped by writer",
+                        m_Position);
+        this->m_Instrumentation.OnOverwrite();
+        m_Position = this->m_Header->head.load(std::memory_order_acquire);
+        return INT_MIN;
+    }
+
+    // Only held with `Block`
+    std::optional<SemaphoreLock> m_SemLock;
+    uint64_t m_Position{0};
+};
+
+}  // namespace CircularBuffer
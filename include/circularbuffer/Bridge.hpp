@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "circularbuffer/Aliases.hpp"
+
+namespace CircularBuffer {
+
+// Wire format of the TCP bridge (see `BridgePublisher`, `BridgeSubscriber`).
+// Both ends are assumed to share byte order. On connecting, the subscriber
+// sends a `BridgeHello`; the publisher then streams frames, each a
+// `BridgeFrameHeader` followed by `size` bytes of message.
+struct BridgeHello {
+    // Next message number the subscriber expects, `INVALID_MESSAGE_NUMBER`
+    // to start from the publisher's current position
+    MessageNumberT next;
+};
+
+struct BridgeFrameHeader {
+    uint32_t size;
+    uint32_t reserved;
+    // Number of the message in the publisher's ring
+    MessageNumberT messageNumber;
+};
+
+static constexpr int BRIDGE_FRAME_HEADER_SIZE = sizeof(BridgeFrameHeader);
+
+// POD struct for publisher options
+struct BridgePublisherOptions {
+    // Address to listen on
+    std::string address{"0.0.0.0"};
+    // Frames are batched into socket writes of about this many bytes. A batch
+    // is also sent whenever the ring has no more data.
+    size_t batchBytes{64 * 1024};
+};
+
+// POD struct for subscriber options
+struct BridgeSubscriberOptions {
+    // Delay between attempts to (re)connect to the publisher
+    int reconnectDelayMs{100};
+    // Size of the socket receive buffer
+    size_t receiveBytes{256 * 1024};
+};
+
+}  // namespace CircularBuffer
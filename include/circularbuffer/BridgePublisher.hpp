@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Bridge.hpp"
+#include "circularbuffer/Macros.hpp"
+#include "circularbuffer/Reader.hpp"
+#include "circularbuffer/Spec.hpp"
+
+namespace CircularBuffer {
+
+// Replicates a ring over TCP: drains it on a background thread and streams its
+// messages to one `BridgeSubscriber` at a time, batching frames into large
+// socket writes. Requires the writer to number messages
+// (`Spec::seekInterval`), so that a reconnecting subscriber can resume at the
+// message it expects next, as long as it is still in the ring and seek index.
+// A new connection replaces the current one.
+class BridgePublisher {
+public:
+    // Listens on `port` (0 for any free port, see `Port()`)
+    BridgePublisher(const Spec &spec, uint16_t port,
+                    const BridgePublisherOptions &options = {});
+    // Stops the publisher thread and closes the sockets
+    ~BridgePublisher();
+
+    // No default/copy/move construction
+    CB_EXPLICIT_DELETE_CONSTRUCTORS(BridgePublisher);
+
+    // Port listened on
+    [[nodiscard]] uint16_t Port() const noexcept { return m_Port; }
+
+    // Messages sent so far
+    [[nodiscard]] uint64_t Sent() const noexcept {
+        return m_Sent.load(std::memory_order_relaxed);
+    }
+    // Subscriber connections accepted so far
+    [[nodiscard]] uint64_t Connections() const noexcept {
+        return m_Connections.load(std::memory_order_relaxed);
+    }
+
+private:
+    void Run() noexcept;
+    // Accepts a pending connection if any, replacing the current one, and
+    // positions the reader where the subscriber wants to resume
+    void Accept() noexcept;
+    // Replaces the reader with a new one at the latest message. Returns false
+    // and leaves it null on failure.
+    bool Reopen() noexcept;
+    // Sends the pending batch. Drops the connection and the batch on failure.
+    void Flush() noexcept;
+    // Closes the current connection
+    void Disconnect() noexcept;
+
+    const Spec m_Spec;
+    // Null while it can't be reopened
+    Reader *m_Reader{nullptr};
+    const size_t m_BatchBytes;
+    // Pending frames
+    DataT *m_Batch{nullptr};
+    size_t m_BatchSize{0};
+    uint64_t m_BatchMessages{0};
+    // Number of the next message the reader will return, if known
+    MessageNumberT m_Next{INVALID_MESSAGE_NUMBER};
+
+    int m_ListenFd{-1};
+    int m_Fd{-1};
+    uint16_t m_Port{0};
+
+    std::thread m_Thread;
+    std::atomic_bool m_Running{true};
+    std::atomic<uint64_t> m_Sent{0};
+    std::atomic<uint64_t> m_Connections{0};
+};
+
+}  // namespace CircularBuffer
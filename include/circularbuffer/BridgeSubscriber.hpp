@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Bridge.hpp"
+#include "circularbuffer/Macros.hpp"
+#include "circularbuffer/Spec.hpp"
+#include "circularbuffer/Writer.hpp"
+
+namespace CircularBuffer {
+
+// Receiving end of the TCP bridge: connects to a `BridgePublisher` and writes
+// the messages it receives to a local ring, on a background thread. Detects
+// gaps in the publisher's message numbers, and on disconnection reconnects
+// and asks to resume at the next message expected.
+class BridgeSubscriber {
+public:
+    // Becomes the writer of the ring described by `spec`
+    BridgeSubscriber(const Spec &spec, std::string host, uint16_t port,
+                     const BridgeSubscriberOptions &options = {});
+    // Stops the subscriber thread and closes the socket
+    ~BridgeSubscriber();
+
+    // No default/copy/move construction
+    CB_EXPLICIT_DELETE_CONSTRUCTORS(BridgeSubscriber);
+
+    // Messages received and written so far
+    [[nodiscard]] uint64_t Received() const noexcept {
+        return m_Received.load(std::memory_order_relaxed);
+    }
+    // Messages received that the local ring rejected so far, e.g. because its
+    // size field or capacity limits messages to less than the publisher's
+    [[nodiscard]] uint64_t Dropped() const noexcept {
+        return m_Dropped.load(std::memory_order_relaxed);
+    }
+    // Messages missing from the publisher's stream so far
+    [[nodiscard]] uint64_t Missed() const noexcept {
+        return m_Missed.load(std::memory_order_relaxed);
+    }
+    // Successful connections so far
+    [[nodiscard]] uint64_t Connections() const noexcept {
+        return m_Connections.load(std::memory_order_relaxed);
+    }
+
+private:
+    void Run() noexcept;
+    // Connects and sends the hello. Returns false on failure.
+    bool Connect() noexcept;
+    // Receives frames and writes them to the ring until disconnected
+    void Receive() noexcept;
+    // Writes a received message, tracking gaps and rejected messages
+    void Deliver(const BridgeFrameHeader &header, DataT *data) noexcept;
+
+    Writer m_Writer;
+    const std::string m_Host;
+    const uint16_t m_Port;
+    const BridgeSubscriberOptions m_Options;
+    DataT *m_Buffer{nullptr};
+    size_t m_BufferSize;
+    // Next message number expected from the publisher, if known
+    MessageNumberT m_Next{INVALID_MESSAGE_NUMBER};
+    int m_Fd{-1};
+
+    std::thread m_Thread;
+    std::atomic_bool m_Running{true};
+    std::atomic<uint64_t> m_Received{0};
+    std::atomic<uint64_t> m_Missed{0};
+    std::atomic<uint64_t> m_Dropped{0};
+    std::atomic<uint64_t> m_Connections{0};
+};
+
+}  // namespace CircularBuffer
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <time.h>
+
+#include <cstdint>
+
+#include "circularbuffer/Aliases.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace CircularBuffer {
+
+// Source of per-message timestamps
+enum class ClockSource : uint32_t {
+    // No timestamps
+    None = 0,
+    // `clock_gettime(CLOCK_MONOTONIC)` in nanoseconds
+    Monotonic,
+    // CPU timestamp counter in ticks, converted to nanoseconds using the
+    // calibration published by the writer. Requires an invariant TSC. Falls
+    // back to `Monotonic` on non-x86 platforms.
+    TSC,
+};
+
+inline uint64_t MonotonicNanos() noexcept {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+}
+
+// Reads the current time from `source` in its native unit
+inline TimestampT ReadClock(ClockSource source) noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    if (source == ClockSource::TSC) {
+        return __rdtsc();
+    }
+#endif
+    return source == ClockSource::None ? 0 : MonotonicNanos();
+}
+
+// Measures TSC frequency against `CLOCK_MONOTONIC` and returns nanoseconds per
+// tick. Spins for a few milliseconds, so it should be called once and shared.
+// Returns 1.0 on platforms without a TSC.
+double CalibrateTsc() noexcept;
+
+}  // namespace CircularBuffer
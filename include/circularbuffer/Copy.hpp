@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace CircularBuffer {
+
+// Largest copy handled by `CopySmall()`
+static constexpr size_t SMALL_COPY_MAX = 128;
+
+namespace Detail {
+
+// Fixed-size chunk: constant-size `std::memcpy` of a chunk compiles to a
+// single (unaligned) vector load or store
+template <size_t N>
+struct Chunk {
+    unsigned char bytes[N];
+};
+
+template <size_t N>
+inline Chunk<N> Load(const char *src) noexcept {
+    Chunk<N> chunk;
+    std::memcpy(&chunk, src, N);
+    return chunk;
+}
+
+template <size_t N>
+inline void Store(char *dst, const Chunk<N> &chunk) noexcept {
+    std::memcpy(dst, &chunk, N);
+}
+
+// Copies `size` bytes in [N, 2N] with two possibly overlapping N-byte chunks
+template <size_t N>
+inline void CopyOverlapping(char *dst, const char *src, size_t size) noexcept {
+    const Chunk<N> head = Load<N>(src);
+    const Chunk<N> tail = Load<N>(src + size - N);
+    Store<N>(dst, head);
+    Store<N>(dst + size - N, tail);
+}
+
+}  // namespace Detail
+
+// Inline copy for up to `SMALL_COPY_MAX` bytes, dispatched on size class to
+// avoid the call overhead of `std::memcpy` for small messages. Each size class
+// [N, 2N] is copied with two possibly overlapping N-byte chunks, i.e. a fixed
+// number of vector loads and stores. Source and destination must not overlap.
+inline void CopySmall(void *dst, const void *src, size_t size) noexcept {
+    using namespace Detail;
+
+    auto *d = static_cast<char *>(dst);
+    const auto *s = static_cast<const char *>(src);
+
+    if (size >= 64) {
+        CopyOverlapping<64>(d, s, size);
+    } else if (size >= 32) {
+        CopyOverlapping<32>(d, s, size);
+    } else if (size >= 16) {
+        CopyOverlapping<16>(d, s, size);
+    } else if (size >= 8) {
+        CopyOverlapping<8>(d, s, size);
+    } else if (size >= 4) {
+        CopyOverlapping<4>(d, s, size);
+    } else if (size > 0) {
+        // 1-3 bytes: first, middle, and last byte cover every case
+        const char first = s[0];
+        const char middle = s[size / 2];
+        const char last = s[size - 1];
+        d[0] = first;
+        d[size / 2] = middle;
+        d[size - 1] = last;
+    }
+}
+
+// Copies message data: inline kernels for small messages, `std::memcpy`
+// otherwise
+inline void CopyMessage(void *dst, const void *src, size_t size) noexcept {
+    if (size <= SMALL_COPY_MAX) [[likely]] {
+        CopySmall(dst, src, size);
+    } else {
+        std::memcpy(dst, src, size);
+    }
+}
+
+// Copies `size` bytes from `src` to `dst` using non-temporal (streaming)
+// stores, which bypass the cache so large copies don't evict the caller's
+// working set. Dispatches at runtime to AVX-512, AVX2, or SSE2 implementations
+// depending on CPU support, and falls back to `std::memcpy` on non-x86
+// platforms. Stores are weakly ordered: call `StoreFence()` before publishing
+// the data to other threads.
+void StreamingCopy(void *dst, const void *src, size_t size) noexcept;
+
+// Orders preceding non-temporal stores before any subsequent stores
+inline void StoreFence() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_sfence();
+#endif
+}
+
+}  // namespace CircularBuffer
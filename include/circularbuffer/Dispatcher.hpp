@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Macros.hpp"
+#include "circularbuffer/Reader.hpp"
+#include "circularbuffer/Spec.hpp"
+#include "circularbuffer/SpscQueue.hpp"
+
+namespace CircularBuffer {
+
+// POD struct for dispatcher options
+struct DispatcherOptions {
+    // Number of worker threads
+    int workers{1};
+    // Capacity of each worker's queue in bytes (see `SpscQueue`)
+    size_t queueCapacity{1024 * 1024};
+};
+
+// Reads a ring on one thread and fans messages out to a pool of workers, each
+// fed by its own SPSC queue. Messages are assigned to workers by key, so
+// messages with the same key are handled in order, by the same worker.
+class Dispatcher {
+public:
+    // Returns the partitioning key of a message, e.g. an instrument id. Called
+    // on the dispatcher thread, and must not throw.
+    using KeyExtractor = std::function<uint64_t(std::span<const DataT>)>;
+    // Handles a message on worker `worker`. Called concurrently for messages
+    // with different keys, and must not throw.
+    using Handler = std::function<void(std::span<const DataT>, int worker)>;
+
+    Dispatcher(const Spec &spec, KeyExtractor keyExtractor, Handler handler,
+               const DispatcherOptions &options = {},
+               const ReaderOptions &readerOptions = {});
+    // Stops if running
+    ~Dispatcher();
+
+    // No default/copy/move construction
+    CB_EXPLICIT_DELETE_CONSTRUCTORS(Dispatcher);
+
+    // Starts the dispatcher and worker threads
+    void Start();
+    // Stops dispatching, then waits for workers to handle every message already
+    // dispatched
+    void Stop();
+
+    // Messages dispatched to workers so far
+    [[nodiscard]] uint64_t Dispatched() const noexcept {
+        return m_Dispatched.load(std::memory_order_acquire);
+    }
+    // Messages handled by workers so far
+    [[nodiscard]] uint64_t Handled() const noexcept;
+    // True if the reader was overwritten. Read errors stop dispatching.
+    [[nodiscard]] bool Overwritten() const noexcept {
+        return m_Overwritten.load(std::memory_order_acquire);
+    }
+
+private:
+    // Per-worker state, on its own cachelines
+    struct Worker {
+        explicit Worker(size_t queueCapacity) : queue(queueCapacity) {}
+
+        SpscQueue queue;
+        alignas(CACHELINE_SIZE) std::atomic<uint64_t> handled{0};
+        std::thread thread;
+    };
+
+    // Dispatcher thread: reads the ring and pushes to worker queues
+    void Dispatch() noexcept;
+    // Worker thread: pops its queue and calls the handler
+    void Work(int index) noexcept;
+
+    Reader m_Reader;
+    const KeyExtractor m_KeyExtractor;
+    const Handler m_Handler;
+    std::vector<std::unique_ptr<Worker>> m_Workers;
+
+    std::thread m_Thread;
+    std::atomic_bool m_Dispatching{false};
+    std::atomic_bool m_Working{false};
+    std::atomic_bool m_Overwritten{false};
+    std::atomic<uint64_t> m_Dispatched{0};
+};
+
+}  // namespace CircularBuffer
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Macros.hpp"
+#include "circularbuffer/State.hpp"
+
+namespace CircularBuffer {
+
+// Bridges writer notifications to an eventfd, so a reader can be waited on
+// with epoll/poll/select. When armed, a background thread waits on the shared
+// futex word in `Notification` and makes the eventfd readable once the writer
+// bumps it. The writer only issues the futex wake syscall while some reader
+// is armed.
+class EventBridge {
+public:
+    explicit EventBridge(Notification &notification);
+    ~EventBridge();
+
+    // No default/copy/move construction
+    CB_EXPLICIT_DELETE_CONSTRUCTORS(EventBridge);
+
+    // Non-blocking eventfd, readable when the writer has notified since the
+    // last `Arm()`. Wake-ups may be spurious.
+    [[nodiscard]] int Fd() const noexcept { return m_Fd; }
+
+    // Clears the eventfd and requests a notification for the next write.
+    // Returns false without arming if the writer has already advanced the
+    // read index past `localIndex`, or grown the buffer out of data region
+    // `generation`, i.e. there's data to read.
+    bool Arm(const State &state, IndexT localIndex,
+             uint64_t generation) noexcept;
+
+    // Writer side: wakes armed readers after a write has been published
+    static void Signal(Notification &notification) noexcept;
+
+private:
+    void Run() noexcept;
+
+    Notification &m_Notification;
+    int m_Fd{-1};
+    // Sequence number the armed thread waits on in the low 32 bits, plus
+    // `ARMED`/`STOPPED` flags
+    std::atomic<uint64_t> m_Arming{0};
+    std::thread m_Thread;
+};
+
+}  // namespace CircularBuffer
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Macros.hpp"
+#include "circularbuffer/Reader.hpp"
+#include "circularbuffer/Spec.hpp"
+#include "circularbuffer/State.hpp"
+
+namespace CircularBuffer {
+
+// Member of a consumer group: each message is read by exactly one member of the
+// group, rather than by every reader. Members, in any number of processes,
+// claim batches of consecutive message numbers with a fetch-add on the group's
+// cursor in shared memory, then read their batch in place using the seek index.
+// Requires the writer to number messages (`Spec::seekInterval`), ideally with
+// an interval dividing the claim batch so batches start at indexed messages.
+//
+// Delivery is at most once: messages claimed by a member that goes away are
+// not read by anyone.
+class GroupReader : private Reader {
+public:
+    // Joins consumer group `group` (0 to `MAX_CONSUMER_GROUPS - 1`), claiming
+    // `claimBatch` messages at a time
+    GroupReader(const Spec &spec, int group, uint64_t claimBatch = 16,
+                const ReaderOptions &options = {});
+    ~GroupReader() override = default;
+
+    // No default/copy/move construction
+    CB_EXPLICIT_DELETE_CONSTRUCTORS(GroupReader);
+
+    // Reads the next message claimed by this member, claiming a new batch when
+    // the current one is done. Returns as `Reader::Read()`, except that after
+    // returning `INT_MIN` (claimed messages were overwritten before they could
+    // be read) the group skips ahead to messages still in the buffer, and
+    // reading can continue.
+    int Read(BufferT readBuffer);
+    // Compatibility interface
+    int Read(DataT *data, size_t size) { return Read({data, size}); }
+
+    using Reader::LastMessageNumber;
+    using Reader::LastTimestamp;
+    using Reader::Latency;
+
+private:
+    // Abandons the current claim and moves the group cursor past messages
+    // that have been overwritten
+    void SkipLost() noexcept;
+
+    ConsumerGroup &m_Group;
+    const uint64_t m_ClaimBatch;
+    // Next message to read and end of the current claim
+    MessageNumberT m_Next{0};
+    MessageNumberT m_ClaimEnd{0};
+    // True once positioned at `m_Next`
+    bool m_Positioned{false};
+};
+
+}  // namespace CircularBuffer
@@ -1,8 +1,14 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
 #include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Clock.hpp"
 #include "circularbuffer/Macros.hpp"
 #include "circularbuffer/SharedMemory.hpp"
+#include "circularbuffer/SizeField.hpp"
 #include "circularbuffer/Spec.hpp"
 #include "circularbuffer/State.hpp"
 
@@ -18,19 +24,101 @@ protected:
     explicit IWrapper(const Spec &spec);
     virtual ~IWrapper();
 
+    // Sets record framing from the size field encoding, the timestamp clock,
+    // whether messages are numbered, record alignment and whether records are
+    // kept contiguous
+    void SetFraming(SizeField sizeField, ClockSource clock, bool messageNumbers,
+                    int recordAlignment, bool contiguousRecords) noexcept;
+    // Offset of a message of the given size from the start of its record.
+    // Only varint size fields make it depend on the size.
+    [[nodiscard]] int PayloadOffset(MessageSizeT msgSize) const noexcept {
+        if (m_SizeField != SizeField::Varint) [[likely]] {
+            return m_PayloadOffset;
+        }
+        return (m_HeaderSize - m_SizeFieldBytes +
+                SizeFieldBytes(m_SizeField, msgSize) + m_RecordAlignment - 1) &
+               -m_RecordAlignment;
+    }
+    // Bytes a message of the given size occupies in the buffer, including
+    // header and padding
+    [[nodiscard]] int RecordSize(MessageSizeT msgSize) const noexcept {
+        return (PayloadOffset(msgSize) + msgSize + m_RecordAlignment - 1) &
+               -m_RecordAlignment;
+    }
+    // Decodes the size field of the record at `index`, setting `fieldBytes`
+    // to its length. The timestamp, then the message number follow it.
+    [[nodiscard]] MessageSizeT LoadSize(IndexT index,
+                                        int &fieldBytes) const noexcept {
+        return DecodeSize(m_SizeField, &m_CircularBuffer[index], fieldBytes);
+    }
+    // True if the record at `index`, of a message of `msgSize` bytes, doesn't
+    // fit before the end of the buffer with contiguous records. It is then a
+    // copy of the header of the record the writer wrote at the start of the
+    // buffer instead, and the space from `index` on is skipped.
+    [[nodiscard]] bool IsSkipRecord(IndexT index,
+                                    MessageSizeT msgSize) const noexcept {
+        return m_ContiguousRecords && msgSize >= 0 &&
+               static_cast<IndexT>(RecordSize(msgSize)) >
+                   m_CircularBuffer.size_bytes() - index;
+    }
+    // Offset of the message number from the start of a record whose size
+    // field is `fieldBytes` long
+    [[nodiscard]] int MessageNumberOffset(int fieldBytes) const noexcept {
+        return m_HeaderSize - m_SizeFieldBytes + fieldBytes -
+               MESSAGE_NUMBER_SIZE;
+    }
+
+    // Loads a consistent snapshot of the data region the writer is using
+    void LoadDataRegion(uint64_t &generation, size_t &capacity,
+                        SeqNumT &baseSeqNum,
+                        MessageNumberT &baseMessageNumber) const noexcept;
+    // Maps data region `generation` of `capacity` bytes in place of the
+    // current one, holding a reference to it. If `existing` is set, the region
+    // must still be holding the writer's data: one that had been freed is
+    // dropped again and an exception thrown, rather than read as empty.
+    // Returns the previous region, still mapped, for the caller to delete.
+    SharedMemory *ReplaceDataRegion(uint64_t generation, size_t capacity,
+                                    bool existing);
+    // True if no other process holds the data region, i.e. it has just been
+    // created and holds no records
+    [[nodiscard]] bool DataRegionCreated() const;
+
     // Buffer state
     State *m_State{nullptr};
-    // Buffer data
+    // Buffer data, and the generation of the region it is in
     BufferT m_CircularBuffer;
+    uint64_t m_DataGeneration{0};
+    // Largest capacity a data region may have
+    const size_t m_CapacityLimit;
     // Local cache of index to avoid atomic ops on shared buffer indices as much
     // as possible.
     IndexT m_LocalIndex;
     // Local sequence number to track bytes written/read
     SeqNumT m_LocalSeqNum{0};
+    // Record framing: encoding of the message size and the most bytes it
+    // takes up, size of the header preceding each message, the clock used
+    // for the timestamp following the message size (if any), whether the
+    // header ends with a message number, offset of the message from the
+    // start of the record, the record alignment and whether records are kept
+    // contiguous (see `Spec::contiguousRecords`). Header size and offset
+    // are the largest for varint size fields, which is what decides whether
+    // a header fits before the end of the buffer.
+    SizeField m_SizeField{SizeField::Int32};
+    int m_SizeFieldBytes{HEADER_SIZE};
+    int m_HeaderSize{HEADER_SIZE};
+    ClockSource m_Clock{ClockSource::None};
+    bool m_MessageNumbers{false};
+    int m_PayloadOffset{HEADER_SIZE};
+    int m_RecordAlignment{1};
+    bool m_ContiguousRecords{false};
 
 private:
     SharedMemory *m_StateRegion{nullptr};
     SharedMemory *m_DataRegion{nullptr};
+    // Name of data region 0
+    std::string m_DataName;
+    // Data regions are backed by huge pages
+    const bool m_HugePages;
 };
 
 }  // namespace CircularBuffer
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace CircularBuffer {
+
+// Point-in-time copy of a `LatencyHistogram`
+struct LatencySnapshot {
+    static constexpr int SUB_BUCKET_BITS = 4;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int NUM_BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    std::array<uint64_t, NUM_BUCKETS> buckets{};
+    uint64_t count{0};
+    uint64_t sum{0};
+    uint64_t min{0};
+    uint64_t max{0};
+
+    // Bucket index for a value: values below `SUB_BUCKETS` get their own
+    // bucket, and every power of two above that is split into `SUB_BUCKETS`
+    // linear buckets (~6% relative precision)
+    static constexpr size_t BucketIndex(uint64_t value) noexcept {
+        if (value < SUB_BUCKETS) {
+            return value;
+        }
+        const int shift = std::bit_width(value) - 1 - SUB_BUCKET_BITS;
+        return (static_cast<size_t>(shift + 1) << SUB_BUCKET_BITS) +
+               ((value >> shift) & (SUB_BUCKETS - 1));
+    }
+
+    // Smallest value that falls in bucket `index`
+    static constexpr uint64_t BucketLowerBound(size_t index) noexcept {
+        if (index < SUB_BUCKETS) {
+            return index;
+        }
+        const int shift = static_cast<int>(index >> SUB_BUCKET_BITS) - 1;
+        return (SUB_BUCKETS | (index & (SUB_BUCKETS - 1))) << shift;
+    }
+
+    // Value at percentile `p` in [0, 100], reported as the upper bound of the
+    // bucket it falls in (clamped to `max`)
+    [[nodiscard]] uint64_t Percentile(double p) const noexcept;
+    [[nodiscard]] double Mean() const noexcept;
+};
+
+// Log-linear histogram of latencies in nanoseconds. Single producer: `Record`
+// must only be called from one thread, but `Snapshot` may be called from any
+// thread.
+class LatencyHistogram {
+public:
+    void Record(uint64_t nanos) noexcept {
+        static constexpr auto relaxed = std::memory_order_relaxed;
+
+        std::atomic<uint64_t> &bucket =
+            m_Buckets[LatencySnapshot::BucketIndex(nanos)];
+        bucket.store(bucket.load(relaxed) + 1, relaxed);
+
+        const uint64_t count = m_Count.load(relaxed);
+        if (count == 0 || nanos < m_Min.load(relaxed)) {
+            m_Min.store(nanos, relaxed);
+        }
+        if (nanos > m_Max.load(relaxed)) {
+            m_Max.store(nanos, relaxed);
+        }
+        m_Sum.store(m_Sum.load(relaxed) + nanos, relaxed);
+        m_Count.store(count + 1, std::memory_order_release);
+    }
+
+    [[nodiscard]] LatencySnapshot Snapshot() const noexcept;
+    void Reset() noexcept;
+
+private:
+    std::array<std::atomic<uint64_t>, LatencySnapshot::NUM_BUCKETS> m_Buckets{};
+    std::atomic<uint64_t> m_Count{0};
+    std::atomic<uint64_t> m_Sum{0};
+    std::atomic<uint64_t> m_Min{0};
+    std::atomic<uint64_t> m_Max{0};
+};
+
+}  // namespace CircularBuffer
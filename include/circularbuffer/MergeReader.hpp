@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Clock.hpp"
+#include "circularbuffer/Macros.hpp"
+#include "circularbuffer/Reader.hpp"
+#include "circularbuffer/Spec.hpp"
+#include "circularbuffer/Writer.hpp"
+
+namespace CircularBuffer {
+
+// POD struct for merge options
+struct MergeOptions {
+    // Max delay between a writer timestamping a message and the message
+    // becoming readable. An input with no data holds back the merge until
+    // the oldest pending message is this old, after which the input is
+    // assumed to have nothing older.
+    uint64_t maxDelayNanos{10'000};
+    // Options for each input's reader
+    ReaderOptions readerOptions{};
+};
+
+// Merges K rings, each with its own writer, into a single stream ordered by
+// message timestamp. Keeps the next message of each input in a min-heap keyed
+// on its timestamp, so each message costs O(log K) plus a refill of the input
+// it came from. Requires every writer to timestamp messages with the same
+// clock. Ties are broken by input order.
+class MergeReader {
+public:
+    explicit MergeReader(const std::vector<Spec> &specs,
+                         const MergeOptions &options = {});
+    ~MergeReader() = default;
+
+    // No default/copy/move construction
+    CB_EXPLICIT_DELETE_CONSTRUCTORS(MergeReader);
+
+    // Reads the oldest pending message across all inputs. Returns as
+    // `Reader::Read()`: 0 if there is no message that can be emitted in order
+    // yet, -1 if the read buffer is too small (the message stays pending) or
+    // an input had an invalid message, and `INT_MIN` if an input got
+    // overwritten. An input that failed skips to its latest message, so the
+    // merge carries on with the next read.
+    int Read(BufferT readBuffer);
+    // Compatibility interface
+    int Read(DataT *data, size_t size) { return Read({data, size}); }
+
+    // Writes every message that can be emitted in order to `writer`, e.g. to
+    // publish the merged stream as a ring. Returns the number of messages
+    // written, -1 if `writer` rejected a message (it stays pending, and can be
+    // taken with `Read()`), or as `Read()` if an input failed.
+    int Forward(Writer &writer);
+
+    // Input the last message was read from, and its timestamp
+    [[nodiscard]] size_t LastInput() const noexcept { return m_LastInput; }
+    [[nodiscard]] TimestampT LastTimestamp() const noexcept {
+        return m_LastTimestamp;
+    }
+
+private:
+    // Next message of an input, buffered
+    struct Input {
+        Spec spec;
+        std::unique_ptr<Reader> reader;
+        std::unique_ptr<DataT[]> buffer;
+        int size;
+        TimestampT timestamp;
+    };
+
+    // Reads the next message of inputs with none pending into the heap.
+    // Returns 0, or the error of an input that failed to read.
+    int Refill() noexcept;
+    // Replaces an input's reader with one at the latest message. Returns false
+    // if the input can't be reopened, leaving the old reader in place.
+    bool Reopen(int index) noexcept;
+    // Index of the input holding the oldest message that can be emitted in
+    // order, or -1
+    int Peek() const noexcept;
+    // Heap order: true if input `a`'s message comes after input `b`'s
+    bool After(int a, int b) const noexcept;
+
+    ReaderOptions m_ReaderOptions;
+    std::vector<Input> m_Inputs;
+    // Min-heap of inputs with a pending message
+    std::vector<int> m_Heap;
+    // Inputs with no pending message
+    std::vector<int> m_Empty;
+
+    ClockSource m_Clock{ClockSource::None};
+    // `MergeOptions::maxDelayNanos` in clock ticks
+    TimestampT m_MaxDelay{0};
+
+    size_t m_LastInput{0};
+    TimestampT m_LastTimestamp{0};
+};
+
+}  // namespace CircularBuffer
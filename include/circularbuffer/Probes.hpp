@@ -0,0 +1,28 @@
+#pragma once
+
+// USDT (SystemTap SDT) probes on the writer and reader hot paths, for `perf`,
+// bpftrace and other tools that attach to them without rebuilding. A probe
+// site is a single NOP plus an ELF note naming its arguments, so probes cost
+// nothing while no tool is attached (the arguments are values the code has in
+// registers anyway). Probes are compiled out if `<sys/sdt.h>` isn't available
+// (package systemtap-sdt-dev or systemtap-sdt-devel), or if `CB_DISABLE_PROBES`
+// is defined.
+//
+// Provider `circularbuffer`, with probes:
+//   write_reserve(seqNum, index, size)  writer about to copy a message
+//   write_publish(seqNum, index, size)  writer published the message
+//   wraparound(index, bytesToEnd)       writer wrapped around
+//   read_begin(seqNum, index)           reader about to copy a message
+//   read_end(seqNum, index, size)       reader copied a message intact
+//   overwrite(index, lag)               reader found it was overwritten
+//
+// `seqNum` is the sequence number at the start of the record, the same for the
+// writer and every reader of a message, so probes in different processes can
+// be matched up (see `bin/cblatency.bt`).
+
+#if !defined(CB_DISABLE_PROBES) && __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define CB_PROBE(name, ...) STAP_PROBEV(circularbuffer, name, __VA_ARGS__)
+#else
+#define CB_PROBE(name, ...) static_cast<void>(0)
+#endif
@@ -1,27 +1,224 @@
 #pragma once
 
+#include <sys/types.h>
+
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
 
 #include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/BasicRing.hpp"
+#include "circularbuffer/Clock.hpp"
+#include "circularbuffer/EventBridge.hpp"
 #include "circularbuffer/IWrapper.hpp"
+#include "circularbuffer/LatencyHistogram.hpp"
 #include "circularbuffer/Macros.hpp"
+#include "circularbuffer/RingPolicies.hpp"
+#include "circularbuffer/SeekIndex.hpp"
 #include "circularbuffer/Spec.hpp"
+#include "circularbuffer/Stats.hpp"
 
 namespace CircularBuffer {
 
-class Reader : public IWrapper {
+// Reader of a `SpecHeader` ring (see `BasicRing`). Event fds and statistics
+// slots are only available if the ring's wait and instrumentation policies
+// keep them. Instantiated in the library for `SpecRing` (`Reader`) and
+// `LeanSpecRing` (`LeanReader`).
+template <typename Ring>
+class SpecReader : public IWrapper {
+    static_assert(std::is_same_v<typename Ring::Header, SpecHeader> &&
+                  std::is_same_v<typename Ring::Capacity, SpecCapacity> &&
+                  !Ring::Overflow::LOSSLESS);
+
+    using Wait = typename Ring::Wait;
+    using Instrumentation = typename Ring::Instrumentation;
+
 public:
-    explicit Reader(const Spec &spec);
+    explicit SpecReader(const Spec &spec, const ReaderOptions &options = {});
+    ~SpecReader() override;
 
     // No default/copy/move construction
-    CB_EXPLICIT_DELETE_CONSTRUCTORS(Reader);
+    CB_EXPLICIT_DELETE_CONSTRUCTORS(SpecReader);
 
     // Returns positive int if buffer read-from successfully, or 0 if there is
     // no data to read. Returns -1 if the read buffer is too small. Returns
-    // `INT_MIN` if the Reader got overwritten by the Writer.
+    // `INT_MIN` if the Reader got overwritten by the Writer. Nothing is read
+    // until a writer has published its record framing, and a reader moves to
+    // the start of the stream when a new writer resets the buffer.
     int Read(BufferT readBuffer);
     // Compatibility interface
     int Read(DataT *data, size_t size) { return Read({data, size}); }
+    // Zero-copy read, if the writer keeps records contiguous (see
+    // `Spec::contiguousRecords`): points `message` at the next message in the
+    // buffer. Returns the same as `Read()`, or -1 if records may be split. The
+    // writer may overwrite the message at any time, so check `ViewIntact()`
+    // once done with it. Valid until the next read at most.
+    int ReadView(std::span<const DataT> &message);
+    // True if the message of the last `ReadView()` hasn't been overwritten
+    // yet
+    [[nodiscard]] bool ViewIntact() const noexcept;
+
+    // True if there is a message to read (or the reader has been overwritten).
+    // The writer moves the read index back to the start when it grows the
+    // buffer, so matching it only means there's nothing to read if the
+    // writer is still in our data region. Both are on one cacheline.
+    [[nodiscard]] bool Available() const noexcept {
+        return m_LocalIndex !=
+                   m_State->readIdx.load(std::memory_order_acquire) ||
+               m_State->readGeneration.load(std::memory_order_relaxed) !=
+                   m_DataGeneration;
+    }
+
+    // File descriptor that becomes readable when a message is written after
+    // `Arm()`, for use with epoll/poll/select. -1 unless
+    // `ReaderOptions::eventFd` is set, the writer sends notifications and the
+    // ring's wait policy keeps them.
+    [[nodiscard]] int EventFd() const noexcept;
+    // Clears `EventFd()` and requests a notification for the next message
+    // written. Call once `Read()` returns 0. Returns false without arming if
+    // there is data to read already, in which case keep reading.
+    bool Arm() noexcept;
+
+    // False once the writer this reader attached to has shut down, died,
+    // stopped publishing its heartbeat (if enabled) or been replaced by a new
+    // writer. Follows a writer that resumes the stream (see `Spec::resume`).
+    // Costs a syscall.
+    [[nodiscard]] bool WriterAlive() noexcept;
+    // Pidfd of the writer process, which becomes readable when it exits, for
+    // use with epoll/poll/select. -1 if unavailable. Replaced when
+    // `WriterAlive()` finds a new writer resumed the stream.
+    [[nodiscard]] int WriterFd() const noexcept { return m_WriterFd; }
+
+    // Positions the reader so that the next `Read()` returns message number
+    // `messageNumber` (counting from 0 since the writer started), either
+    // backwards or forwards. Returns false and leaves the position unchanged if
+    // the writer doesn't number messages, or the message has been overwritten,
+    // dropped out of the seek index or not been written yet. A reader still in
+    // a data region the writer has grown out of moves to the new one first,
+    // even if seeking then fails (see `Writer::Grow()`).
+    bool Seek(MessageNumberT messageNumber);
+
+    // Number of times the reader skipped ahead to the newest message (see
+    // `ReaderOptions::conflateLag`)
+    [[nodiscard]] uint64_t Conflations() const noexcept {
+        return m_Conflations;
+    }
+
+    // True if the writer numbers messages (see `Spec::seekInterval`)
+    [[nodiscard]] bool MessageNumbers() const noexcept {
+        return m_MessageNumbers;
+    }
+    // Number of the last message read (if the writer numbers messages)
+    [[nodiscard]] MessageNumberT LastMessageNumber() const {
+        return m_LastMessageNumber;
+    }
+    // Clock the writer timestamps messages with, and the length of its ticks
+    [[nodiscard]] ClockSource TimestampClock() const noexcept {
+        return m_Clock;
+    }
+    [[nodiscard]] double NanosPerTick() const noexcept {
+        return m_NanosPerTick;
+    }
+    // Timestamp of the last message read, in units of the writer's clock (0 if
+    // the writer doesn't timestamp messages)
+    [[nodiscard]] TimestampT LastTimestamp() const { return m_LastTimestamp; }
+    // Snapshot of writer-to-reader latencies in nanoseconds. Empty unless
+    // `ReaderOptions::latencyHistogram` is set and the writer timestamps
+    // messages.
+    [[nodiscard]] LatencySnapshot Latency() const noexcept;
+
+protected:
+    // Outcome of locating a message by number
+    enum class LocateResult { Found, NotWritten, Lost, Disabled };
+
+    // Finds the record of message number `messageNumber` using the seek index,
+    // setting `index` and `seqNum` to its position if found
+    LocateResult Locate(MessageNumberT messageNumber, IndexT &index,
+                        SeqNumT &seqNum);
+    // Loads a consistent snapshot of a seek index entry
+    static void LoadSeekEntry(const SeekEntry &entry,
+                              MessageNumberT &messageNumber, IndexT &index,
+                              SeqNumT &seqNum) noexcept;
+    // Counts an overwrite event in the shared statistics block
+    void RecordOverwrite() noexcept;
+    // Maps the data region the writer grew the buffer into and moves to its
+    // start. Returns false if the writer has already moved on from it too.
+    bool FollowRegion() noexcept;
+    // True if the writer has grown the buffer into the next data region,
+    // leaving this one intact from sequence number `seqNum` on
+    [[nodiscard]] bool RegionFrozen(SeqNumT seqNum) const noexcept;
+
+    // Set when an overwrite is detected, until the reader is repositioned
+    bool m_Overwritten{false};
+
+private:
+    // Decodes records the way the writer published, and creates the latency
+    // histogram if requested and the writer timestamps messages
+    void LoadFraming();
+    // Reloads the framing of writer generation `generation`, which reset the
+    // buffer, and moves to the start of its stream. Returns false if the
+    // data region it's in can't be mapped.
+    bool Restart(uint64_t generation);
+    // Reads the size of the record at `index` and decodes optional header
+    // fields
+    MessageSizeT ReadHeader(IndexT index) noexcept;
+    // Starts reading at the oldest intact record if the writer tracks it
+    bool LoadTail() noexcept;
+    // Moves to the newest record if the writer has published one in this data
+    // region since our position. Returns false if it can't.
+    bool Conflate() noexcept;
+    // Records the latency of the last message read
+    void RecordLatency() noexcept;
+    // Claims a slot in the shared statistics block if the writer enabled it,
+    // reclaiming one from a dead reader if none is free
+    void RegisterStats() noexcept;
+    // Opens a pidfd to watch writer process `writerPid`
+    void WatchWriter(pid_t writerPid) noexcept;
+    // Follows the writer to the data region it grew the buffer into, from the
+    // marker at the end of the old one, then reads
+    int ReadNextRegion(BufferT readBuffer);
+
+    // Slot in the shared statistics block, null if stats are disabled or all
+    // slots are taken
+    ReaderStats *m_Stats{nullptr};
+    uint64_t m_StatMessages{0};
+    uint64_t m_StatOverwrites{0};
+
+    MessageNumberT m_LastMessageNumber{INVALID_MESSAGE_NUMBER};
+    // Sequence number at the end of the last message read in place
+    SeqNumT m_ViewSeqNum{0};
+
+    // Conflation, 0 unless requested
+    size_t m_ConflateLag{0};
+    uint64_t m_Conflations{0};
+
+    // Notifications, null unless requested
+    EventBridge *m_Bridge{nullptr};
+
+    // Writer attached to
+    pid_t m_WriterPid{0};
+    uint64_t m_WriterGeneration{0};
+    int m_WriterFd{-1};
+
+    // Writer generation whose framing records are decoded with, 0 until a
+    // writer has published one
+    uint64_t m_FramingGeneration{0};
+
+    // Latency tracking
+    TimestampT m_LastTimestamp{0};
+    double m_NanosPerTick{1.0};
+    LatencyHistogram *m_Histogram{nullptr};
+    bool m_WantsHistogram{false};
 };
 
+extern template class SpecReader<SpecRing>;
+extern template class SpecReader<LeanSpecRing>;
+
+// Reader with every feature available
+using Reader = SpecRing::Reader;
+// Reader without event fds or statistics, for `LeanWriter` buffers
+using LeanReader = LeanSpecRing::Reader;
+
 }  // namespace CircularBuffer
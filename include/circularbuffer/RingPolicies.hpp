@@ -0,0 +1,264 @@
+#pragma once
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <bit>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <format>
+#include <limits>
+#include <stdexcept>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/EventBridge.hpp"
+#include "circularbuffer/Macros.hpp"
+#include "circularbuffer/State.hpp"
+#include "spdlog/spdlog.h"
+
+// Policies of `BasicRing`. Each policy family is a set of interchangeable
+// types with the same static interface, selected at compile time, so that
+// what a ring doesn't use costs nothing at runtime.
+
+namespace CircularBuffer {
+
+// POD struct for a wait/notify channel in shared memory (see `FutexWait`)
+struct RingSignal {
+    // Number of threads waiting
+    std::atomic<uint32_t> waiters;
+    // Futex word, bumped when waiters are notified
+    std::atomic<uint32_t> sequence;
+};
+
+// Header policies
+//
+// Record header: the message size, encoded as an unsigned integer. Its largest
+// value marks the space left at the end of the ring as skipped, so every
+// record is contiguous.
+
+template <typename SizeT>
+struct SizeHeader {
+    static constexpr size_t SIZE = sizeof(SizeT);
+    static constexpr uint64_t SKIP = std::numeric_limits<SizeT>::max();
+    // Largest message size the header holds
+    static constexpr uint64_t MAX_MESSAGE_SIZE = SKIP - 1;
+
+    static void Encode(DataT *dst, uint64_t size) noexcept {
+        const auto value = static_cast<SizeT>(size);
+        std::memcpy(dst, &value, SIZE);
+    }
+    [[nodiscard]] static uint64_t Decode(const DataT *src) noexcept {
+        SizeT value;
+        std::memcpy(&value, src, SIZE);
+        return value;
+    }
+};
+
+// 4-byte header, for messages up to 4 GiB - 2
+using Size32Header = SizeHeader<uint32_t>;
+// 2-byte header, for messages up to 65534 bytes
+using Size16Header = SizeHeader<uint16_t>;
+
+// Framing chosen at runtime through `Spec` (size field encoding, timestamps,
+// message numbers, alignment, contiguous records) and published in
+// `State::config`, as read and written by `SpecWriter`/`SpecReader`
+struct SpecHeader {};
+
+// Capacity policies
+//
+// Ring size in bytes, a power of two so that positions are wrapped with a mask.
+// Constructed from `BasicRingSpec::capacity`.
+
+// Capacity fixed at compile time: the mask is an immediate
+template <size_t Capacity_>
+class FixedCapacity {
+public:
+    static_assert(std::has_single_bit(Capacity_) &&
+                  Capacity_ >= static_cast<size_t>(CACHELINE_SIZE));
+
+    // `capacity` may be 0 or `Capacity_`
+    explicit FixedCapacity(size_t capacity) {
+        if (capacity != 0 && capacity != Capacity_) {
+            CB_CONSTEXPR_SV fmt =
+                "({}:{}) Capacity {} requested of a ring fixed at {}";
+            SPDLOG_ERROR(fmt.substr(8), capacity, Capacity_);
+            throw std::invalid_argument(
+                std::format(fmt, __FILE__, __LINE__, capacity, Capacity_));
+        }
+    }
+
+    [[nodiscard]] static constexpr size_t Capacity() noexcept {
+        return Capacity_;
+    }
+    [[nodiscard]] static constexpr size_t Index(uint64_t position) noexcept {
+        return position & (Capacity_ - 1);
+    }
+};
+
+// Capacity chosen at runtime
+class DynamicCapacity {
+public:
+    explicit DynamicCapacity(size_t capacity) : m_Mask(capacity - 1) {
+        if (!std::has_single_bit(capacity) ||
+            capacity < static_cast<size_t>(CACHELINE_SIZE)) {
+            CB_CONSTEXPR_SV fmt =
+                "({}:{}) Capacity {} is not a power of two of at least {}";
+            SPDLOG_ERROR(fmt.substr(8), capacity, CACHELINE_SIZE);
+            throw std::invalid_argument(std::format(fmt, __FILE__, __LINE__,
+                                                    capacity, CACHELINE_SIZE));
+        }
+    }
+
+    [[nodiscard]] size_t Capacity() const noexcept { return m_Mask + 1; }
+    [[nodiscard]] size_t Index(uint64_t position) const noexcept {
+        return position & m_Mask;
+    }
+
+private:
+    uint64_t m_Mask;
+};
+
+// Any capacity, set by `Spec::bufferCapacity` and grown with
+// `SpecWriter::Grow()`. Only for `SpecHeader` rings.
+struct SpecCapacity {};
+
+// Overflow policies
+//
+// What happens when the writer catches up with a reader
+
+// The writer never waits. Any number of readers, each detecting that it has
+// been lapped after copying a message, like `Reader`.
+struct Overwrite {
+    static constexpr bool LOSSLESS = false;
+};
+
+// The writer waits for the reader to free space, so no message is lost. One
+// reader, whose position is kept in the ring so that a new reader picks up
+// where the last one stopped.
+struct Block {
+    static constexpr bool LOSSLESS = true;
+};
+
+// Wait policies
+//
+// How a reader waits for data, and a blocked writer for space, in the
+// `WaitUntil()` calls. The other side calls `Notify()` after every update.
+
+// Busy-polls: lowest latency, burns a core. Notifying is free.
+struct SpinWait {
+    static constexpr bool NOTIFIES = false;
+
+    template <typename Ready>
+    static void WaitUntil(RingSignal & /*signal*/, Ready ready) noexcept {
+        while (!ready()) {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+        }
+    }
+
+    static void Notify(RingSignal & /*signal*/) noexcept {}
+};
+
+// Sleeps on a futex in shared memory, across processes. Notifying costs a
+// fence, plus a syscall while someone is waiting.
+struct FutexWait {
+    static constexpr bool NOTIFIES = true;
+
+    template <typename Ready>
+    static void WaitUntil(RingSignal &signal, Ready ready) noexcept {
+        // Bounds how long a lost wake-up can go unnoticed
+        static constexpr timespec timeout{0, 100'000'000};
+
+        while (!ready()) {
+            const uint32_t sequence =
+                signal.sequence.load(std::memory_order_acquire);
+            signal.waiters.fetch_add(1, std::memory_order_relaxed);
+            // Pairs with the fence in `Notify()`: either it sees us waiting,
+            // or we see its update
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!ready()) {
+                // Futex words live in shared memory, so no FUTEX_PRIVATE_FLAG
+                syscall(SYS_futex, FutexWord(signal), FUTEX_WAIT, sequence,
+                        &timeout, nullptr, 0);
+            }
+            signal.waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    static void Notify(RingSignal &signal) noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (signal.waiters.load(std::memory_order_relaxed) != 0) [[unlikely]] {
+            signal.sequence.fetch_add(1, std::memory_order_release);
+            syscall(SYS_futex, FutexWord(signal), FUTEX_WAKE, INT_MAX, nullptr,
+                    nullptr, 0);
+        }
+    }
+
+private:
+    static uint32_t *FutexWord(RingSignal &signal) noexcept {
+        static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+        return reinterpret_cast<uint32_t *>(&signal.sequence);
+    }
+};
+
+// Readers wait on an eventfd (see `SpecReader::Arm()`), which the writer wakes
+// through `State::notification` if `Spec::enableNotifications` is set. Only
+// for `SpecHeader` rings.
+struct EventWait {
+    static constexpr bool NOTIFIES = true;
+
+    static void Notify(Notification &notification) noexcept {
+        EventBridge::Signal(notification);
+    }
+};
+
+// Instrumentation policies
+//
+// Per-writer or per-reader event hooks. Stateless policies take up no space.
+
+// Compiles away entirely
+struct NoInstrumentation {
+    static constexpr bool SHARED_STATS = false;
+
+    void OnWrite(size_t /*size*/) noexcept {}
+    void OnRead(size_t /*size*/) noexcept {}
+    void OnWait() noexcept {}
+    void OnOverwrite() noexcept {}
+};
+
+// Local counters, e.g. for an audit trail: no atomics, no shared memory
+struct CountingInstrumentation {
+    static constexpr bool SHARED_STATS = false;
+
+    uint64_t messages{0};
+    uint64_t bytes{0};
+    // Times the writer waited for space or the reader for data
+    uint64_t waits{0};
+    uint64_t overwrites{0};
+
+    void OnWrite(size_t size) noexcept {
+        messages++;
+        bytes += size;
+    }
+    void OnRead(size_t size) noexcept {
+        messages++;
+        bytes += size;
+    }
+    void OnWait() noexcept { waits++; }
+    void OnOverwrite() noexcept { overwrites++; }
+};
+
+// Counters in the shared statistics block (`State::stats`) read by cbstat,
+// published if `Spec::enableStats` is set. Only for `SpecHeader` rings, whose
+// writer and readers update the block themselves.
+struct SharedStats : NoInstrumentation {
+    static constexpr bool SHARED_STATS = true;
+};
+
+}  // namespace CircularBuffer
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "circularbuffer/Aliases.hpp"
+
+namespace CircularBuffer {
+
+// Number of entries in the seek index. Entries are reused round-robin, so with
+// an interval of K the index covers the last K * SEEK_INDEX_SIZE messages.
+static constexpr int SEEK_INDEX_SIZE = 1024;
+
+// Position of a numbered message. Published under a seqlock: `version` is odd
+// while the entry is being updated.
+struct SeekEntry {
+    std::atomic<uint64_t> version;
+    // Message number, `INVALID_MESSAGE_NUMBER` if unused
+    std::atomic<MessageNumberT> messageNumber;
+    // Buffer index and sequence number at the start of the message's record
+    std::atomic<IndexT> index;
+    std::atomic<SeqNumT> seqNum;
+};
+
+// POD struct for a sparse index of message positions in shared memory. If
+// enabled, the writer records the position of every `interval`th message, so
+// readers can seek to any message by hopping at most `interval - 1` headers
+// from the nearest entry.
+struct SeekIndex {
+    // Messages between entries, 0 if disabled
+    alignas(CACHELINE_SIZE) std::atomic<uint64_t> interval;
+    // Entry for message number `n * interval` is at `n % SEEK_INDEX_SIZE`
+    SeekEntry entries[SEEK_INDEX_SIZE];
+};
+
+}  // namespace CircularBuffer
@@ -25,6 +25,9 @@ public:
     bool Acquire(int &err) noexcept;
     bool Release() noexcept;
     bool Release(int &err) noexcept;
+    // Takes ownership of the semaphore without decrementing it, when it was
+    // left locked by a process that died holding it
+    void Adopt() noexcept;
 
     [[nodiscard]] std::string_view Name() const { return m_Name; }
 
@@ -19,11 +19,16 @@ public:
     // See "DESCRIPTION" at
     // https://man7.org/linux/man-pages/man3/shm_open.3.html
     static constexpr size_t MAX_NAME_LEN = NAME_MAX;
-    // Arbitrary 50 MiB
+    // Default size limit, set at build time (50 MiB unless overridden)
     static constexpr size_t MAX_SIZE_BYTES =
-        CB_MAX_SHARED_MEM_SIZE_MIB * 1024 * 1024;
-
-    SharedMemory(std::string_view shMemName, size_t requestedSize);
+        size_t{CB_MAX_SHARED_MEM_SIZE_MIB} * 1024 * 1024;
+
+    // If `readOnly` is set, the shared memory must already exist: it is mapped
+    // read-only and the reference counter is left untouched, so the mapping
+    // never keeps the memory alive (e.g. for monitoring tools). Sizes above
+    // `maxSize` are rejected.
+    SharedMemory(std::string_view shMemName, size_t requestedSize,
+                 bool readOnly = false, size_t maxSize = MAX_SIZE_BYTES);
     ~SharedMemory();
 
     // No default/copy/move construction
@@ -61,6 +66,11 @@ public:
     [[nodiscard]] std::string Name() const { return m_Name; }
     [[nodiscard]] size_t Size() const { return m_DataSize; }
     [[nodiscard]] int ReferenceCount() const;
+    [[nodiscard]] bool ReadOnly() const { return m_ReadOnly; }
+
+    // Asks the kernel to back the mapping with transparent huge pages.
+    // Returns false if it can't, e.g. if shmem THP is disabled.
+    bool AdviseHugePages() noexcept;
 
 private:
     // Open a shared memory location using shm_open. Returns false if shared
@@ -93,6 +103,8 @@ private:
     const size_t m_DataSize;
     // Size in bytes of shared data region plus reference counter
     const size_t m_TotalSize;
+    // Mapped read-only without participating in reference counting
+    const bool m_ReadOnly;
     // For storing the FD that describes our shared memory
     int m_FileDes{-1};
     // Semaphore lock for synchronizing linking/unlinking of shared memory
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "circularbuffer/Aliases.hpp"
+
+namespace CircularBuffer {
+
+// Encoding of the message size at the start of each record header
+enum class SizeField : uint32_t {
+    // Signed 32-bit, for messages up to `MAX_MESSAGE_SIZE` whatever it is set
+    // to at build time
+    Int32 = 0,
+    // Unsigned 16-bit, saving 2 bytes per record. Messages up to 65534 bytes.
+    Uint16,
+    // LEB128 varint: 1 byte for messages up to 127 bytes, 2 up to 16383 and 3
+    // above, saving 2-3 bytes per small record. Messages up to 2 MiB - 2.
+    Varint,
+};
+
+// Bytes the size field takes up at most
+inline constexpr int MaxSizeFieldBytes(SizeField field) noexcept {
+    switch (field) {
+        case SizeField::Uint16:
+            return sizeof(uint16_t);
+        case SizeField::Varint:
+            return 3;
+        default:
+            return sizeof(MessageSizeT);
+    }
+}
+
+// Largest message size the field can hold. The all-ones pattern is reserved
+// for `GROW_MARKER`.
+inline constexpr MessageSizeT MaxEncodableSize(SizeField field) noexcept {
+    switch (field) {
+        case SizeField::Uint16:
+            return UINT16_MAX - 1;
+        case SizeField::Varint:
+            return (1 << 21) - 2;
+        default:
+            return INT32_MAX;
+    }
+}
+
+// Bytes the size field takes up for a message of `msgSize` bytes
+inline int SizeFieldBytes(SizeField field, MessageSizeT msgSize) noexcept {
+    if (field != SizeField::Varint) {
+        return MaxSizeFieldBytes(field);
+    }
+    // `GROW_MARKER` takes up 3 bytes
+    const auto size = static_cast<uint32_t>(msgSize);
+    return size < (1 << 7) ? 1 : size < (1 << 14) ? 2 : 3;
+}
+
+// Writes the size field for a message of `msgSize` bytes, or `GROW_MARKER`, to
+// `dst`. Returns the bytes written.
+inline int EncodeSize(SizeField field, MessageSizeT msgSize,
+                      DataT *dst) noexcept {
+    switch (field) {
+        case SizeField::Uint16: {
+            const uint16_t size = static_cast<uint16_t>(msgSize);
+            std::memcpy(dst, &size, sizeof(size));
+            return sizeof(size);
+        }
+        case SizeField::Varint: {
+            uint32_t size = msgSize == GROW_MARKER
+                                ? MaxEncodableSize(SizeField::Varint) + 1
+                                : static_cast<uint32_t>(msgSize);
+            const int bytes = SizeFieldBytes(field, msgSize);
+            for (int i = 0; i < bytes - 1; i++) {
+                dst[i] = static_cast<DataT>((size & 0x7f) | 0x80);
+                size >>= 7;
+            }
+            dst[bytes - 1] = static_cast<DataT>(size);
+            return bytes;
+        }
+        default:
+            std::memcpy(dst, &msgSize, sizeof(msgSize));
+            return sizeof(msgSize);
+    }
+}
+
+// Reads the size field at `src`, setting `fieldBytes` to its length. Returns
+// `GROW_MARKER` for the all-ones pattern, and a negative size if the field is
+// corrupt.
+inline MessageSizeT DecodeSize(SizeField field, const DataT *src,
+                               int &fieldBytes) noexcept {
+    switch (field) {
+        case SizeField::Uint16: {
+            uint16_t size;
+            std::memcpy(&size, src, sizeof(size));
+            fieldBytes = sizeof(size);
+            return size == UINT16_MAX ? GROW_MARKER : size;
+        }
+        case SizeField::Varint: {
+            uint32_t size = 0;
+            for (fieldBytes = 0; fieldBytes < 3; fieldBytes++) {
+                const auto byte = static_cast<uint32_t>(src[fieldBytes]);
+                size |= (byte & 0x7f) << (7 * fieldBytes);
+                if ((byte & 0x80) == 0) {
+                    fieldBytes++;
+                    return size == MaxEncodableSize(SizeField::Varint) + 1
+                               ? GROW_MARKER
+                               : static_cast<MessageSizeT>(size);
+                }
+            }
+            return INT32_MIN;
+        }
+        default:
+            MessageSizeT size;
+            std::memcpy(&size, src, sizeof(size));
+            fieldBytes = sizeof(size);
+            return size;
+    }
+}
+
+}  // namespace CircularBuffer
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Macros.hpp"
+#include "circularbuffer/SlotRing.hpp"
+
+namespace CircularBuffer {
+
+// Reader of a fixed-slot ring (see `SlotWriter`). Starts at the next message
+// written. Any number of readers, in any number of processes.
+class SlotReader : public SlotRing {
+public:
+    explicit SlotReader(const SlotSpec &spec);
+    ~SlotReader() override = default;
+
+    // No default/copy/move construction
+    CB_EXPLICIT_DELETE_CONSTRUCTORS(SlotReader);
+
+    // Returns the message size if a message was read, or 0 if the next one
+    // hasn't been written yet. Returns -1 if the read buffer is too small.
+    // Returns `INT_MIN` if the writer lapped the reader: the reader skips to
+    // the oldest message the writer isn't about to overwrite, and reading can
+    // continue.
+    int Read(BufferT readBuffer);
+    // Compatibility interface
+    int Read(DataT *data, size_t size) { return Read({data, size}); }
+
+    // True if there is a message to read (or the reader has been lapped)
+    [[nodiscard]] bool Available() const noexcept {
+        return SlotAt(m_Next).stamp.load(std::memory_order_acquire) >=
+               2 * m_Next + 2;
+    }
+
+    // Number of the next message to read
+    [[nodiscard]] uint64_t Next() const noexcept { return m_Next; }
+    // Number of messages skipped after being lapped
+    [[nodiscard]] uint64_t Lost() const noexcept { return m_Lost; }
+
+private:
+    // Skips to the oldest message the writer isn't overwriting. Returns
+    // `INT_MIN`.
+    int Lapped() noexcept;
+
+    uint64_t m_Next{0};
+    uint64_t m_Lost{0};
+};
+
+}  // namespace CircularBuffer
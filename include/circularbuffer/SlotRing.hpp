@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Macros.hpp"
+#include "circularbuffer/SharedMemory.hpp"
+
+namespace CircularBuffer {
+
+// POD struct for fixed-slot ring specification (see `SlotWriter`)
+struct SlotSpec {
+    // Name of shared memory region holding the ring
+    std::string sharedMemoryName;
+    // Bytes per slot, header included. Must be a power of two no smaller than
+    // a cacheline, so slots don't share cachelines.
+    size_t slotSize{256};
+    // Number of slots. Must be a power of two.
+    size_t slotCount{4096};
+};
+
+// POD struct at the start of the ring, followed by the slots
+struct SlotRingHeader {
+    // Geometry, set by the writer so readers can check it (0 until then)
+    alignas(CACHELINE_SIZE) std::atomic<uint64_t> slotSize;
+    std::atomic<uint64_t> slotCount;
+    // Number of messages written. Only read by readers when they start or
+    // have been lapped, never in steady state.
+    alignas(CACHELINE_SIZE) std::atomic<uint64_t> published;
+};
+
+// POD struct starting each slot, followed by the payload. Message `n` goes in
+// slot `n % slotCount`, stamped `2n + 1` while it is being written and `2n + 2`
+// once complete. The stamp is a per-slot seqlock: readers check it before and
+// after copying the payload.
+struct SlotHeader {
+    std::atomic<uint64_t> stamp;
+    std::atomic<uint32_t> size;
+    uint32_t reserved;
+};
+
+static constexpr int SLOT_HEADER_SIZE = sizeof(SlotHeader);
+
+// Base of `SlotWriter` and `SlotReader`: maps the ring and locates slots
+class SlotRing {
+public:
+    virtual ~SlotRing();
+
+    // No default/copy/move construction
+    CB_EXPLICIT_DELETE_CONSTRUCTORS(SlotRing);
+
+    [[nodiscard]] size_t SlotSize() const noexcept { return m_SlotSize; }
+    [[nodiscard]] size_t SlotCount() const noexcept { return m_SlotMask + 1; }
+    // Largest message a slot holds
+    [[nodiscard]] MessageSizeT MaxMessageSize() const noexcept {
+        return m_MaxMessageSize;
+    }
+
+protected:
+    explicit SlotRing(const SlotSpec &spec);
+
+    // Slot holding message `n`
+    [[nodiscard]] SlotHeader &SlotAt(uint64_t n) const noexcept {
+        return *reinterpret_cast<SlotHeader *>(
+            m_Slots + ((n & m_SlotMask) << m_SlotShift));
+    }
+    // Payload of `slot`
+    [[nodiscard]] static DataT *Payload(SlotHeader &slot) noexcept {
+        return reinterpret_cast<DataT *>(&slot) + SLOT_HEADER_SIZE;
+    }
+
+    // Checks the geometry published by the writer, if any, against ours
+    void CheckGeometry() const;
+
+    SharedMemory *m_Region{nullptr};
+    SlotRingHeader *m_Header{nullptr};
+    DataT *m_Slots{nullptr};
+    const size_t m_SlotSize;
+    const uint64_t m_SlotMask;
+    const int m_SlotShift;
+    const MessageSizeT m_MaxMessageSize;
+};
+
+}  // namespace CircularBuffer
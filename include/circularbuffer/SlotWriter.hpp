@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Macros.hpp"
+#include "circularbuffer/SemaphoreLock.hpp"
+#include "circularbuffer/SlotRing.hpp"
+
+namespace CircularBuffer {
+
+// Writer of a fixed-slot ring, Disruptor-style: message `n` goes in slot
+// `n % slotCount` whatever its size, and each slot carries its own sequence
+// stamp, written last. Readers validate exactly the slot they read, so they
+// never touch shared state in steady state and read safely while the writer
+// laps them. Trades space for simplicity: every message takes up a whole slot.
+//
+// One writer per ring. A new writer continues the message numbers of the
+// previous one if the ring is still in shared memory.
+class SlotWriter : public SlotRing {
+public:
+    explicit SlotWriter(const SlotSpec &spec);
+    ~SlotWriter() override = default;
+
+    // No default/copy/move construction
+    CB_EXPLICIT_DELETE_CONSTRUCTORS(SlotWriter);
+
+    // Writes a message to the next slot. Returns false if it's bigger than
+    // `MaxMessageSize()`.
+    bool Write(BufferT writeBuffer);
+    // Compatibility interface
+    bool Write(DataT *data, size_t size) { return Write({data, size}); }
+
+    // Number of messages written to the ring so far
+    [[nodiscard]] uint64_t Published() const noexcept { return m_Next; }
+
+private:
+    static std::string MakeSemName(const SlotSpec &spec);
+
+    SemaphoreLock m_SemLock;
+    // Number of the next message
+    uint64_t m_Next{0};
+};
+
+}  // namespace CircularBuffer
@@ -3,6 +3,9 @@
 #include <cstddef>
 #include <string>
 
+#include "circularbuffer/Clock.hpp"
+#include "circularbuffer/SizeField.hpp"
+
 namespace CircularBuffer {
 
 // POD struct for buffer specification
@@ -13,6 +16,84 @@ struct Spec {
     std::string dataSharedMemoryName;
     // Requested capacity in bytes
     size_t bufferCapacity{0};
+    // Largest capacity the buffer may be created with, grown to or mapped at,
+    // in bytes (0 for the `MAX_SHARED_MEM_SIZE_MIB` build default). Raise it
+    // for multi-GB buffers.
+    size_t maxBufferCapacity{0};
+    // Back the buffer with transparent huge pages to cut TLB misses on big
+    // buffers. Needs shmem THP enabled (`advise` or `always` in
+    // `/sys/kernel/mm/transparent_hugepage/shmem_enabled`), regular pages are
+    // used otherwise.
+    bool hugePages{false};
+    // Writer publishes statistics to shared memory (see `Stats`)
+    bool enableStats{false};
+    // Writer timestamps each message with this clock (see `ClockSource`)
+    ClockSource timestamps{ClockSource::None};
+    // Writer encodes message sizes in record headers this way. Smaller fields
+    // fit more small messages in the buffer, but limit their size (see
+    // `SizeField`).
+    SizeField sizeField{SizeField::Int32};
+    // Writer copies messages of at least this many bytes with non-temporal
+    // stores to avoid polluting its own cache (0 to disable)
+    size_t streamingStoreThreshold{0};
+    // Writer pads each record to a multiple of this many bytes so headers and
+    // payloads are aligned. Must be a power of two no smaller than the record
+    // header and divide `bufferCapacity` (1 packs records byte-tight)
+    size_t recordAlignment{1};
+    // Writer keeps every record contiguous: one that doesn't fit before the
+    // end of the buffer starts over at its beginning, behind a copy of its
+    // header telling readers to skip there. Costs up to a record of space per
+    // lap and limits messages to half the buffer, but lets readers use
+    // messages in place (see `Reader::ReadView()`).
+    bool contiguousRecords{false};
+    // Writer tracks the oldest intact record so that readers can replay the
+    // buffer (see `ReaderOptions::replay`)
+    bool enableReplay{false};
+    // Writer publishes the start of the newest record after each write, so
+    // that readers can skip to it when they fall behind (see
+    // `ReaderOptions::conflateLag`)
+    bool enableConflation{false};
+    // Writer numbers messages in their header, and records the position of
+    // every `seekInterval`th message so readers can `Seek()` to a message
+    // number in at most `seekInterval - 1` hops (0 to disable)
+    size_t seekInterval{0};
+    // Writer wakes readers waiting on an eventfd (see
+    // `ReaderOptions::eventFd`). Adds a fence to every write, but no syscall
+    // unless a reader is waiting.
+    bool enableNotifications{false};
+    // Writer publishes a heartbeat from a background thread with this period,
+    // so readers can tell a stopped or hung writer process from an idle one
+    // (0 to disable; see `Reader::WriterAlive()`)
+    size_t heartbeatMs{0};
+    // Writer resumes the stream left in shared memory by a previous writer,
+    // continuing its indices, message numbers and statistics under live
+    // readers, instead of resetting the buffer. The last records are checked
+    // first, using the seek index or tail if enabled. Takes over the lock of a
+    // writer that died holding it. Resets the buffer if there's no stream to
+    // resume, its framing differs or its records don't check out.
+    bool resume{false};
+    // Writer stands by in its constructor until the writer holding the buffer
+    // exits, or stops publishing its heartbeat (in which case it is killed),
+    // then takes over and resumes its stream (see `resume`)
+    bool standby{false};
+};
+
+// POD struct for per-reader options
+struct ReaderOptions {
+    // Record writer-to-reader latency of timestamped messages in a histogram
+    bool latencyHistogram{false};
+    // Start at the oldest message still intact in the buffer instead of the
+    // next message written. Requires `Spec::enableReplay` in the writer.
+    bool replay{false};
+    // Create an eventfd that becomes readable when a message is written after
+    // `Reader::Arm()`. Requires `Spec::enableNotifications` in the writer.
+    bool eventFd{false};
+    // Skip to the newest message whenever the writer gets more than this many
+    // bytes ahead, for consumers that only care about recent data (0 to
+    // disable). A lagging reader then never falls far enough behind to be
+    // overwritten. Clamped to half the buffer capacity. Requires
+    // `Spec::enableConflation` in the writer.
+    size_t conflateLag{0};
 };
 
 }  // namespace CircularBuffer
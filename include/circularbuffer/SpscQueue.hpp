@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Macros.hpp"
+
+namespace CircularBuffer {
+
+// Bounded single-producer/single-consumer queue of variable-size messages in
+// process memory. Records are kept contiguous (a skip marker sends the
+// consumer back to the start of the buffer), so the consumer reads messages in
+// place.
+class SpscQueue {
+public:
+    // Capacity is rounded up to a power of two, and must fit at least two of
+    // the largest messages
+    explicit SpscQueue(size_t capacity);
+    ~SpscQueue();
+
+    // No default/copy/move construction
+    CB_EXPLICIT_DELETE_CONSTRUCTORS(SpscQueue);
+
+    // Producer: copies a message into the queue. Returns false if there isn't
+    // enough space.
+    bool TryPush(std::span<const DataT> message) noexcept;
+
+    // Consumer: points `message` at the next message, valid until `Pop()`.
+    // Returns false if the queue is empty.
+    bool Front(std::span<const DataT> &message) noexcept;
+    // Consumer: releases the message returned by `Front()`
+    void Pop() noexcept;
+
+    [[nodiscard]] size_t Capacity() const noexcept { return m_Capacity; }
+
+    // Smallest capacity accepted
+    static constexpr size_t MIN_CAPACITY = 4 * (MAX_MESSAGE_SIZE + 8);
+
+private:
+    // Size of a record holding a message of `size` bytes
+    static uint64_t RecordSize(size_t size) noexcept;
+
+    DataT *m_Data{nullptr};
+    const size_t m_Capacity;
+
+    // Consumer position (bytes popped), and consumer's cache of the producer
+    // position
+    alignas(CACHELINE_SIZE) std::atomic<uint64_t> m_Head{0};
+    uint64_t m_CachedTail{0};
+    // Size of the record returned by `Front()`
+    uint64_t m_FrontRecordSize{0};
+
+    // Producer position (bytes pushed), and producer's cache of the consumer
+    // position
+    alignas(CACHELINE_SIZE) std::atomic<uint64_t> m_Tail{0};
+    uint64_t m_CachedHead{0};
+};
+
+}  // namespace CircularBuffer
@@ -1,17 +1,149 @@
 #pragma once
 
+#include <sys/types.h>
+
 #include <atomic>
+#include <cstdint>
 
 #include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Clock.hpp"
+#include "circularbuffer/SeekIndex.hpp"
+#include "circularbuffer/SizeField.hpp"
+#include "circularbuffer/Stats.hpp"
 
 namespace CircularBuffer {
 
+// POD struct describing how records are framed. Published by the writer so
+// that readers decode records correctly.
+struct Config {
+    // Source of per-message timestamps, `ClockSource::None` if disabled
+    alignas(CACHELINE_SIZE) std::atomic<ClockSource> clock;
+    // TSC calibration, valid if `clock` is `ClockSource::TSC`
+    std::atomic<double> nanosPerTick;
+    // Records are padded to a multiple of this many bytes
+    std::atomic<uint32_t> recordAlignment;
+    // Non-zero if the header ends with the message number
+    std::atomic<uint32_t> messageNumbers;
+    // Encoding of the message size starting the header
+    std::atomic<SizeField> sizeField;
+    // Non-zero if records never split across the end of the buffer
+    std::atomic<uint32_t> contiguousRecords;
+};
+
+// POD struct locating the oldest intact record, maintained by the writer if
+// enabled. Index and sequence number are published under a seqlock: `version`
+// is odd while they are being updated.
+struct Tail {
+    alignas(CACHELINE_SIZE) std::atomic<uint64_t> enabled;
+    std::atomic<uint64_t> version;
+    std::atomic<IndexT> index;
+    std::atomic<SeqNumT> seqNum;
+};
+
+// POD struct locating the start of the newest record, published by the writer
+// after each write if enabled so lagging readers can skip ahead (see
+// `ReaderOptions::conflateLag`). Published under a seqlock like `Tail`;
+// `version` is 0 until a record has been written.
+struct Latest {
+    alignas(CACHELINE_SIZE) std::atomic<uint64_t> enabled;
+    std::atomic<uint64_t> version;
+    // Data region the record is in
+    std::atomic<uint64_t> generation;
+    std::atomic<IndexT> index;
+    std::atomic<SeqNumT> seqNum;
+};
+
+// POD struct for waking readers waiting for the next write (see
+// `EventBridge`)
+struct Notification {
+    alignas(CACHELINE_SIZE) std::atomic<uint32_t> enabled;
+    // Number of readers waiting to be notified
+    std::atomic<uint32_t> armed;
+    // Futex word, incremented by the writer when it notifies
+    std::atomic<uint32_t> sequence;
+};
+
+// Heartbeats a writer may miss before readers consider it stopped
+static constexpr int HEARTBEAT_MISSES = 3;
+
+// POD struct identifying the writer, so readers can tell when it's gone
+struct Liveness {
+    // Pid of the writer, 0 once it has shut down cleanly
+    alignas(CACHELINE_SIZE) std::atomic<pid_t> writerPid;
+    // Incremented by each writer that resets the buffer, kept by writers that
+    // resume its stream
+    std::atomic<uint64_t> generation;
+    // Period of the writer's heartbeat in milliseconds, 0 if disabled
+    std::atomic<uint32_t> heartbeatMs;
+    // `CLOCK_MONOTONIC` time of the last heartbeat in nanoseconds
+    std::atomic<uint64_t> heartbeat;
+};
+
+// True if the writer publishes a heartbeat and has missed too many
+inline bool HeartbeatMissed(const Liveness& liveness) noexcept {
+    const uint64_t heartbeatMs =
+        liveness.heartbeatMs.load(std::memory_order_relaxed);
+    return heartbeatMs != 0 &&
+           MonotonicNanos() -
+                   liveness.heartbeat.load(std::memory_order_acquire) >
+               HEARTBEAT_MISSES * heartbeatMs * 1'000'000;
+}
+
+// POD struct locating the data region the writer is using. Region 0 is named
+// after `Spec::dataSharedMemoryName`, and each time the writer grows the buffer
+// it moves to the next one (see `Writer::Grow()`).
+struct DataRegion {
+    alignas(CACHELINE_SIZE) std::atomic<uint64_t> generation;
+    // Capacity in bytes, 0 for `Spec::bufferCapacity`
+    std::atomic<uint64_t> capacity;
+    // Sequence number and message number at the start of the region
+    std::atomic<SeqNumT> baseSeqNum;
+    std::atomic<MessageNumberT> baseMessageNumber;
+};
+
+// Max number of consumer groups sharing a buffer
+static constexpr int MAX_CONSUMER_GROUPS = 16;
+
+// POD struct for a group of readers sharing the messages of a buffer (see
+// `GroupReader`). Members claim messages by number with a fetch-add on the
+// cursor.
+struct ConsumerGroup {
+    // Number of the next unclaimed message
+    alignas(CACHELINE_SIZE) std::atomic<MessageNumberT> cursor;
+};
+
 // POD struct for maintaining buffer state in shared memory
 struct State {
     // Cacheline alignement needed to avoid false sharing
     alignas(CACHELINE_SIZE) std::atomic<IndexT> readIdx;
+    // Data region `readIdx` is in, on the same cacheline so that idle readers
+    // can tell the writer grew the buffer without touching `region`
+    std::atomic<uint64_t> readGeneration;
+    // Writer generation that started the stream `readIdx` is in, also on this
+    // cacheline so that readers can tell the writer reset the buffer without
+    // touching `liveness`
+    std::atomic<uint64_t> readWriterGeneration;
     alignas(CACHELINE_SIZE) std::atomic<IndexT> writeIdx;
     alignas(CACHELINE_SIZE) std::atomic<SeqNumT> seqNum;
+
+    // Record framing
+    Config config;
+    // Oldest intact record, for replay
+    Tail tail;
+    // Newest record, for conflation
+    Latest latest;
+    // Positions of numbered messages, for seeking
+    SeekIndex seekIndex;
+    // Wake-ups for readers waiting on an eventfd
+    Notification notification;
+    // Claim cursors of consumer groups
+    ConsumerGroup groups[MAX_CONSUMER_GROUPS];
+    // Writer identity and heartbeat
+    Liveness liveness;
+    // Data region in use
+    DataRegion region;
+    // Optional statistics, kept off the index cachelines
+    Stats stats;
 };
 
 }  // namespace CircularBuffer
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <cstdint>
+
+#include "circularbuffer/Aliases.hpp"
+
+namespace CircularBuffer {
+
+// Max number of readers that can register for statistics tracking on a buffer
+static constexpr int MAX_TRACKED_READERS = 16;
+
+// Per-reader counters. Each reader claims a slot by CAS-ing its pid into a free
+// (zero) slot, or one whose process has died without releasing it, and owns the
+// cacheline exclusively until it releases it.
+struct ReaderStats {
+    // Pid of the process owning this slot, 0 if free
+    alignas(CACHELINE_SIZE) std::atomic<pid_t> pid;
+    // Reader's local sequence number (i.e. total bytes consumed)
+    std::atomic<SeqNumT> seqNum;
+    // Messages read
+    std::atomic<uint64_t> messages;
+    // Number of times the reader detected that it was overwritten
+    std::atomic<uint64_t> overwrites;
+};
+
+// POD struct for buffer statistics in shared memory. Counters are only ever
+// written by their owner with relaxed stores after the write/read has been
+// published, so they never add ordering constraints to the hot path.
+struct Stats {
+    // Non-zero if the writer has enabled statistics collection
+    alignas(CACHELINE_SIZE) std::atomic<uint64_t> enabled;
+    // Buffer capacity in bytes, published by the writer for monitoring tools
+    std::atomic<uint64_t> capacity;
+    // Messages written
+    std::atomic<uint64_t> messages;
+    // Message bytes written (excluding headers)
+    std::atomic<uint64_t> bytes;
+    // Number of times the writer wrapped around to the start of the buffer
+    std::atomic<uint64_t> wraps;
+    // Largest message written
+    std::atomic<uint64_t> maxMessageSize;
+
+    ReaderStats readers[MAX_TRACKED_READERS];
+};
+
+}  // namespace CircularBuffer
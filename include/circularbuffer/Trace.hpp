@@ -0,0 +1,134 @@
+#pragma once
+
+#include <sys/types.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Clock.hpp"
+#include "circularbuffer/Macros.hpp"
+#include "circularbuffer/SharedMemory.hpp"
+
+namespace CircularBuffer {
+
+// Library events recorded while tracing. `index` and `size` of each record
+// mean different things depending on the event.
+enum class TraceEvent : uint16_t {
+    None = 0,
+    // Writer published a record: buffer index and message size
+    Publish,
+    // Writer wrapped around: index of the record and bytes left before the end
+    Wrap,
+    // Writer grew the buffer: new capacity and data region generation
+    Grow,
+    // Reader read a record: buffer index and message size
+    Read,
+    // Reader was overwritten: its buffer index and lag in bytes
+    Overwrite,
+    // Reader skipped to the newest record: its buffer index and bytes skipped
+    Conflate,
+};
+
+inline constexpr std::string_view TraceEventName(TraceEvent event) noexcept {
+    switch (event) {
+        case TraceEvent::Publish:
+            return "publish";
+        case TraceEvent::Wrap:
+            return "wrap";
+        case TraceEvent::Grow:
+            return "grow";
+        case TraceEvent::Read:
+            return "read";
+        case TraceEvent::Overwrite:
+            return "overwrite";
+        case TraceEvent::Conflate:
+            return "conflate";
+        default:
+            return "?";
+    }
+}
+
+// POD struct for one traced event. `stamp` is the record's position in the
+// trace plus one once written, 0 while being written.
+struct TraceRecord {
+    std::atomic<uint64_t> stamp;
+    // TSC ticks
+    std::atomic<uint64_t> ticks;
+    std::atomic<uint64_t> index;
+    std::atomic<uint32_t> size;
+    std::atomic<TraceEvent> event;
+    uint16_t reserved;
+};
+
+// Number of records kept in a trace ring, the oldest being overwritten first
+static constexpr size_t TRACE_RING_CAPACITY = 64 * 1024;
+
+// POD struct for a process's trace ring in shared memory, read by `cbtrace`
+struct TraceRing {
+    alignas(CACHELINE_SIZE) std::atomic<pid_t> pid;
+    // TSC calibration, and TSC and `CLOCK_MONOTONIC` readings taken together
+    // when tracing started, for converting ticks to a timeline
+    std::atomic<double> nanosPerTick;
+    std::atomic<uint64_t> startTicks;
+    std::atomic<uint64_t> startNanos;
+    // Number of records written
+    alignas(CACHELINE_SIZE) std::atomic<uint64_t> head;
+    TraceRecord records[TRACE_RING_CAPACITY];
+};
+
+// Process-wide tracing of library events into a `TraceRing`, in Release builds
+// too: each event costs a TSC read and a few stores, and nothing at all but a
+// predictable branch while tracing is off. Tracing starts with `Start()`, or
+// when the first buffer is opened if the `CB_TRACE` environment variable names
+// the region to trace into.
+class Tracer {
+public:
+    // Starts tracing into shared memory region `name`, which outlives the
+    // process (unless stopped) so it can be decoded after the process exits.
+    // Returns false if already tracing, or the region can't be created.
+    static bool Start(std::string_view name) noexcept;
+    // Stops tracing and releases the region. Must not be called while other
+    // threads use the library.
+    static void Stop() noexcept;
+    // Starts tracing if `CB_TRACE` is set, the first time it's called
+    static void StartFromEnvironment() noexcept;
+
+    [[nodiscard]] static bool Enabled() noexcept {
+        return s_Ring.load(std::memory_order_relaxed) != nullptr;
+    }
+
+    // Records an event if tracing. Safe to call from any thread.
+    static void Record(TraceEvent event, uint64_t index,
+                       uint64_t size) noexcept {
+        TraceRing *ring = s_Ring.load(std::memory_order_acquire);
+        if (ring == nullptr) [[likely]] {
+            return;
+        }
+
+        // Claim a record and write it under its stamp, like a slot of
+        // `SlotWriter`
+        const uint64_t position =
+            ring->head.fetch_add(1, std::memory_order_relaxed);
+        TraceRecord &record = ring->records[position % TRACE_RING_CAPACITY];
+        record.stamp.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        record.ticks.store(ReadClock(ClockSource::TSC),
+                           std::memory_order_relaxed);
+        record.index.store(index, std::memory_order_relaxed);
+        record.size.store(
+            static_cast<uint32_t>(std::min<uint64_t>(size, UINT32_MAX)),
+            std::memory_order_relaxed);
+        record.event.store(event, std::memory_order_relaxed);
+        record.stamp.store(position + 1, std::memory_order_release);
+    }
+
+private:
+    static std::atomic<TraceRing *> s_Ring;
+    static SharedMemory *s_Region;
+};
+
+}  // namespace CircularBuffer
@@ -1,40 +1,160 @@
 #pragma once
 
 #include <semaphore.h>
+#include <sys/types.h>
 
+#include <condition_variable>
 #include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <type_traits>
 
 #include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/BasicRing.hpp"
 #include "circularbuffer/IWrapper.hpp"
 #include "circularbuffer/Macros.hpp"
+#include "circularbuffer/RingPolicies.hpp"
 #include "circularbuffer/SemaphoreLock.hpp"
 #include "circularbuffer/Spec.hpp"
 
 namespace CircularBuffer {
 
-class Writer : public IWrapper {
+// Writer of a `SpecHeader` ring (see `BasicRing`), framed as set in `Spec`.
+// Whether it can notify readers and publish statistics is up to the ring's
+// wait and instrumentation policies: without them, the branches compile away.
+// Instantiated in the library for `SpecRing` (`Writer`) and `LeanSpecRing`
+// (`LeanWriter`).
+template <typename Ring>
+class SpecWriter : public IWrapper {
+    static_assert(std::is_same_v<typename Ring::Header, SpecHeader> &&
+                  std::is_same_v<typename Ring::Capacity, SpecCapacity> &&
+                  !Ring::Overflow::LOSSLESS);
+
+    using Wait = typename Ring::Wait;
+    using Instrumentation = typename Ring::Instrumentation;
+
 public:
-    explicit Writer(const Spec& spec);
-    ~Writer() override;
+    explicit SpecWriter(const Spec& spec);
+    ~SpecWriter() override;
 
     // No default/copy/move construction
-    CB_EXPLICIT_DELETE_CONSTRUCTORS(Writer);
+    CB_EXPLICIT_DELETE_CONSTRUCTORS(SpecWriter);
 
     // Writes data to buffer in shared memory
     bool Write(BufferT writeBuffer);
     // Compatibility interface
     bool Write(DataT* data, size_t size) { return Write({data, size}); }
+    // Largest message `Write()` accepts, which depends on `Spec::sizeField`,
+    // and on the capacity with `Spec::contiguousRecords`
+    [[nodiscard]] MessageSizeT MaxMessageSize() const noexcept {
+        return m_MaxMessageSize;
+    }
+
+    // Moves the buffer to a new data region of `capacity` bytes, between two
+    // writes, without disturbing readers: they read the old region up to where
+    // the writer left it, then follow. Returns false if the capacity isn't
+    // bigger, exceeds `Spec::maxBufferCapacity` or isn't a multiple of the
+    // record alignment, or the region can't be allocated.
+    bool Grow(size_t capacity);
 
     static std::string MakeSemName(const Spec& spec);
 
 private:
-    void EnsureSingleton();
+    // Locks the buffer for this writer. If `takeOverDead`, takes over the lock
+    // of a writer that died holding it.
+    void EnsureSingleton(bool takeOverDead);
+    // Blocks until the current writer exits, killing it if it misses its
+    // heartbeat, then takes over its lock
+    void AwaitTakeover();
+    // Takes over the lock of dead writer `deadPid`. Returns false if another
+    // process got there first.
+    bool TakeOver(pid_t deadPid) noexcept;
+    // Starts a new stream: publishes framing and resets shared state
+    void Reset();
+    // Continues the stream published by a previous writer with the same
+    // framing. Returns false if there is none, or its last records are
+    // corrupt.
+    bool Resume() noexcept;
+    // Sets the local position and message number to the latest seek index
+    // entry, dropping torn entries
+    void LoadLatestSeekEntry() noexcept;
+    // Walks records from the local position to `readIdx`, checking headers and
+    // filling in missing seek index entries. `seqNum` is the published
+    // sequence number. Returns false if the walk doesn't land on `readIdx`.
+    bool ValidateRecords(IndexT readIdx, SeqNumT seqNum) noexcept;
+    // Throws if the spec's record alignment can't be used with this buffer
+    void ValidateAlignment(const Spec& spec);
+    // Throws if the spec enables notifications or statistics, and the ring's
+    // policies compile them out
+    void ValidateFeatures(const Spec& spec);
+    // Sets the largest message accepted for the framing and capacity
+    void UpdateMaxMessageSize() noexcept;
+    // Publishes counters to the shared statistics block
+    void UpdateStats(MessageSizeT msgSize, bool wrapped) noexcept;
+    // Moves the tail past records about to be overwritten by a write of
+    // `overwriteBytes` bytes (including any skipped space) at the write index
+    void AdvanceTail(int overwriteBytes) noexcept;
+    // Publishes the local tail under its seqlock
+    void PublishTail() noexcept;
+    // Publishes the position of the record just written under its seqlock
+    void PublishLatest(IndexT index, SeqNumT seqNum) noexcept;
+    // Records the position of the current message in the seek index
+    void UpdateSeekIndex(IndexT index, SeqNumT seqNum) noexcept;
+    // Heartbeat thread: publishes the time every `heartbeatMs` until stopped
+    void Heartbeat(size_t heartbeatMs) noexcept;
 
     // Pointer to next write location
     IterT m_NextElement;
     // Semaphore lock to ensure only a single reader ever gets instantiated
     SemaphoreLock m_SemLock;
+    // Messages at least this big are written with non-temporal stores (0 to
+    // disable)
+    const size_t m_StreamingThreshold;
+    // Largest message the size field can encode, and that fits the buffer
+    // with contiguous records
+    MessageSizeT m_MaxMessageSize{MAX_MESSAGE_SIZE};
+
+    // Statistics (only published if enabled in the spec)
+    const bool m_StatsEnabled;
+    uint64_t m_StatMessages{0};
+    uint64_t m_StatBytes{0};
+    uint64_t m_StatWraps{0};
+    uint64_t m_StatMaxMessageSize{0};
+
+    // Oldest intact record (only published if replay is enabled in the spec)
+    const bool m_ReplayEnabled;
+    IndexT m_TailIndex{0};
+    SeqNumT m_TailSeqNum{0};
+    uint64_t m_TailVersion{0};
+
+    // Newest record (only published if conflation is enabled in the spec)
+    const bool m_ConflationEnabled;
+    uint64_t m_LatestVersion{0};
+
+    // Message numbering and seek index (only if enabled in the spec)
+    const uint64_t m_SeekInterval;
+    MessageNumberT m_MessageNumber{0};
+    // Messages until the next seek index entry
+    uint64_t m_SeekCountdown{1};
+
+    // Wake readers waiting on an eventfd
+    const bool m_NotifyEnabled;
+
+    // Heartbeat thread, if enabled
+    std::thread m_HeartbeatThread;
+    std::mutex m_HeartbeatMutex;
+    std::condition_variable m_HeartbeatCv;
+    bool m_HeartbeatStop{false};
 };
 
+extern template class SpecWriter<SpecRing>;
+extern template class SpecWriter<LeanSpecRing>;
+
+// Writer with every feature available, enabled at runtime through `Spec`
+using Writer = SpecRing::Writer;
+// Writer without notifications or statistics
+using LeanWriter = LeanSpecRing::Writer;
+
 }  // namespace CircularBuffer
@@ -0,0 +1,106 @@
+#include "circularbuffer/AsyncReader.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+
+#include "circularbuffer/Reader.hpp"
+#include "circularbuffer/Spec.hpp"
+#include "spdlog/spdlog.h"
+
+namespace CircularBuffer {
+
+Task::~Task() {
+    // Never spawned
+    if (m_Handle) {
+        m_Handle.destroy();
+    }
+}
+
+Task::Handle Task::Release() noexcept {
+    Handle handle = m_Handle;
+    m_Handle = nullptr;
+    return handle;
+}
+
+Scheduler::~Scheduler() {
+    for (Task::Handle handle : m_Tasks) {
+        handle.destroy();
+    }
+}
+
+void Scheduler::Spawn(Task task) {
+    Task::Handle handle = task.Release();
+    m_Tasks.push_back(handle);
+    m_Ready.push_back(handle);
+}
+
+size_t Scheduler::Poll() {
+    // Wake coroutines whose ring has data: one cacheline per waiter. The
+    // message is read here, as `Available()` can be true with nothing to read
+    // (e.g. after the ring grew), in which case the coroutine keeps waiting.
+    for (size_t i = 0; i < m_Waiting.size();) {
+        Waiter &waiter = m_Waiting[i];
+        if (waiter.reader->Available()) {
+            *waiter.result = waiter.reader->Read(waiter.buffer);
+        }
+        if (*waiter.result != 0) {
+            m_Ready.push_back(waiter.handle);
+            m_Waiting[i] = m_Waiting.back();
+            m_Waiting.pop_back();
+        } else {
+            i++;
+        }
+    }
+
+    // Coroutines that yield while being resumed run on the next poll
+    m_Resuming.swap(m_Ready);
+    const size_t resumed = m_Resuming.size();
+    for (size_t i = 0; i < m_Resuming.size(); i++) {
+        Task::Handle handle = m_Resuming[i];
+        handle.resume();
+        if (handle.done()) {
+            try {
+                Reap(handle);
+            } catch (...) {
+                // Don't lose the rest of this poll's coroutines
+                m_Ready.insert(m_Ready.end(), m_Resuming.begin() + i + 1,
+                               m_Resuming.end());
+                m_Resuming.clear();
+                throw;
+            }
+        }
+    }
+    m_Resuming.clear();
+
+    return resumed;
+}
+
+void Scheduler::Run() {
+    m_Stopped = false;
+    while (!m_Stopped && !m_Tasks.empty()) {
+        Poll();
+    }
+}
+
+void Scheduler::Wait(Reader &reader, BufferT buffer, int *result,
+                     Task::Handle handle) {
+    m_Waiting.push_back({&reader, buffer, result, handle});
+}
+
+void Scheduler::Reap(Task::Handle handle) {
+    const std::exception_ptr exception = handle.promise().exception;
+    std::erase(m_Tasks, handle);
+    handle.destroy();
+
+    if (exception) {
+        SPDLOG_ERROR("Coroutine exited with an exception");
+        std::rethrow_exception(exception);
+    }
+}
+
+AsyncReader::AsyncReader(Scheduler &scheduler, const Spec &spec,
+                         const ReaderOptions &options)
+    : Reader(spec, options), m_Scheduler(scheduler) {}
+
+}  // namespace CircularBuffer
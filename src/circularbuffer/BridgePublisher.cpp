@@ -0,0 +1,264 @@
+#include "circularbuffer/BridgePublisher.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <format>
+#include <stdexcept>
+#include <thread>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Bridge.hpp"
+#include "circularbuffer/Macros.hpp"
+#include "circularbuffer/Reader.hpp"
+#include "circularbuffer/Spec.hpp"
+#include "circularbuffer/Utils.hpp"
+#include "spdlog/spdlog.h"
+
+namespace CircularBuffer {
+
+namespace {
+
+// How long to wait for a connecting subscriber's hello, before and while
+// receiving it
+constexpr int HELLO_TIMEOUT_MS = 1000;
+constexpr timeval HELLO_TIMEOUT{HELLO_TIMEOUT_MS / 1000,
+                                HELLO_TIMEOUT_MS % 1000 * 1000};
+// Bounds how long a stopping publisher can be blocked accepting or sending
+constexpr int POLL_TIMEOUT_MS = 100;
+constexpr timeval SEND_TIMEOUT{0, POLL_TIMEOUT_MS * 1000};
+
+}  // namespace
+
+BridgePublisher::BridgePublisher(const Spec &spec, uint16_t port,
+                                 const BridgePublisherOptions &options)
+    : m_Spec(spec), m_BatchBytes(options.batchBytes) {
+    SetupSpdlog();
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, options.address.c_str(), &addr.sin_addr) != 1) {
+        CB_CONSTEXPR_SV fmt = "({}:{}) Invalid listen address \"{}\"";
+        SPDLOG_ERROR(fmt.substr(8), options.address);
+        throw std::invalid_argument(
+            std::format(fmt, __FILE__, __LINE__, options.address));
+    }
+
+    // Resuming relies on message numbers
+    m_Reader = new Reader(spec);
+    if (!m_Reader->MessageNumbers()) {
+        delete m_Reader;
+        CB_CONSTEXPR_SV fmt =
+            "({}:{}) Bridge requires the writer to number messages "
+            "(Spec::seekInterval)";
+        SPDLOG_ERROR(fmt.substr(8));
+        throw std::logic_error(std::format(fmt, __FILE__, __LINE__));
+    }
+
+    // Non-blocking, so that accepting never blocks the publisher thread
+    m_ListenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    const int reuse = 1;
+    socklen_t addrLen = sizeof(addr);
+    if (m_ListenFd == -1 ||
+        setsockopt(m_ListenFd, SOL_SOCKET, SO_REUSEADDR, &reuse,
+                   sizeof(reuse)) == -1 ||
+        bind(m_ListenFd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) ==
+            -1 ||
+        listen(m_ListenFd, 1) == -1 ||
+        getsockname(m_ListenFd, reinterpret_cast<sockaddr *>(&addr),
+                    &addrLen) == -1) {
+        const int err = errno;
+        if (m_ListenFd != -1) {
+            close(m_ListenFd);
+        }
+        delete m_Reader;
+        CB_CONSTEXPR_SV fmt = "({}:{}) Failed to listen on {}:{}: {}";
+        SPDLOG_ERROR(fmt.substr(8), options.address, port, strerror(err));
+        throw std::runtime_error(std::format(fmt, __FILE__, __LINE__,
+                                             options.address, port,
+                                             strerror(err)));
+    }
+    m_Port = ntohs(addr.sin_port);
+
+    // Room for a full batch plus one largest frame
+    m_Batch = new DataT[m_BatchBytes + BRIDGE_FRAME_HEADER_SIZE +
+                        MAX_MESSAGE_SIZE];
+
+    SPDLOG_INFO("Bridge publisher listening on {}:{}", options.address, m_Port);
+    m_Thread = std::thread(&BridgePublisher::Run, this);
+}
+
+BridgePublisher::~BridgePublisher() {
+    m_Running.store(false, std::memory_order_relaxed);
+    m_Thread.join();
+
+    Disconnect();
+    close(m_ListenFd);
+    delete[] m_Batch;
+    delete m_Reader;
+}
+
+void BridgePublisher::Run() noexcept {
+    while (m_Running.load(std::memory_order_relaxed)) {
+        // Lost the reader: try again shortly
+        if (m_Reader == nullptr && !Reopen()) {
+            std::this_thread::sleep_for(
+                std::chrono::milliseconds(POLL_TIMEOUT_MS));
+            continue;
+        }
+
+        // Nothing to do until a subscriber connects
+        if (m_Fd == -1) {
+            Accept();
+            continue;
+        }
+
+        DataT *frame = m_Batch + m_BatchSize;
+        const int ret =
+            m_Reader->Read({frame + BRIDGE_FRAME_HEADER_SIZE,
+                            static_cast<size_t>(MAX_MESSAGE_SIZE)});
+
+        // Append a frame, sending once the batch is full
+        if (ret > 0) [[likely]] {
+            const BridgeFrameHeader header{static_cast<uint32_t>(ret), 0,
+                                           m_Reader->LastMessageNumber()};
+            std::memcpy(frame, &header, BRIDGE_FRAME_HEADER_SIZE);
+            m_BatchSize += BRIDGE_FRAME_HEADER_SIZE + ret;
+            m_Next = header.messageNumber + 1;
+            m_BatchMessages++;
+            if (m_BatchSize >= m_BatchBytes) {
+                Flush();
+            }
+            continue;
+        }
+
+        // Ring drained: send what we have, or check for a new subscriber
+        if (ret == 0) {
+            if (m_BatchSize != 0) {
+                Flush();
+            } else {
+                Accept();
+                std::this_thread::yield();
+            }
+            continue;
+        }
+
+        // Overwritten: skip to the latest message. The subscriber sees the
+        // gap in message numbers.
+        SPDLOG_CRITICAL("Bridge publisher lost messages after {}: skipping "
+                        "to the latest message",
+                        m_Next);
+        delete m_Reader;
+        m_Reader = nullptr;
+        m_Next = INVALID_MESSAGE_NUMBER;
+        Reopen();
+    }
+}
+
+bool BridgePublisher::Reopen() noexcept {
+    try {
+        m_Reader = new Reader(m_Spec);
+    } catch (const std::exception &e) {
+        SPDLOG_ERROR("Bridge publisher failed to reopen reader: {}", e.what());
+        return false;
+    }
+    return true;
+}
+
+void BridgePublisher::Accept() noexcept {
+    pollfd listenPoll{m_ListenFd, POLLIN, 0};
+    if (poll(&listenPoll, 1, m_Fd == -1 ? POLL_TIMEOUT_MS : 0) <= 0) {
+        return;
+    }
+    const int fd = accept4(m_ListenFd, nullptr, nullptr, SOCK_CLOEXEC);
+    if (fd == -1) {
+        return;
+    }
+
+    // Wait for the subscriber to say where to resume. The socket blocks, so
+    // bound the receive too in case the hello arrives in parts.
+    BridgeHello hello;
+    pollfd helloPoll{fd, POLLIN, 0};
+    if (setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &HELLO_TIMEOUT,
+                   sizeof(HELLO_TIMEOUT)) == -1 ||
+        poll(&helloPoll, 1, HELLO_TIMEOUT_MS) <= 0 ||
+        recv(fd, &hello, sizeof(hello), MSG_WAITALL) != sizeof(hello)) {
+        SPDLOG_WARN("Bridge subscriber sent no hello: dropping connection");
+        close(fd);
+        return;
+    }
+
+    // Small batches go out immediately, and sends can't block forever
+    const int noDelay = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &SEND_TIMEOUT,
+               sizeof(SEND_TIMEOUT));
+
+    // Newest subscriber wins. Unsent frames are resent if it resumes.
+    Disconnect();
+    m_Fd = fd;
+    m_BatchSize = 0;
+    m_BatchMessages = 0;
+    m_Connections.fetch_add(1, std::memory_order_relaxed);
+
+    if (hello.next == INVALID_MESSAGE_NUMBER || hello.next == m_Next) {
+        SPDLOG_INFO("Bridge subscriber connected");
+    } else if (m_Reader->Seek(hello.next)) {
+        m_Next = hello.next;
+        SPDLOG_INFO("Bridge subscriber resumed at message {}", hello.next);
+    } else {
+        SPDLOG_WARN("Bridge subscriber can't resume at message {}: no longer "
+                    "in the ring",
+                    hello.next);
+    }
+}
+
+void BridgePublisher::Flush() noexcept {
+    size_t sent = 0;
+    while (sent < m_BatchSize) {
+        const ssize_t ret =
+            send(m_Fd, m_Batch + sent, m_BatchSize - sent, MSG_NOSIGNAL);
+        if (ret > 0) [[likely]] {
+            sent += ret;
+            continue;
+        }
+
+        // Timed out: keep trying unless stopping
+        if (ret == -1 && (errno == EAGAIN || errno == EINTR) &&
+            m_Running.load(std::memory_order_relaxed)) {
+            continue;
+        }
+
+        SPDLOG_WARN("Bridge subscriber disconnected: {}", strerror(errno));
+        Disconnect();
+        break;
+    }
+
+    if (sent == m_BatchSize) [[likely]] {
+        m_Sent.fetch_add(m_BatchMessages, std::memory_order_relaxed);
+    }
+    m_BatchSize = 0;
+    m_BatchMessages = 0;
+}
+
+void BridgePublisher::Disconnect() noexcept {
+    if (m_Fd != -1) {
+        close(m_Fd);
+        m_Fd = -1;
+    }
+}
+
+}  // namespace CircularBuffer
@@ -0,0 +1,193 @@
+#include "circularbuffer/BridgeSubscriber.hpp"
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Bridge.hpp"
+#include "circularbuffer/Spec.hpp"
+#include "circularbuffer/Utils.hpp"
+#include "circularbuffer/Writer.hpp"
+#include "spdlog/spdlog.h"
+
+namespace CircularBuffer {
+
+namespace {
+
+// Bounds how long a stopping subscriber can be blocked connecting or receiving
+constexpr timeval SOCKET_TIMEOUT{0, 100'000};
+constexpr int SLEEP_SLICE_MS = 10;
+
+}  // namespace
+
+BridgeSubscriber::BridgeSubscriber(const Spec &spec, std::string host,
+                                   uint16_t port,
+                                   const BridgeSubscriberOptions &options)
+    : m_Writer(spec),
+      m_Host(std::move(host)),
+      m_Port(port),
+      m_Options(options),
+      // Must hold at least one largest frame
+      m_BufferSize(std::max(options.receiveBytes,
+                            2 * static_cast<size_t>(BRIDGE_FRAME_HEADER_SIZE +
+                                                    MAX_MESSAGE_SIZE))) {
+    SetupSpdlog();
+
+    m_Buffer = new DataT[m_BufferSize];
+    m_Thread = std::thread(&BridgeSubscriber::Run, this);
+}
+
+BridgeSubscriber::~BridgeSubscriber() {
+    m_Running.store(false, std::memory_order_relaxed);
+    m_Thread.join();
+
+    delete[] m_Buffer;
+}
+
+void BridgeSubscriber::Run() noexcept {
+    while (m_Running.load(std::memory_order_relaxed)) {
+        if (Connect()) {
+            Receive();
+            close(m_Fd);
+            m_Fd = -1;
+        }
+
+        // Wait before reconnecting, in slices so stopping isn't delayed
+        for (int waited = 0; waited < m_Options.reconnectDelayMs &&
+                             m_Running.load(std::memory_order_relaxed);
+             waited += SLEEP_SLICE_MS) {
+            std::this_thread::sleep_for(
+                std::chrono::milliseconds(SLEEP_SLICE_MS));
+        }
+    }
+}
+
+bool BridgeSubscriber::Connect() noexcept {
+    addrinfo hints{};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo *result = nullptr;
+    const int err =
+        getaddrinfo(m_Host.c_str(), std::to_string(m_Port).c_str(), &hints,
+                    &result);
+    if (err != 0) {
+        SPDLOG_WARN("Failed to resolve bridge publisher {}: {}", m_Host,
+                    gai_strerror(err));
+        return false;
+    }
+
+    // Timeouts also bound connect()
+    m_Fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    const int noDelay = 1;
+    const BridgeHello hello{m_Next};
+    const bool connected =
+        m_Fd != -1 &&
+        setsockopt(m_Fd, SOL_SOCKET, SO_SNDTIMEO, &SOCKET_TIMEOUT,
+                   sizeof(SOCKET_TIMEOUT)) == 0 &&
+        setsockopt(m_Fd, SOL_SOCKET, SO_RCVTIMEO, &SOCKET_TIMEOUT,
+                   sizeof(SOCKET_TIMEOUT)) == 0 &&
+        setsockopt(m_Fd, IPPROTO_TCP, TCP_NODELAY, &noDelay,
+                   sizeof(noDelay)) == 0 &&
+        connect(m_Fd, result->ai_addr, result->ai_addrlen) == 0 &&
+        send(m_Fd, &hello, sizeof(hello), MSG_NOSIGNAL) == sizeof(hello);
+    freeaddrinfo(result);
+
+    if (!connected) {
+        SPDLOG_DEBUG("Failed to connect to bridge publisher {}:{}: {}", m_Host,
+                     m_Port, strerror(errno));
+        if (m_Fd != -1) {
+            close(m_Fd);
+            m_Fd = -1;
+        }
+        return false;
+    }
+
+    m_Connections.fetch_add(1, std::memory_order_relaxed);
+    SPDLOG_INFO("Connected to bridge publisher {}:{}, resuming at message {}",
+                m_Host, m_Port, m_Next);
+    return true;
+}
+
+void BridgeSubscriber::Receive() noexcept {
+    size_t used = 0;
+
+    while (m_Running.load(std::memory_order_relaxed)) {
+        const ssize_t ret = recv(m_Fd, m_Buffer + used, m_BufferSize - used, 0);
+        if (ret <= 0) {
+            // Timed out: keep waiting unless stopping
+            if (ret == -1 && (errno == EAGAIN || errno == EINTR)) {
+                continue;
+            }
+            SPDLOG_WARN("Disconnected from bridge publisher {}:{}", m_Host,
+                        m_Port);
+            return;
+        }
+        used += ret;
+
+        // Deliver every complete frame
+        size_t offset = 0;
+        while (used - offset >= BRIDGE_FRAME_HEADER_SIZE) {
+            BridgeFrameHeader header;
+            std::memcpy(&header, m_Buffer + offset, BRIDGE_FRAME_HEADER_SIZE);
+            if (header.size > static_cast<uint32_t>(MAX_MESSAGE_SIZE))
+                [[unlikely]] {
+                SPDLOG_CRITICAL("Bridge frame error: message size {} is "
+                                "invalid, disconnecting",
+                                header.size);
+                return;
+            }
+            if (used - offset < BRIDGE_FRAME_HEADER_SIZE + header.size) {
+                break;
+            }
+
+            Deliver(header, m_Buffer + offset + BRIDGE_FRAME_HEADER_SIZE);
+            offset += BRIDGE_FRAME_HEADER_SIZE + header.size;
+        }
+
+        // Keep the partial frame
+        std::memmove(m_Buffer, m_Buffer + offset, used - offset);
+        used -= offset;
+    }
+}
+
+void BridgeSubscriber::Deliver(const BridgeFrameHeader &header,
+                               DataT *data) noexcept {
+    const MessageNumberT number = header.messageNumber;
+    if (m_Next != INVALID_MESSAGE_NUMBER) {
+        // Already delivered before reconnecting
+        if (number < m_Next) [[unlikely]] {
+            return;
+        }
+        if (number > m_Next) [[unlikely]] {
+            SPDLOG_WARN("Bridge gap: missed messages {} to {}", m_Next,
+                        number - 1);
+            m_Missed.fetch_add(number - m_Next, std::memory_order_relaxed);
+        }
+    }
+
+    // A rejected message can't be retried without holding up the stream
+    m_Next = number + 1;
+    if (!m_Writer.Write(data, header.size)) [[unlikely]] {
+        SPDLOG_ERROR("Failed to write bridged message {} of {} B: dropped",
+                     number, header.size);
+        m_Dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    m_Received.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace CircularBuffer
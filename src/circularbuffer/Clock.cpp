@@ -0,0 +1,31 @@
+#include "circularbuffer/Clock.hpp"
+
+#include <cstdint>
+
+#include "spdlog/spdlog.h"
+
+namespace CircularBuffer {
+
+double CalibrateTsc() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    static constexpr uint64_t CALIBRATION_NANOS = 10'000'000;  // 10 ms
+
+    const uint64_t nanosStart = MonotonicNanos();
+    const uint64_t ticksStart = __rdtsc();
+
+    uint64_t nanosEnd;
+    do {
+        nanosEnd = MonotonicNanos();
+    } while (nanosEnd - nanosStart < CALIBRATION_NANOS);
+    const uint64_t ticksEnd = __rdtsc();
+
+    const double nanosPerTick = static_cast<double>(nanosEnd - nanosStart) /
+                                static_cast<double>(ticksEnd - ticksStart);
+    SPDLOG_DEBUG("Calibrated TSC: {} ns per tick", nanosPerTick);
+    return nanosPerTick;
+#else
+    return 1.0;
+#endif
+}
+
+}  // namespace CircularBuffer
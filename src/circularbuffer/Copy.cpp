@@ -0,0 +1,107 @@
+#include "circularbuffer/Copy.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace CircularBuffer {
+
+#if defined(__x86_64__) || defined(__i386__)
+namespace {
+
+// Copies the unaligned head with a regular copy so that the rest of the
+// destination is aligned to `Align` bytes. Returns the number of bytes copied.
+template <size_t Align>
+size_t CopyHead(char *dst, const char *src, size_t size) noexcept {
+    const size_t misalignment = reinterpret_cast<uintptr_t>(dst) % Align;
+    size_t head = misalignment == 0 ? 0 : Align - misalignment;
+    if (head > size) {
+        head = size;
+    }
+    std::memcpy(dst, src, head);
+    return head;
+}
+
+void StreamingCopySSE2(void *dst, const void *src, size_t size) noexcept {
+    static constexpr size_t WIDTH = sizeof(__m128i);
+
+    auto *d = static_cast<char *>(dst);
+    const auto *s = static_cast<const char *>(src);
+    const size_t head = CopyHead<WIDTH>(d, s, size);
+    d += head;
+    s += head;
+    size -= head;
+
+    for (; size >= WIDTH; size -= WIDTH, d += WIDTH, s += WIDTH) {
+        _mm_stream_si128(reinterpret_cast<__m128i *>(d),
+                         _mm_loadu_si128(reinterpret_cast<const __m128i *>(s)));
+    }
+    std::memcpy(d, s, size);
+}
+
+__attribute__((target("avx2"))) void StreamingCopyAVX2(void *dst,
+                                                        const void *src,
+                                                        size_t size) noexcept {
+    static constexpr size_t WIDTH = sizeof(__m256i);
+
+    auto *d = static_cast<char *>(dst);
+    const auto *s = static_cast<const char *>(src);
+    const size_t head = CopyHead<WIDTH>(d, s, size);
+    d += head;
+    s += head;
+    size -= head;
+
+    for (; size >= WIDTH; size -= WIDTH, d += WIDTH, s += WIDTH) {
+        _mm256_stream_si256(
+            reinterpret_cast<__m256i *>(d),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s)));
+    }
+    std::memcpy(d, s, size);
+}
+
+__attribute__((target("avx512f"))) void StreamingCopyAVX512(
+    void *dst, const void *src, size_t size) noexcept {
+    static constexpr size_t WIDTH = sizeof(__m512i);
+
+    auto *d = static_cast<char *>(dst);
+    const auto *s = static_cast<const char *>(src);
+    const size_t head = CopyHead<WIDTH>(d, s, size);
+    d += head;
+    s += head;
+    size -= head;
+
+    for (; size >= WIDTH; size -= WIDTH, d += WIDTH, s += WIDTH) {
+        _mm512_stream_si512(reinterpret_cast<__m512i *>(d),
+                            _mm512_loadu_si512(s));
+    }
+    std::memcpy(d, s, size);
+}
+
+using CopyFn = void (*)(void *, const void *, size_t) noexcept;
+
+CopyFn SelectStreamingCopy() noexcept {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return StreamingCopyAVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return StreamingCopyAVX2;
+    }
+    return StreamingCopySSE2;
+}
+
+// Resolved once at load time
+const CopyFn g_StreamingCopy = SelectStreamingCopy();
+
+}  // namespace
+
+void StreamingCopy(void *dst, const void *src, size_t size) noexcept {
+    g_StreamingCopy(dst, src, size);
+}
+#else
+void StreamingCopy(void *dst, const void *src, size_t size) noexcept {
+    std::memcpy(dst, src, size);
+}
+#endif
+
+}  // namespace CircularBuffer
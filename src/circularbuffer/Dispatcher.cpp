@@ -0,0 +1,141 @@
+#include "circularbuffer/Dispatcher.hpp"
+
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Macros.hpp"
+#include "circularbuffer/Reader.hpp"
+#include "circularbuffer/Spec.hpp"
+#include "circularbuffer/SpscQueue.hpp"
+#include "spdlog/spdlog.h"
+
+namespace CircularBuffer {
+
+Dispatcher::Dispatcher(const Spec &spec, KeyExtractor keyExtractor,
+                       Handler handler, const DispatcherOptions &options,
+                       const ReaderOptions &readerOptions)
+    : m_Reader(spec, readerOptions),
+      m_KeyExtractor(std::move(keyExtractor)),
+      m_Handler(std::move(handler)) {
+    if (options.workers < 1) {
+        CB_CONSTEXPR_SV fmt =
+            "({}:{}) Dispatcher needs at least one worker, got {}";
+        SPDLOG_ERROR(fmt.substr(8), options.workers);
+        throw std::invalid_argument(
+            std::format(fmt, __FILE__, __LINE__, options.workers));
+    }
+
+    m_Workers.reserve(options.workers);
+    for (int i = 0; i < options.workers; i++) {
+        m_Workers.push_back(std::make_unique<Worker>(options.queueCapacity));
+    }
+}
+
+Dispatcher::~Dispatcher() { Stop(); }
+
+void Dispatcher::Start() {
+    if (m_Thread.joinable()) {
+        return;
+    }
+
+    m_Working.store(true, std::memory_order_release);
+    m_Dispatching.store(true, std::memory_order_release);
+    for (size_t i = 0; i < m_Workers.size(); i++) {
+        m_Workers[i]->thread = std::thread(&Dispatcher::Work, this, i);
+    }
+    m_Thread = std::thread(&Dispatcher::Dispatch, this);
+}
+
+void Dispatcher::Stop() {
+    if (!m_Thread.joinable()) {
+        return;
+    }
+
+    // Stop dispatching first so workers see every message dispatched
+    m_Dispatching.store(false, std::memory_order_release);
+    m_Thread.join();
+
+    m_Working.store(false, std::memory_order_release);
+    for (const std::unique_ptr<Worker> &worker : m_Workers) {
+        worker->thread.join();
+    }
+}
+
+uint64_t Dispatcher::Handled() const noexcept {
+    uint64_t handled = 0;
+    for (const std::unique_ptr<Worker> &worker : m_Workers) {
+        handled += worker->handled.load(std::memory_order_acquire);
+    }
+    return handled;
+}
+
+void Dispatcher::Dispatch() noexcept {
+    DataT *buffer = new DataT[MAX_MESSAGE_SIZE];
+    const BufferT readBuffer(buffer, MAX_MESSAGE_SIZE);
+    const uint64_t numWorkers = m_Workers.size();
+    uint64_t dispatched = 0;
+
+    while (m_Dispatching.load(std::memory_order_acquire)) {
+        const int ret = m_Reader.Read(readBuffer);
+        if (ret == 0) {
+            continue;
+        }
+        if (ret < 0) [[unlikely]] {
+            SPDLOG_CRITICAL("Dispatcher read failed ({}): stopping dispatch",
+                            ret);
+            m_Overwritten.store(ret == INT_MIN, std::memory_order_release);
+            break;
+        }
+
+        // Same key, same worker: preserves per-key ordering
+        const std::span<const DataT> message(buffer, ret);
+        Worker &worker = *m_Workers[m_KeyExtractor(message) % numWorkers];
+
+        // Back-pressure: wait for the worker to make room, unless stopping
+        bool pushed;
+        while (!(pushed = worker.queue.TryPush(message)) &&
+               m_Dispatching.load(std::memory_order_relaxed)) {
+            std::this_thread::yield();
+        }
+        if (pushed) [[likely]] {
+            m_Dispatched.store(++dispatched, std::memory_order_release);
+        }
+    }
+
+    delete[] buffer;
+}
+
+void Dispatcher::Work(int index) noexcept {
+    Worker &worker = *m_Workers[index];
+    uint64_t handled = 0;
+    std::span<const DataT> message;
+
+    for (;;) {
+        if (worker.queue.Front(message)) {
+            m_Handler(message, index);
+            worker.queue.Pop();
+            worker.handled.store(++handled, std::memory_order_release);
+            continue;
+        }
+
+        // Only exit once the dispatcher has stopped and the queue is drained
+        if (!m_Working.load(std::memory_order_acquire)) {
+            if (!worker.queue.Front(message)) {
+                break;
+            }
+            continue;
+        }
+        std::this_thread::yield();
+    }
+}
+
+}  // namespace CircularBuffer
@@ -0,0 +1,150 @@
+#include "circularbuffer/EventBridge.hpp"
+
+#include <linux/futex.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <format>
+#include <stdexcept>
+#include <thread>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Macros.hpp"
+#include "circularbuffer/State.hpp"
+#include "circularbuffer/Utils.hpp"
+#include "spdlog/spdlog.h"
+
+namespace CircularBuffer {
+
+namespace {
+
+constexpr uint64_t ARMED = 1ULL << 32;
+constexpr uint64_t STOPPED = 1ULL << 33;
+
+// Bounds how long a stopping bridge thread can miss its wake-up
+constexpr timespec FUTEX_TIMEOUT{0, 100'000'000};
+
+// Futex words live in shared memory, so no FUTEX_PRIVATE_FLAG
+inline uint32_t *FutexWord(std::atomic<uint32_t> &word) noexcept {
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+    return reinterpret_cast<uint32_t *>(&word);
+}
+
+inline void FutexWait(std::atomic<uint32_t> &word, uint32_t expected) noexcept {
+    syscall(SYS_futex, FutexWord(word), FUTEX_WAIT, expected, &FUTEX_TIMEOUT,
+            nullptr, 0);
+}
+
+inline void FutexWake(std::atomic<uint32_t> &word) noexcept {
+    syscall(SYS_futex, FutexWord(word), FUTEX_WAKE, INT_MAX, nullptr, nullptr,
+            0);
+}
+
+}  // namespace
+
+EventBridge::EventBridge(Notification &notification)
+    : m_Notification(notification) {
+    SetupSpdlog();
+
+    m_Fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_Fd == -1) {
+        const int err = errno;
+        CB_CONSTEXPR_SV fmt = "({}:{}) Failed to create eventfd: {}";
+        SPDLOG_ERROR(fmt.substr(8), strerror(err));
+        throw std::runtime_error(
+            std::format(fmt, __FILE__, __LINE__, strerror(err)));
+    }
+
+    m_Thread = std::thread(&EventBridge::Run, this);
+}
+
+EventBridge::~EventBridge() {
+    // Stop the thread, giving up our place among the armed readers
+    const uint64_t state = m_Arming.exchange(STOPPED, std::memory_order_acq_rel);
+    if ((state & ARMED) != 0) {
+        m_Notification.armed.fetch_sub(1, std::memory_order_relaxed);
+    }
+    m_Arming.notify_one();
+    // Spurious for other readers' threads, which just wait again
+    FutexWake(m_Notification.sequence);
+    m_Thread.join();
+
+    close(m_Fd);
+}
+
+bool EventBridge::Arm(const State &state, IndexT localIndex,
+                      uint64_t generation) noexcept {
+    // Still armed from last time
+    if ((m_Arming.load(std::memory_order_acquire) & ARMED) != 0) {
+        return true;
+    }
+
+    // Clear the last notification
+    eventfd_t value;
+    eventfd_read(m_Fd, &value);
+
+    // Register as waiting, then check for data. Pairs with the fence in
+    // `Signal()`: either we see the writer's new read index, or the writer
+    // sees us armed and bumps the sequence we're about to wait on.
+    const uint32_t sequence =
+        m_Notification.sequence.load(std::memory_order_acquire);
+    m_Notification.armed.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (state.readIdx.load(std::memory_order_relaxed) != localIndex ||
+        state.readGeneration.load(std::memory_order_relaxed) != generation) {
+        m_Notification.armed.fetch_sub(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    m_Arming.store(ARMED | sequence, std::memory_order_release);
+    m_Arming.notify_one();
+    return true;
+}
+
+void EventBridge::Signal(Notification &notification) noexcept {
+    // Order the read index store before the armed check (see `Arm()`)
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (notification.armed.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+
+    notification.sequence.fetch_add(1, std::memory_order_release);
+    FutexWake(notification.sequence);
+}
+
+void EventBridge::Run() noexcept {
+    for (;;) {
+        uint64_t state = m_Arming.load(std::memory_order_acquire);
+        if ((state & STOPPED) != 0) {
+            return;
+        }
+        if ((state & ARMED) == 0) {
+            m_Arming.wait(state, std::memory_order_acquire);
+            continue;
+        }
+
+        // Sleep until the writer bumps the sequence
+        const uint32_t sequence = static_cast<uint32_t>(state);
+        if (m_Notification.sequence.load(std::memory_order_acquire) ==
+            sequence) {
+            FutexWait(m_Notification.sequence, sequence);
+            continue;
+        }
+
+        // Disarm and notify, unless we're being stopped
+        if (m_Arming.compare_exchange_strong(state, 0,
+                                             std::memory_order_acq_rel)) {
+            m_Notification.armed.fetch_sub(1, std::memory_order_relaxed);
+            eventfd_write(m_Fd, 1);
+        }
+    }
+}
+
+}  // namespace CircularBuffer
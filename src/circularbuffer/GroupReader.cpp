@@ -0,0 +1,145 @@
+#include "circularbuffer/GroupReader.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <climits>
+#include <cstdint>
+#include <format>
+#include <stdexcept>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Macros.hpp"
+#include "circularbuffer/Reader.hpp"
+#include "circularbuffer/SeekIndex.hpp"
+#include "circularbuffer/Spec.hpp"
+#include "circularbuffer/State.hpp"
+#include "spdlog/spdlog.h"
+
+namespace CircularBuffer {
+
+namespace {
+
+// Validates the group before any member is initialized with it
+int CheckGroup(int group) {
+    if (group < 0 || group >= MAX_CONSUMER_GROUPS) {
+        CB_CONSTEXPR_SV fmt =
+            "({}:{}) Consumer group {} is invalid: must be in [0, {})";
+        SPDLOG_ERROR(fmt.substr(8), group, MAX_CONSUMER_GROUPS);
+        throw std::invalid_argument(std::format(fmt, __FILE__, __LINE__,
+                                                group, MAX_CONSUMER_GROUPS));
+    }
+    return group;
+}
+
+}  // namespace
+
+GroupReader::GroupReader(const Spec &spec, int group, uint64_t claimBatch,
+                         const ReaderOptions &options)
+    : Reader(spec, options),
+      m_Group(m_State->groups[CheckGroup(group)]),
+      m_ClaimBatch(claimBatch) {
+    if (m_ClaimBatch == 0) {
+        CB_CONSTEXPR_SV fmt = "({}:{}) Claim batch must be at least 1";
+        SPDLOG_ERROR(fmt.substr(8));
+        throw std::invalid_argument(std::format(fmt, __FILE__, __LINE__));
+    }
+
+    // Claims are message numbers, located through the seek index
+    if (!m_MessageNumbers) {
+        CB_CONSTEXPR_SV fmt =
+            "({}:{}) Consumer groups require the writer to number messages "
+            "(Spec::seekInterval)";
+        SPDLOG_ERROR(fmt.substr(8));
+        throw std::logic_error(std::format(fmt, __FILE__, __LINE__));
+    }
+}
+
+int GroupReader::Read(BufferT readBuffer) {
+    // Claim the next batch. Batches are contiguous for a lone member, which
+    // can then keep reading sequentially.
+    if (m_Next == m_ClaimEnd) {
+        const MessageNumberT first =
+            m_Group.cursor.fetch_add(m_ClaimBatch, std::memory_order_relaxed);
+        if (first != m_Next) {
+            m_Positioned = false;
+        }
+        m_Next = first;
+        m_ClaimEnd = first + m_ClaimBatch;
+    }
+
+    if (!m_Positioned) {
+        IndexT index;
+        SeqNumT seqNum;
+        switch (Locate(m_Next, index, seqNum)) {
+            case LocateResult::Found:
+                m_LocalIndex = index;
+                m_LocalSeqNum = seqNum;
+                m_Overwritten = false;
+                m_Positioned = true;
+                break;
+            case LocateResult::NotWritten:
+                return 0;
+            case LocateResult::Lost:
+            case LocateResult::Disabled:
+                SPDLOG_CRITICAL("Claimed message {} was overwritten", m_Next);
+                RecordOverwrite();
+                SkipLost();
+                return INT_MIN;
+        }
+    }
+
+    const int ret = Reader::Read(readBuffer);
+    if (ret > 0) [[likely]] {
+#ifdef DEBUG
+        assert(LastMessageNumber() == m_Next);
+#endif
+        m_Next++;
+    } else if (ret == INT_MIN) [[unlikely]] {
+        SkipLost();
+    }
+    return ret;
+}
+
+void GroupReader::SkipLost() noexcept {
+    m_Next = m_ClaimEnd;
+    m_Positioned = false;
+
+    // Resume at the oldest indexed message still intact, or else at the next
+    // message to be indexed
+    const SeekIndex &seekIndex = m_State->seekIndex;
+    const uint64_t interval = seekIndex.interval.load(std::memory_order_acquire);
+    const SeqNumT writerSeqNum = m_State->seqNum.load(std::memory_order_acquire);
+    const SeqNumT baseSeqNum =
+        m_State->region.baseSeqNum.load(std::memory_order_acquire);
+    MessageNumberT oldest = INVALID_MESSAGE_NUMBER;
+    MessageNumberT latest = 0;
+    for (const SeekEntry &entry : seekIndex.entries) {
+        MessageNumberT number;
+        IndexT index;
+        SeqNumT seqNum;
+        LoadSeekEntry(entry, number, index, seqNum);
+        if (number == INVALID_MESSAGE_NUMBER) {
+            continue;
+        }
+        // Entries in data regions the writer has grown out of are lost too
+        if (writerSeqNum - seqNum <= m_CircularBuffer.size_bytes() &&
+            seqNum >= baseSeqNum && number < oldest) {
+            oldest = number;
+        }
+        if (number > latest) {
+            latest = number;
+        }
+    }
+    const MessageNumberT resume =
+        oldest != INVALID_MESSAGE_NUMBER ? oldest : latest + interval;
+
+    // Only ever move the cursor forwards
+    MessageNumberT cursor = m_Group.cursor.load(std::memory_order_relaxed);
+    while (cursor < resume &&
+           !m_Group.cursor.compare_exchange_weak(cursor, resume,
+                                                 std::memory_order_relaxed)) {
+    }
+    SPDLOG_DEBUG("Group skipped to message {}", resume);
+}
+
+}  // namespace CircularBuffer
@@ -1,25 +1,38 @@
 #include "circularbuffer/IWrapper.hpp"
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <format>
 #include <stdexcept>
+#include <string>
 
 #include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Clock.hpp"
 #include "circularbuffer/Macros.hpp"
 #include "circularbuffer/SharedMemory.hpp"
+#include "circularbuffer/SizeField.hpp"
 #include "circularbuffer/Spec.hpp"
 #include "circularbuffer/State.hpp"
+#include "circularbuffer/Trace.hpp"
 #include "circularbuffer/Utils.hpp"
 #include "spdlog/spdlog.h"
 
 namespace CircularBuffer {
 
-IWrapper::IWrapper(const Spec &spec) : m_LocalIndex(0), m_LocalSeqNum(0) {
+IWrapper::IWrapper(const Spec &spec)
+    : m_CapacityLimit(spec.maxBufferCapacity != 0
+                          ? spec.maxBufferCapacity
+                          : SharedMemory::MAX_SIZE_BYTES),
+      m_LocalIndex(0),
+      m_LocalSeqNum(0),
+      m_DataName(spec.dataSharedMemoryName),
+      m_HugePages(spec.hugePages) {
     SetupSpdlog();
+    Tracer::StartFromEnvironment();
 
     // Load/map shared memory regions
     m_StateRegion = new SharedMemory(spec.indexSharedMemoryName, sizeof(State));
-    m_DataRegion =
-        new SharedMemory(spec.dataSharedMemoryName, spec.bufferCapacity);
 
     // Reinterpret state region as struct and verify
     m_State = m_StateRegion->AsStruct<State>();
@@ -31,15 +44,90 @@ IWrapper::IWrapper(const Spec &spec) : m_LocalIndex(0), m_LocalSeqNum(0) {
         throw std::runtime_error(std::format(fmt, __FILE__, __LINE__));
     }
 
+    // Map the data region the writer is using, which is bigger than the spec
+    // says if it has grown the buffer
+    uint64_t generation;
+    size_t capacity;
+    SeqNumT baseSeqNum;
+    MessageNumberT baseMessageNumber;
+    LoadDataRegion(generation, capacity, baseSeqNum, baseMessageNumber);
+    ReplaceDataRegion(generation,
+                      generation == 0 ? spec.bufferCapacity : capacity, false);
+}
+
+void IWrapper::LoadDataRegion(uint64_t &generation, size_t &capacity,
+                              SeqNumT &baseSeqNum,
+                              MessageNumberT &baseMessageNumber) const noexcept {
+    // Retry until the generation is the same before and after
+    const DataRegion &region = m_State->region;
+    for (;;) {
+        generation = region.generation.load(std::memory_order_acquire);
+        capacity = region.capacity.load(std::memory_order_relaxed);
+        baseSeqNum = region.baseSeqNum.load(std::memory_order_relaxed);
+        baseMessageNumber =
+            region.baseMessageNumber.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (region.generation.load(std::memory_order_relaxed) == generation) {
+            return;
+        }
+    }
+}
+
+SharedMemory *IWrapper::ReplaceDataRegion(uint64_t generation,
+                                          size_t capacity, bool existing) {
+    const std::string name =
+        generation == 0 ? m_DataName
+                        : std::format("{}.{}", m_DataName, generation);
+    SharedMemory *region =
+        new SharedMemory(name, capacity, false, m_CapacityLimit);
+    if (existing && region->ReferenceCount() == 1) {
+        // Freed by the last process holding it: recreated empty by us
+        delete region;
+        CB_CONSTEXPR_SV fmt = "({}:{}) Data region {} no longer exists";
+        SPDLOG_ERROR(fmt.substr(8), name);
+        throw std::runtime_error(std::format(fmt, __FILE__, __LINE__, name));
+    }
+    if (m_HugePages) {
+        region->AdviseHugePages();
+    }
+
     // Reinterpret buffer region as span and verify
-    m_CircularBuffer = m_DataRegion->AsSpan<DataT>();
-    if (m_CircularBuffer.data() == nullptr || m_CircularBuffer.empty()) {
+    const BufferT buffer = region->AsSpan<DataT>();
+    if (buffer.data() == nullptr || buffer.empty()) {
         // Fail
+        delete region;
         CB_CONSTEXPR_SV fmt =
             "({}:{}) Reinterpretation of buffer data region as span failed";
         SPDLOG_ERROR(fmt.substr(8));
         throw std::runtime_error(std::format(fmt, __FILE__, __LINE__));
     }
+
+    SharedMemory *previous = m_DataRegion;
+    m_DataRegion = region;
+    m_CircularBuffer = buffer;
+    m_DataGeneration = generation;
+    return previous;
+}
+
+bool IWrapper::DataRegionCreated() const {
+    return m_DataRegion->ReferenceCount() == 1;
+}
+
+void IWrapper::SetFraming(SizeField sizeField, ClockSource clock,
+                          bool messageNumbers, int recordAlignment,
+                          bool contiguousRecords) noexcept {
+    m_SizeField = sizeField;
+    m_SizeFieldBytes = MaxSizeFieldBytes(sizeField);
+    m_Clock = clock;
+    m_MessageNumbers = messageNumbers;
+    m_HeaderSize = m_SizeFieldBytes +
+                   (m_Clock != ClockSource::None ? TIMESTAMP_SIZE : 0) +
+                   (m_MessageNumbers ? MESSAGE_NUMBER_SIZE : 0);
+    m_RecordAlignment = recordAlignment > 1 ? recordAlignment : 1;
+    m_ContiguousRecords = contiguousRecords;
+    // Header is padded so the message starts aligned
+    m_PayloadOffset =
+        (m_HeaderSize + m_RecordAlignment - 1) & -m_RecordAlignment;
 }
 
 IWrapper::~IWrapper() {
@@ -0,0 +1,69 @@
+#include "circularbuffer/LatencyHistogram.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace CircularBuffer {
+
+uint64_t LatencySnapshot::Percentile(double p) const noexcept {
+    if (count == 0) {
+        return 0;
+    }
+
+    // Rank of the requested sample (1-based)
+    const double clamped = std::clamp(p, 0.0, 100.0);
+    const auto rank = std::max<uint64_t>(
+        1, static_cast<uint64_t>(std::ceil(clamped / 100.0 * count)));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); i++) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            const uint64_t upper = i + 1 < buckets.size()
+                                       ? BucketLowerBound(i + 1) - 1
+                                       : max;
+            return std::clamp(upper, min, max);
+        }
+    }
+
+    return max;
+}
+
+double LatencySnapshot::Mean() const noexcept {
+    return count == 0 ? 0.0
+                      : static_cast<double>(sum) / static_cast<double>(count);
+}
+
+LatencySnapshot LatencyHistogram::Snapshot() const noexcept {
+    static constexpr auto relaxed = std::memory_order_relaxed;
+
+    LatencySnapshot snapshot;
+    snapshot.count = m_Count.load(std::memory_order_acquire);
+    snapshot.sum = m_Sum.load(relaxed);
+    snapshot.min = m_Min.load(relaxed);
+    snapshot.max = m_Max.load(relaxed);
+
+    // Buckets may be slightly ahead of the count if the producer is mid-update
+    for (size_t i = 0; i < m_Buckets.size(); i++) {
+        snapshot.buckets[i] = m_Buckets[i].load(relaxed);
+    }
+
+    return snapshot;
+}
+
+void LatencyHistogram::Reset() noexcept {
+    static constexpr auto relaxed = std::memory_order_relaxed;
+
+    for (std::atomic<uint64_t> &bucket : m_Buckets) {
+        bucket.store(0, relaxed);
+    }
+    m_Sum.store(0, relaxed);
+    m_Min.store(0, relaxed);
+    m_Max.store(0, relaxed);
+    m_Count.store(0, std::memory_order_release);
+}
+
+}  // namespace CircularBuffer
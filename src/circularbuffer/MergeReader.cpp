@@ -0,0 +1,198 @@
+#include "circularbuffer/MergeReader.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <format>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Clock.hpp"
+#include "circularbuffer/Copy.hpp"
+#include "circularbuffer/Macros.hpp"
+#include "circularbuffer/Reader.hpp"
+#include "circularbuffer/Spec.hpp"
+#include "circularbuffer/Writer.hpp"
+#include "spdlog/spdlog.h"
+
+namespace CircularBuffer {
+
+MergeReader::MergeReader(const std::vector<Spec> &specs,
+                         const MergeOptions &options)
+    : m_ReaderOptions(options.readerOptions) {
+    if (specs.empty()) {
+        CB_CONSTEXPR_SV fmt = "({}:{}) Merge needs at least one input";
+        SPDLOG_ERROR(fmt.substr(8));
+        throw std::invalid_argument(std::format(fmt, __FILE__, __LINE__));
+    }
+
+    m_Inputs.reserve(specs.size());
+    m_Heap.reserve(specs.size());
+    m_Empty.reserve(specs.size());
+    // Owned through `Input`, so inputs already opened are freed if a later one
+    // throws
+    for (const Spec &spec : specs) {
+        m_Inputs.push_back(
+            {spec, std::make_unique<Reader>(spec, m_ReaderOptions),
+             std::make_unique_for_overwrite<DataT[]>(MAX_MESSAGE_SIZE), 0, 0});
+        m_Empty.push_back(static_cast<int>(m_Inputs.size()) - 1);
+    }
+
+    // Timestamps must be comparable across inputs
+    m_Clock = m_Inputs.front().reader->TimestampClock();
+    for (size_t i = 0; i < m_Inputs.size(); i++) {
+        const ClockSource clock = m_Inputs[i].reader->TimestampClock();
+        if (clock == ClockSource::None || clock != m_Clock) {
+            CB_CONSTEXPR_SV fmt =
+                "({}:{}) Merge input {} ({}) is not timestamped with the same "
+                "clock as the others";
+            SPDLOG_ERROR(fmt.substr(8), i, specs[i].dataSharedMemoryName);
+            throw std::logic_error(std::format(fmt, __FILE__, __LINE__, i,
+                                               specs[i].dataSharedMemoryName));
+        }
+    }
+    m_MaxDelay = static_cast<TimestampT>(
+        static_cast<double>(options.maxDelayNanos) /
+        m_Inputs.front().reader->NanosPerTick());
+}
+
+int MergeReader::Read(BufferT readBuffer) {
+    if (const int ret = Refill(); ret < 0) [[unlikely]] {
+        return ret;
+    }
+
+    const int index = Peek();
+    if (index == -1) {
+        return 0;
+    }
+
+    Input &input = m_Inputs[index];
+    if (static_cast<size_t>(input.size) > readBuffer.size_bytes())
+        [[unlikely]] {
+        SPDLOG_ERROR("Read buffer too small: {} B vs message size of {} B",
+                     readBuffer.size_bytes(), input.size);
+        return -1;
+    }
+
+    // Emit the oldest message, and refill its input on the next read
+    std::pop_heap(m_Heap.begin(), m_Heap.end(),
+                  [this](int a, int b) { return After(a, b); });
+    m_Heap.pop_back();
+    m_Empty.push_back(index);
+
+    CopyMessage(readBuffer.data(), input.buffer.get(), input.size);
+    m_LastInput = index;
+    m_LastTimestamp = input.timestamp;
+    return input.size;
+}
+
+int MergeReader::Forward(Writer &writer) {
+    int forwarded = 0;
+    for (;;) {
+        if (const int ret = Refill(); ret < 0) [[unlikely]] {
+            return ret;
+        }
+
+        const int index = Peek();
+        if (index == -1) {
+            return forwarded;
+        }
+
+        // Write straight from the input's buffer. A rejected message (e.g.
+        // too big for the output ring) stays pending rather than being lost.
+        Input &input = m_Inputs[index];
+        if (!writer.Write(input.buffer.get(), input.size)) [[unlikely]] {
+            SPDLOG_ERROR("Failed to forward message of {} B from input {}",
+                         input.size, index);
+            return -1;
+        }
+
+        std::pop_heap(m_Heap.begin(), m_Heap.end(),
+                      [this](int a, int b) { return After(a, b); });
+        m_Heap.pop_back();
+        m_Empty.push_back(index);
+        m_LastInput = index;
+        m_LastTimestamp = input.timestamp;
+        forwarded++;
+    }
+}
+
+int MergeReader::Refill() noexcept {
+    for (size_t i = 0; i < m_Empty.size();) {
+        const int index = m_Empty[i];
+        Input &input = m_Inputs[index];
+
+        const int ret =
+            input.reader->Read(input.buffer.get(), MAX_MESSAGE_SIZE);
+        if (ret == 0) {
+            i++;
+            continue;
+        }
+        if (ret < 0) [[unlikely]] {
+            // Report the error once, then skip the input to its latest message
+            // so the others keep merging
+            if (ret == INT_MIN) {
+                SPDLOG_CRITICAL("Merge input {} got overwritten", index);
+            } else {
+                SPDLOG_CRITICAL("Merge input {} has an invalid message", index);
+            }
+            Reopen(index);
+            return ret;
+        }
+
+        input.size = ret;
+        input.timestamp = input.reader->LastTimestamp();
+        m_Heap.push_back(index);
+        std::push_heap(m_Heap.begin(), m_Heap.end(),
+                       [this](int a, int b) { return After(a, b); });
+
+        // Swap-remove: order of empty inputs doesn't matter
+        m_Empty[i] = m_Empty.back();
+        m_Empty.pop_back();
+    }
+    return 0;
+}
+
+bool MergeReader::Reopen(int index) noexcept {
+    Input &input = m_Inputs[index];
+    try {
+        input.reader = std::make_unique<Reader>(input.spec, m_ReaderOptions);
+    } catch (const std::exception &e) {
+        SPDLOG_ERROR("Merge input {} failed to reopen reader: {}", index,
+                     e.what());
+        return false;
+    }
+    return true;
+}
+
+int MergeReader::Peek() const noexcept {
+    if (m_Heap.empty()) {
+        return -1;
+    }
+
+    // With every input pending, the oldest message is next in order.
+    // Otherwise an empty input could still produce an older message, unless
+    // the oldest pending one is older than the max delay.
+    const int index = m_Heap.front();
+    if (!m_Empty.empty()) {
+        const TimestampT now = ReadClock(m_Clock);
+        const TimestampT timestamp = m_Inputs[index].timestamp;
+        if (timestamp + m_MaxDelay > now) {
+            return -1;
+        }
+    }
+    return index;
+}
+
+bool MergeReader::After(int a, int b) const noexcept {
+    const TimestampT timestampA = m_Inputs[a].timestamp;
+    const TimestampT timestampB = m_Inputs[b].timestamp;
+    return timestampA != timestampB ? timestampA > timestampB : a > b;
+}
+
+}  // namespace CircularBuffer
@@ -1,69 +1,213 @@
 #include "circularbuffer/Reader.hpp"
 
+#include <poll.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
 #include <atomic>
 #include <cassert>
+#include <cerrno>
 #include <climits>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <exception>
+#include <span>
 
 #include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Clock.hpp"
+#include "circularbuffer/Copy.hpp"
+#include "circularbuffer/EventBridge.hpp"
 #include "circularbuffer/IWrapper.hpp"
+#include "circularbuffer/LatencyHistogram.hpp"
+#include "circularbuffer/Probes.hpp"
+#include "circularbuffer/SeekIndex.hpp"
 #include "circularbuffer/Spec.hpp"
+#include "circularbuffer/State.hpp"
+#include "circularbuffer/Stats.hpp"
+#include "circularbuffer/Trace.hpp"
 #include "circularbuffer/Utils.hpp"
 #include "spdlog/spdlog.h"
 
 namespace CircularBuffer {
 
-Reader::Reader(const Spec& spec) : IWrapper(spec) {
+template <typename Ring>
+SpecReader<Ring>::SpecReader(const Spec& spec, const ReaderOptions& options)
+    : IWrapper(spec) {
     SetupSpdlog();
 
-    // Synchronize with buffer state
-    m_LocalIndex = m_State->readIdx.load(std::memory_order_acquire);
-    m_LocalSeqNum = m_State->seqNum.load(std::memory_order_acquire);
-    SPDLOG_DEBUG("Synchronized with buffer state: read={}, seq={}",
-                 m_LocalIndex, m_LocalSeqNum);
+    // Decode records the way the writer frames them, once it has published
+    // how
+    m_WantsHistogram = options.latencyHistogram;
+    m_FramingGeneration =
+        m_State->liveness.generation.load(std::memory_order_acquire);
+    LoadFraming();
+    if (m_FramingGeneration == 0) {
+        SPDLOG_DEBUG("Writer has not published record framing yet");
+    }
+
+    // Synchronize with buffer state. The writer may grow the buffer into a
+    // new data region meanwhile, in which case we start over there.
+    for (;;) {
+        if (options.replay && LoadTail()) {
+            SPDLOG_DEBUG("Replaying from oldest record: read={}, seq={}",
+                         m_LocalIndex, m_LocalSeqNum);
+        } else {
+            if (options.replay) {
+                SPDLOG_WARN("Replay requested but writer does not track the "
+                            "oldest record");
+            }
+
+            m_LocalIndex = m_State->readIdx.load(std::memory_order_acquire);
+            m_LocalSeqNum = m_State->seqNum.load(std::memory_order_acquire);
+            SPDLOG_DEBUG("Synchronized with buffer state: read={}, seq={}",
+                         m_LocalIndex, m_LocalSeqNum);
+        }
+
+        uint64_t generation;
+        size_t capacity;
+        SeqNumT baseSeqNum;
+        MessageNumberT baseMessageNumber;
+        LoadDataRegion(generation, capacity, baseSeqNum, baseMessageNumber);
+        if (generation == m_DataGeneration) {
+            break;
+        }
+        delete ReplaceDataRegion(generation, capacity, true);
+    }
+
+    if (options.conflateLag != 0) {
+        if (m_State->latest.enabled.load(std::memory_order_acquire) == 0) {
+            SPDLOG_WARN("Conflation requested but writer does not publish the "
+                        "newest record");
+        } else {
+            m_ConflateLag = options.conflateLag;
+        }
+
+        // Beyond half the buffer, a reader could be overwritten before it
+        // skips ahead
+        const size_t maxLag = m_CircularBuffer.size_bytes() / 2;
+        if (m_ConflateLag > maxLag) {
+            SPDLOG_WARN("Conflation lag of {} B is too close to the {} B "
+                        "buffer size: clamping to {} B",
+                        m_ConflateLag, m_CircularBuffer.size_bytes(), maxLag);
+            m_ConflateLag = maxLag;
+        }
+    }
+
+    if constexpr (Wait::NOTIFIES) {
+        if (options.eventFd) {
+            if (m_State->notification.enabled.load(
+                    std::memory_order_acquire) == 0) {
+                SPDLOG_WARN("Eventfd requested but writer does not send "
+                            "notifications");
+            } else {
+                m_Bridge = new EventBridge(m_State->notification);
+            }
+        }
+    } else if (options.eventFd) {
+        SPDLOG_WARN("Eventfd requested but the ring's wait policy does not "
+                    "notify");
+    }
+
+    // Watch the writer process
+    const Liveness &liveness = m_State->liveness;
+    m_WriterGeneration = liveness.generation.load(std::memory_order_acquire);
+    WatchWriter(liveness.writerPid.load(std::memory_order_relaxed));
+
+    if constexpr (Instrumentation::SHARED_STATS) {
+        RegisterStats();
+    }
 }
 
-int Reader::Read(BufferT readBuffer) {
+template <typename Ring>
+SpecReader<Ring>::~SpecReader() {
+    if (m_WriterFd != -1) {
+        close(m_WriterFd);
+    }
+
+    // Release statistics slot
+    if (m_Stats != nullptr) {
+        m_Stats->pid.store(0, std::memory_order_release);
+        m_Stats = nullptr;
+    }
+
+    delete m_Bridge;
+    delete m_Histogram;
+}
+
+template <typename Ring>
+int SpecReader<Ring>::Read(BufferT readBuffer) {
     static_assert(HEADER_SIZE <= sizeof(int));
 
     // Check if there's data to read
-    if (m_LocalIndex == m_State->readIdx.load(std::memory_order_acquire)) {
+    if (!Available()) {
         // Nothing to read
         return 0;
     }
 
+    // The writer reset the buffer since we loaded its framing. Its new framing
+    // is published once it announces the generation.
+    const uint64_t writerGeneration =
+        m_State->readWriterGeneration.load(std::memory_order_relaxed);
+    if (writerGeneration != m_FramingGeneration) [[unlikely]] {
+        if (m_State->liveness.generation.load(std::memory_order_acquire) !=
+            writerGeneration) {
+            return 0;
+        }
+        if (!Restart(writerGeneration)) {
+            return INT_MIN;
+        }
+        return Read(readBuffer);
+    }
+
     // Overwrite detection: How far behind in sequence number are we?
     SeqNumT lag =
         m_State->seqNum.load(std::memory_order_acquire) - m_LocalSeqNum;
-    if (lag > m_CircularBuffer.size_bytes()) [[unlikely]] {
+    // Too far behind to care: skip to the newest message instead
+    if (m_ConflateLag != 0 && lag > m_ConflateLag && Conflate()) [[unlikely]] {
+        lag = m_State->seqNum.load(std::memory_order_acquire) - m_LocalSeqNum;
+    }
+    if (lag > m_CircularBuffer.size_bytes() && !RegionFrozen(m_LocalSeqNum))
+        [[unlikely]] {
         // Overwritten
         SPDLOG_CRITICAL(
             "Overwrite detected: writer is {} bytes ahead of me > {} byte "
             "buffer size",
             lag, m_CircularBuffer.size_bytes());
+        RecordOverwrite();
         return INT_MIN;
     }
 
-    // Space to end of buffer
-    const int spaceToEnd = m_CircularBuffer.size_bytes() - m_LocalIndex;
+    // Space to end of buffer, 64-bit as buffers may be bigger than 2 GiB
+    const IndexT spaceToEnd = m_CircularBuffer.size_bytes() - m_LocalIndex;
+    const IndexT recordIndex = m_LocalIndex;
+    [[maybe_unused]] const SeqNumT recordSeqNum = m_LocalSeqNum;
+    CB_PROBE(read_begin, recordSeqNum, recordIndex);
 
     MessageSizeT msgSize;
 
-    // Header can fit
-    if (spaceToEnd >= HEADER_SIZE) [[likely]] {
-        // Read message size
-        std::memcpy(&msgSize, &m_CircularBuffer[m_LocalIndex], HEADER_SIZE);
+    // Header can fit. Always the case for aligned records, as the space left
+    // is a multiple of the alignment.
+    if (spaceToEnd >= static_cast<IndexT>(m_PayloadOffset)) [[likely]] {
+        // Read message size and optional header fields
+        msgSize = ReadHeader(m_LocalIndex);
 
         // Validate message size
         if (msgSize < 0 || msgSize > MAX_MESSAGE_SIZE) [[unlikely]] {
+            if (msgSize == GROW_MARKER) {
+                return ReadNextRegion(readBuffer);
+            }
             SPDLOG_CRITICAL("Message size error: {} is invalid", msgSize);
             return -1;
         }
 
+        // Offset of the message from the start of the record
+        const int payloadOffset = PayloadOffset(msgSize);
+
 #ifdef DEBUG
         // Track bytes read/remaining as we read
-        int totalBytesRead = HEADER_SIZE;
+        int totalBytesRead = payloadOffset;
         int remainingBytes = msgSize;
 #endif
 
@@ -75,14 +219,15 @@ int Reader::Read(BufferT readBuffer) {
             return -1;
         }
 
-        // Compute total bytes we need to read
-        const int totalBytesToRead = HEADER_SIZE + msgSize;
+        // Compute total bytes we need to read, including padding
+        const int totalBytesToRead = RecordSize(msgSize);
 
         // Message fits - can read like normal
-        if (totalBytesToRead <= spaceToEnd) [[likely]] {
+        if (static_cast<IndexT>(totalBytesToRead) <= spaceToEnd) [[likely]] {
             // Read buffer data and shift pointer
-            std::memcpy(readBuffer.data(),
-                        &m_CircularBuffer[m_LocalIndex + HEADER_SIZE], msgSize);
+            CopyMessage(readBuffer.data(),
+                        &m_CircularBuffer[m_LocalIndex + payloadOffset],
+                        msgSize);
             m_LocalIndex += totalBytesToRead;
 
 #ifdef DEBUG
@@ -90,27 +235,45 @@ int Reader::Read(BufferT readBuffer) {
             remainingBytes -= msgSize;
 #endif
         }
+        // Skip record - writer restarted the record at start of buffer, and
+        // counted the space skipped
+        else if (m_ContiguousRecords) {
+            CopyMessage(readBuffer.data(), &m_CircularBuffer[payloadOffset],
+                        msgSize);
+            m_LocalIndex = totalBytesToRead;
+            m_LocalSeqNum += spaceToEnd;
+
+#ifdef DEBUG
+            totalBytesRead += msgSize;
+            remainingBytes -= msgSize;
+#endif
+
+            SPDLOG_DEBUG("Detected wraparound - skip record");
+        }
         // Message wraps - need to split read
         else {
+            // Less than a record is left before the end
+            const int bytesToEnd = static_cast<int>(spaceToEnd);
             int msgBytesRead = 0;
 
             // Read first part and shift pointer to beginning of buffer
-            std::memcpy(readBuffer.data(),
-                        &m_CircularBuffer[m_LocalIndex + HEADER_SIZE],
-                        spaceToEnd - HEADER_SIZE);
+            CopyMessage(readBuffer.data(),
+                        &m_CircularBuffer[m_LocalIndex + payloadOffset],
+                        bytesToEnd - payloadOffset);
             m_LocalIndex = 0;
-            msgBytesRead += (spaceToEnd - HEADER_SIZE);
+            msgBytesRead += (bytesToEnd - payloadOffset);
 
 #ifdef DEBUG
-            totalBytesRead += (spaceToEnd - HEADER_SIZE);
-            remainingBytes -= (spaceToEnd - HEADER_SIZE);
+            totalBytesRead += (bytesToEnd - payloadOffset);
+            remainingBytes -= (bytesToEnd - payloadOffset);
 #endif
 
-            // Read second part and shift pointer again
-            const int bytesLeft = totalBytesToRead - spaceToEnd;
-            std::memcpy(readBuffer.data() + msgBytesRead,
+            // Read second part and shift pointer again, skipping trailing
+            // padding
+            const int bytesLeft = msgSize - msgBytesRead;
+            CopyMessage(readBuffer.data() + msgBytesRead,
                         &m_CircularBuffer[m_LocalIndex], bytesLeft);
-            m_LocalIndex += bytesLeft;
+            m_LocalIndex += totalBytesToRead - bytesToEnd;
 
 #ifdef DEBUG
             totalBytesRead += bytesLeft;
@@ -123,7 +286,7 @@ int Reader::Read(BufferT readBuffer) {
         m_LocalSeqNum += totalBytesToRead;
 
 #ifdef DEBUG
-        assert(totalBytesRead == totalBytesToRead);
+        assert(totalBytesRead == payloadOffset + msgSize);
         assert(remainingBytes == 0);
 #endif
     }
@@ -132,11 +295,14 @@ int Reader::Read(BufferT readBuffer) {
         // Wrap around to start of buffer
         m_LocalIndex = 0;
 
-        // Read message size
-        std::memcpy(&msgSize, &m_CircularBuffer[m_LocalIndex], HEADER_SIZE);
+        // Read message size and optional header fields
+        msgSize = ReadHeader(m_LocalIndex);
 
         // Validate message size
         if (msgSize < 0 || msgSize > MAX_MESSAGE_SIZE) [[unlikely]] {
+            if (msgSize == GROW_MARKER) {
+                return ReadNextRegion(readBuffer);
+            }
             SPDLOG_CRITICAL("Message size error: {} is invalid", msgSize);
             return -1;
         }
@@ -150,11 +316,12 @@ int Reader::Read(BufferT readBuffer) {
         }
 
         // Read message
-        std::memcpy(readBuffer.data(),
-                    &m_CircularBuffer[m_LocalIndex + HEADER_SIZE], msgSize);
+        CopyMessage(readBuffer.data(),
+                    &m_CircularBuffer[m_LocalIndex + PayloadOffset(msgSize)],
+                    msgSize);
 
         // Move pointers
-        const int totalBytesRead = HEADER_SIZE + msgSize;
+        const int totalBytesRead = RecordSize(msgSize);
         m_LocalIndex += totalBytesRead;
         m_LocalSeqNum += totalBytesRead;
 
@@ -163,17 +330,645 @@ int Reader::Read(BufferT readBuffer) {
 
     // Overwrite detection: How far behind in sequence number are we?
     lag = m_State->seqNum.load(std::memory_order_acquire) - m_LocalSeqNum;
-    if (lag > m_CircularBuffer.size_bytes()) [[unlikely]] {
+    if (lag > m_CircularBuffer.size_bytes() && !RegionFrozen(m_LocalSeqNum))
+        [[unlikely]] {
+        // Overwritten while copying: the newest message is still intact
+        if (m_ConflateLag != 0 && Conflate()) {
+            return Read(readBuffer);
+        }
         // Overwritten
         SPDLOG_CRITICAL(
             "Overwrite detected: writer is {} bytes ahead of me > {} byte "
             "buffer size",
             lag, m_CircularBuffer.size_bytes());
+        RecordOverwrite();
         return INT_MIN;
     }
 
+    if (m_Histogram != nullptr) {
+        RecordLatency();
+    }
+
+    // Statistics are published after the read so they stay off the critical
+    // path
+    if constexpr (Instrumentation::SHARED_STATS) {
+        if (m_Stats != nullptr) {
+            m_Stats->seqNum.store(m_LocalSeqNum, std::memory_order_relaxed);
+            m_Stats->messages.store(++m_StatMessages,
+                                    std::memory_order_relaxed);
+        }
+    }
+
+    Tracer::Record(TraceEvent::Read, recordIndex, msgSize);
+    CB_PROBE(read_end, recordSeqNum, recordIndex, msgSize);
     SPDLOG_DEBUG("Read message of size {} bytes", msgSize);
     return msgSize;
 }
 
+template <typename Ring>
+int SpecReader<Ring>::ReadView(std::span<const DataT> &message) {
+    if (!m_ContiguousRecords) [[unlikely]] {
+        SPDLOG_ERROR("Can't read in place: writer doesn't keep records "
+                     "contiguous");
+        return -1;
+    }
+
+    // Check if there's data to read
+    if (!Available()) {
+        // Nothing to read
+        return 0;
+    }
+
+    // The writer reset the buffer since we loaded its framing. Its new framing
+    // is published once it announces the generation.
+    const uint64_t writerGeneration =
+        m_State->readWriterGeneration.load(std::memory_order_relaxed);
+    if (writerGeneration != m_FramingGeneration) [[unlikely]] {
+        if (m_State->liveness.generation.load(std::memory_order_acquire) !=
+            writerGeneration) {
+            return 0;
+        }
+        if (!Restart(writerGeneration)) {
+            return INT_MIN;
+        }
+        return ReadView(message);
+    }
+
+    // Overwrite detection, as in `Read()`
+    const SeqNumT lag =
+        m_State->seqNum.load(std::memory_order_acquire) - m_LocalSeqNum;
+    if (m_ConflateLag != 0 && lag > m_ConflateLag) [[unlikely]] {
+        Conflate();
+    }
+    m_ViewSeqNum = m_LocalSeqNum;
+    if (!ViewIntact()) [[unlikely]] {
+        SPDLOG_CRITICAL("Overwrite detected: writer is more than {} bytes "
+                        "ahead of me",
+                        m_CircularBuffer.size_bytes());
+        RecordOverwrite();
+        return INT_MIN;
+    }
+
+    // Header can't fit - writer will have wrapped around
+    const IndexT capacity = m_CircularBuffer.size_bytes();
+    if (capacity - m_LocalIndex < static_cast<IndexT>(m_PayloadOffset)) {
+        m_LocalIndex = 0;
+    }
+    const IndexT recordIndex = m_LocalIndex;
+    [[maybe_unused]] const SeqNumT recordSeqNum = m_LocalSeqNum;
+    CB_PROBE(read_begin, recordSeqNum, recordIndex);
+
+    // Read message size and optional header fields
+    const MessageSizeT msgSize = ReadHeader(m_LocalIndex);
+    if (msgSize < 0 || msgSize > MAX_MESSAGE_SIZE) [[unlikely]] {
+        if (msgSize == GROW_MARKER) {
+            if (!FollowRegion()) [[unlikely]] {
+                RecordOverwrite();
+                return INT_MIN;
+            }
+            return ReadView(message);
+        }
+        SPDLOG_CRITICAL("Message size error: {} is invalid", msgSize);
+        return -1;
+    }
+
+    // Skip record - writer restarted the record at start of buffer, and
+    // counted the space skipped
+    if (IsSkipRecord(m_LocalIndex, msgSize)) {
+        m_LocalSeqNum += capacity - m_LocalIndex;
+        m_LocalIndex = 0;
+    }
+
+    message = {&m_CircularBuffer[m_LocalIndex + PayloadOffset(msgSize)],
+               static_cast<size_t>(msgSize)};
+    const int totalBytesRead = RecordSize(msgSize);
+    m_LocalIndex += totalBytesRead;
+    m_LocalSeqNum += totalBytesRead;
+
+    // The header may have been overwritten while we read it
+    m_ViewSeqNum = m_LocalSeqNum;
+    if (!ViewIntact()) [[unlikely]] {
+        SPDLOG_CRITICAL("Overwrite detected: writer is more than {} bytes "
+                        "ahead of me",
+                        capacity);
+        RecordOverwrite();
+        return INT_MIN;
+    }
+
+    if (m_Histogram != nullptr) {
+        RecordLatency();
+    }
+    if constexpr (Instrumentation::SHARED_STATS) {
+        if (m_Stats != nullptr) {
+            m_Stats->seqNum.store(m_LocalSeqNum, std::memory_order_relaxed);
+            m_Stats->messages.store(++m_StatMessages,
+                                    std::memory_order_relaxed);
+        }
+    }
+
+    Tracer::Record(TraceEvent::Read, recordIndex, msgSize);
+    CB_PROBE(read_end, recordSeqNum, recordIndex, msgSize);
+    return msgSize;
+}
+
+template <typename Ring>
+bool SpecReader<Ring>::ViewIntact() const noexcept {
+    // Whatever was read from the view happens before the check
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const SeqNumT lag =
+        m_State->seqNum.load(std::memory_order_relaxed) - m_ViewSeqNum;
+    return lag <= m_CircularBuffer.size_bytes() || RegionFrozen(m_ViewSeqNum);
+}
+
+template <typename Ring>
+int SpecReader<Ring>::ReadNextRegion(BufferT readBuffer) {
+    if (!FollowRegion()) [[unlikely]] {
+        RecordOverwrite();
+        return INT_MIN;
+    }
+    return Read(readBuffer);
+}
+
+template <typename Ring>
+bool SpecReader<Ring>::FollowRegion() noexcept {
+    uint64_t generation;
+    size_t capacity;
+    SeqNumT baseSeqNum;
+    MessageNumberT baseMessageNumber;
+    LoadDataRegion(generation, capacity, baseSeqNum, baseMessageNumber);
+    if (generation != m_DataGeneration + 1) {
+        SPDLOG_CRITICAL("Writer grew the buffer again before we followed it "
+                        "to data region {}: overwritten",
+                        m_DataGeneration + 1);
+        return false;
+    }
+
+    // Hold a reference, so that the region outlives the writer like the one
+    // we were constructed in. It may be freed as soon as the writer moves on
+    // again, and must not be recreated.
+    try {
+        delete ReplaceDataRegion(generation, capacity, true);
+    } catch (const std::exception &e) {
+        SPDLOG_CRITICAL("Can't follow buffer to data region {}: {}",
+                        generation, e.what());
+        return false;
+    }
+
+    // Start of the new region. The marker isn't numbered.
+    m_LocalIndex = 0;
+    m_LocalSeqNum = baseSeqNum;
+    if (m_MessageNumbers) {
+        m_LastMessageNumber = baseMessageNumber - 1;
+    }
+
+    SPDLOG_DEBUG("Followed buffer to data region {} of {} B: seq={}",
+                 generation, capacity, baseSeqNum);
+    return true;
+}
+
+template <typename Ring>
+bool SpecReader<Ring>::RegionFrozen(SeqNumT seqNum) const noexcept {
+    const DataRegion &region = m_State->region;
+    return region.generation.load(std::memory_order_acquire) ==
+               m_DataGeneration + 1 &&
+           region.baseSeqNum.load(std::memory_order_relaxed) - seqNum <=
+               m_CircularBuffer.size_bytes();
+}
+
+template <typename Ring>
+int SpecReader<Ring>::EventFd() const noexcept {
+    return m_Bridge != nullptr ? m_Bridge->Fd() : -1;
+}
+
+template <typename Ring>
+bool SpecReader<Ring>::Arm() noexcept {
+    if (m_Bridge == nullptr) [[unlikely]] {
+        SPDLOG_ERROR("Can't arm reader without eventfd");
+        return false;
+    }
+
+    return m_Bridge->Arm(*m_State, m_LocalIndex, m_DataGeneration);
+}
+
+template <typename Ring>
+bool SpecReader<Ring>::WriterAlive() noexcept {
+    // Shut down or replaced
+    const Liveness &liveness = m_State->liveness;
+    const pid_t writerPid = liveness.writerPid.load(std::memory_order_acquire);
+    const uint64_t generation =
+        liveness.generation.load(std::memory_order_acquire);
+    // Constructed before any writer: attach to the first one
+    if (m_WriterGeneration == 0) {
+        m_WriterGeneration = generation;
+    }
+    if (generation != m_WriterGeneration || writerPid == 0) {
+        return false;
+    }
+
+    // A new writer resumed the stream: watch it instead
+    if (writerPid != m_WriterPid) {
+        WatchWriter(writerPid);
+    }
+
+    // Stopped or hung, or in another pid namespace
+    if (HeartbeatMissed(liveness)) {
+        return false;
+    }
+
+    // Died. The pidfd can't be fooled by pid reuse.
+    if (m_WriterFd != -1) {
+        pollfd writerPoll{m_WriterFd, POLLIN, 0};
+        return poll(&writerPoll, 1, 0) == 0;
+    }
+    return kill(m_WriterPid, 0) == 0 || errno != ESRCH;
+}
+
+template <typename Ring>
+void SpecReader<Ring>::WatchWriter(pid_t writerPid) noexcept {
+    if (m_WriterFd != -1) {
+        close(m_WriterFd);
+        m_WriterFd = -1;
+    }
+
+    m_WriterPid = writerPid;
+#ifdef SYS_pidfd_open
+    if (m_WriterPid != 0) {
+        m_WriterFd = static_cast<int>(syscall(SYS_pidfd_open, m_WriterPid, 0));
+    }
+#endif
+    if (m_WriterFd == -1) {
+        SPDLOG_DEBUG("No pidfd for writer {}: falling back to signal checks",
+                     m_WriterPid);
+    }
+}
+
+template <typename Ring>
+bool SpecReader<Ring>::Seek(MessageNumberT messageNumber) {
+    IndexT index;
+    SeqNumT seqNum;
+    switch (Locate(messageNumber, index, seqNum)) {
+        case LocateResult::Found:
+            break;
+        case LocateResult::Disabled:
+            SPDLOG_ERROR(
+                "Can't seek to message {}: writer does not number messages",
+                messageNumber);
+            return false;
+        case LocateResult::NotWritten:
+            SPDLOG_DEBUG("Can't seek to message {}: not written yet",
+                         messageNumber);
+            return false;
+        case LocateResult::Lost:
+            SPDLOG_DEBUG("Can't seek to message {}: overwritten",
+                         messageNumber);
+            return false;
+    }
+
+    m_LocalIndex = index;
+    m_LocalSeqNum = seqNum;
+    m_Overwritten = false;
+    SPDLOG_DEBUG("Seeked to message {}: read={}, seq={}", messageNumber,
+                 m_LocalIndex, m_LocalSeqNum);
+    return true;
+}
+
+template <typename Ring>
+typename SpecReader<Ring>::LocateResult SpecReader<Ring>::Locate(
+    MessageNumberT messageNumber, IndexT &index, SeqNumT &seqNum) {
+    // Records are framed the way the writer last published
+    const uint64_t writerGeneration =
+        m_State->liveness.generation.load(std::memory_order_acquire);
+    if (writerGeneration != m_FramingGeneration &&
+        !Restart(writerGeneration)) {
+        return LocateResult::Lost;
+    }
+
+    const SeekIndex &seekIndex = m_State->seekIndex;
+    const uint64_t interval = seekIndex.interval.load(std::memory_order_acquire);
+    if (interval == 0) [[unlikely]] {
+        return LocateResult::Disabled;
+    }
+
+    // Load the nearest indexed message at or before the target
+    const MessageNumberT base = messageNumber - messageNumber % interval;
+    MessageNumberT entryNumber;
+    LoadSeekEntry(seekIndex.entries[(base / interval) % SEEK_INDEX_SIZE],
+                  entryNumber, index, seqNum);
+
+    // Entry still unused or holding an earlier message: the target comes
+    // later. Entry reused for a later message: the target is long gone.
+    if (entryNumber == INVALID_MESSAGE_NUMBER || entryNumber < base) {
+        return LocateResult::NotWritten;
+    }
+    if (entryNumber != base) {
+        return LocateResult::Lost;
+    }
+
+    // Entries from before the writer last grew the buffer are in the old data
+    // region, which only readers that haven't followed yet can still read.
+    // Readers that haven't followed have to for later entries.
+    const uint64_t generation =
+        m_State->region.generation.load(std::memory_order_acquire);
+    const SeqNumT baseSeqNum =
+        m_State->region.baseSeqNum.load(std::memory_order_relaxed);
+    if (seqNum < baseSeqNum) {
+        if (generation != m_DataGeneration + 1) {
+            return LocateResult::Lost;
+        }
+    } else if (generation != m_DataGeneration && !FollowRegion()) {
+        return LocateResult::Lost;
+    }
+
+    // Hop headers from the indexed message to the target
+    for (MessageNumberT number = base;; number++) {
+        const IndexT capacity = m_CircularBuffer.size_bytes();
+        // Target not written yet
+        if (index == m_State->readIdx.load(std::memory_order_acquire)) {
+            return LocateResult::NotWritten;
+        }
+
+        // Header can't fit - writer will have wrapped around
+        if (capacity - index < static_cast<IndexT>(m_PayloadOffset)) {
+            index = 0;
+        }
+
+        int fieldBytes;
+        const MessageSizeT msgSize = LoadSize(index, fieldBytes);
+        MessageNumberT headerNumber;
+        std::memcpy(&headerNumber,
+                    &m_CircularBuffer[index + MessageNumberOffset(fieldBytes)],
+                    MESSAGE_NUMBER_SIZE);
+
+        // Target is in the region the writer grew the buffer into
+        if (msgSize == GROW_MARKER) {
+            if (!FollowRegion()) {
+                return LocateResult::Lost;
+            }
+            index = 0;
+            seqNum = m_LocalSeqNum;
+            number--;
+            continue;
+        }
+
+        // Records may be overwritten while we hop. Message numbers never
+        // repeat, so a mismatch also catches a stale header.
+        const SeqNumT lag =
+            m_State->seqNum.load(std::memory_order_acquire) - seqNum;
+        if ((lag > capacity && !RegionFrozen(seqNum)) ||
+            headerNumber != number || msgSize < 0 ||
+            msgSize > MAX_MESSAGE_SIZE) {
+            return LocateResult::Lost;
+        }
+
+        // Skip record - writer restarted the record at start of buffer
+        if (IsSkipRecord(index, msgSize)) {
+            seqNum += capacity - index;
+            index = 0;
+        }
+
+        if (number == messageNumber) {
+            return LocateResult::Found;
+        }
+
+        const int recordSize = RecordSize(msgSize);
+        index += recordSize;
+        if (index >= capacity) {
+            index -= capacity;
+        }
+        seqNum += recordSize;
+    }
+}
+
+template <typename Ring>
+void SpecReader<Ring>::LoadSeekEntry(const SeekEntry &entry,
+                                     MessageNumberT &messageNumber,
+                                     IndexT &index, SeqNumT &seqNum) noexcept {
+    // Retry until we get a consistent snapshot
+    for (;;) {
+        const uint64_t version = entry.version.load(std::memory_order_acquire);
+        if (version % 2 != 0) {
+            continue;
+        }
+
+        messageNumber = entry.messageNumber.load(std::memory_order_relaxed);
+        index = entry.index.load(std::memory_order_relaxed);
+        seqNum = entry.seqNum.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (entry.version.load(std::memory_order_relaxed) == version) {
+            return;
+        }
+    }
+}
+
+template <typename Ring>
+LatencySnapshot SpecReader<Ring>::Latency() const noexcept {
+    return m_Histogram != nullptr ? m_Histogram->Snapshot() : LatencySnapshot{};
+}
+
+template <typename Ring>
+void SpecReader<Ring>::RecordLatency() noexcept {
+    // A writer that reset the buffer may have stopped timestamping
+    if (m_Clock == ClockSource::None) [[unlikely]] {
+        return;
+    }
+
+    const TimestampT now = ReadClock(m_Clock);
+
+    // Clocks on different cores may be slightly out of sync
+    const TimestampT elapsed = now > m_LastTimestamp ? now - m_LastTimestamp : 0;
+    m_Histogram->Record(
+        m_Clock == ClockSource::TSC
+            ? static_cast<uint64_t>(static_cast<double>(elapsed) *
+                                    m_NanosPerTick)
+            : elapsed);
+}
+
+template <typename Ring>
+void SpecReader<Ring>::LoadFraming() {
+    const Config &config = m_State->config;
+    const ClockSource clock = config.clock.load(std::memory_order_acquire);
+    SetFraming(config.sizeField.load(std::memory_order_relaxed), clock,
+               config.messageNumbers.load(std::memory_order_relaxed) != 0,
+               static_cast<int>(
+                   config.recordAlignment.load(std::memory_order_relaxed)),
+               config.contiguousRecords.load(std::memory_order_relaxed) != 0);
+    m_NanosPerTick =
+        m_Clock == ClockSource::TSC
+            ? config.nanosPerTick.load(std::memory_order_relaxed)
+            : 1.0;
+
+    if (m_WantsHistogram && m_Histogram == nullptr &&
+        m_FramingGeneration != 0) {
+        if (m_Clock == ClockSource::None) {
+            SPDLOG_WARN("Latency histogram requested but writer does not "
+                        "timestamp messages");
+        } else {
+            m_Histogram = new LatencyHistogram;
+        }
+    }
+}
+
+template <typename Ring>
+bool SpecReader<Ring>::Restart(uint64_t generation) {
+    // The writer keeps its data region when it resets the buffer, and may have
+    // grown it since
+    uint64_t dataGeneration;
+    size_t capacity;
+    SeqNumT baseSeqNum;
+    MessageNumberT baseMessageNumber;
+    LoadDataRegion(dataGeneration, capacity, baseSeqNum, baseMessageNumber);
+    if (dataGeneration != m_DataGeneration) {
+        try {
+            delete ReplaceDataRegion(dataGeneration, capacity, true);
+        } catch (const std::exception &e) {
+            SPDLOG_CRITICAL("Can't restart in data region {}: {}",
+                            dataGeneration, e.what());
+            RecordOverwrite();
+            return false;
+        }
+    }
+
+    m_FramingGeneration = generation;
+    LoadFraming();
+
+    // Start of the new stream
+    m_LocalIndex = 0;
+    m_LocalSeqNum = baseSeqNum;
+    m_LastMessageNumber = m_MessageNumbers ? baseMessageNumber - 1
+                                           : INVALID_MESSAGE_NUMBER;
+    m_LastTimestamp = 0;
+    m_Overwritten = false;
+
+    SPDLOG_INFO("Writer reset the buffer: restarting its stream at seq={}",
+                m_LocalSeqNum);
+    return true;
+}
+
+template <typename Ring>
+MessageSizeT SpecReader<Ring>::ReadHeader(IndexT index) noexcept {
+    int fieldBytes;
+    const MessageSizeT msgSize = LoadSize(index, fieldBytes);
+    if (m_Clock != ClockSource::None) {
+        std::memcpy(&m_LastTimestamp, &m_CircularBuffer[index + fieldBytes],
+                    TIMESTAMP_SIZE);
+    }
+    if (m_MessageNumbers) {
+        std::memcpy(&m_LastMessageNumber,
+                    &m_CircularBuffer[index + MessageNumberOffset(fieldBytes)],
+                    MESSAGE_NUMBER_SIZE);
+    }
+
+    return msgSize;
+}
+
+template <typename Ring>
+bool SpecReader<Ring>::LoadTail() noexcept {
+    const Tail &tail = m_State->tail;
+    if (tail.enabled.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    // Retry until we get a consistent snapshot
+    for (;;) {
+        const uint64_t version = tail.version.load(std::memory_order_acquire);
+        if (version % 2 != 0) {
+            continue;
+        }
+
+        m_LocalIndex = tail.index.load(std::memory_order_relaxed);
+        m_LocalSeqNum = tail.seqNum.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (tail.version.load(std::memory_order_relaxed) == version) {
+            return true;
+        }
+    }
+}
+
+template <typename Ring>
+bool SpecReader<Ring>::Conflate() noexcept {
+    const Latest &latest = m_State->latest;
+    const uint64_t version = latest.version.load(std::memory_order_acquire);
+    // Nothing written yet, or being updated: try again on the next read
+    if (version == 0 || version % 2 != 0) {
+        return false;
+    }
+
+    const uint64_t generation =
+        latest.generation.load(std::memory_order_relaxed);
+    const IndexT index = latest.index.load(std::memory_order_relaxed);
+    const SeqNumT seqNum = latest.seqNum.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (latest.version.load(std::memory_order_relaxed) != version ||
+        generation != m_DataGeneration || seqNum <= m_LocalSeqNum) {
+        return false;
+    }
+
+    SPDLOG_DEBUG("Conflating: skipping {} bytes to read={}, seq={}",
+                 seqNum - m_LocalSeqNum, index, seqNum);
+    Tracer::Record(TraceEvent::Conflate, index, seqNum - m_LocalSeqNum);
+    m_LocalIndex = index;
+    m_LocalSeqNum = seqNum;
+    m_Overwritten = false;
+    m_Conflations++;
+    return true;
+}
+
+template <typename Ring>
+void SpecReader<Ring>::RegisterStats() noexcept {
+    Stats &stats = m_State->stats;
+    if (stats.enabled.load(std::memory_order_acquire) == 0) {
+        return;
+    }
+
+    // Claim the first free slot, or one left behind by a reader that died
+    // without releasing it
+    const pid_t pid = getpid();
+    for (ReaderStats &slot : stats.readers) {
+        pid_t expected = slot.pid.load(std::memory_order_acquire);
+        if (expected != 0 && (kill(expected, 0) == 0 || errno != ESRCH)) {
+            continue;
+        }
+        if (slot.pid.compare_exchange_strong(expected, pid,
+                                             std::memory_order_acq_rel)) {
+            if (expected != 0) {
+                SPDLOG_DEBUG("Reclaimed statistics slot of dead reader {}",
+                             expected);
+            }
+            slot.seqNum.store(m_LocalSeqNum, std::memory_order_relaxed);
+            slot.messages.store(0, std::memory_order_relaxed);
+            slot.overwrites.store(0, std::memory_order_relaxed);
+            m_Stats = &slot;
+            SPDLOG_DEBUG("Registered for statistics in slot {}",
+                         &slot - stats.readers);
+            return;
+        }
+    }
+
+    SPDLOG_WARN("No free statistics slot: max {} tracked readers",
+                MAX_TRACKED_READERS);
+}
+
+template <typename Ring>
+void SpecReader<Ring>::RecordOverwrite() noexcept {
+    // Only count the first detection of each overwrite
+    if (m_Overwritten) {
+        return;
+    }
+    if constexpr (Instrumentation::SHARED_STATS) {
+        if (m_Stats != nullptr) {
+            m_Stats->overwrites.store(++m_StatOverwrites,
+                                      std::memory_order_relaxed);
+        }
+    }
+    const SeqNumT lag =
+        m_State->seqNum.load(std::memory_order_relaxed) - m_LocalSeqNum;
+    Tracer::Record(TraceEvent::Overwrite, m_LocalIndex, lag);
+    CB_PROBE(overwrite, m_LocalIndex, lag);
+    m_Overwritten = true;
+}
+
+// `Reader` and `LeanReader`
+template class SpecReader<SpecRing>;
+template class SpecReader<LeanSpecRing>;
+
 }  // namespace CircularBuffer
@@ -101,6 +101,11 @@ bool SemaphoreLock::Release() noexcept {
     return released;
 }
 
+void SemaphoreLock::Adopt() noexcept {
+    m_HoldsOwnership.store(true, std::memory_order_release);
+    SPDLOG_DEBUG("Adopted semaphore {}", m_Name);
+}
+
 bool SemaphoreLock::Acquire(int &err) noexcept {
     const bool acquired = sem_trywait(m_Sem) == 0;
     if (acquired) {
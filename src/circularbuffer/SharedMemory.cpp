@@ -20,9 +20,11 @@
 #include "spdlog/spdlog.h"
 
 SharedMemory::SharedMemory(const std::string_view name,
-                           const size_t requestedSize)
+                           const size_t requestedSize, const bool readOnly,
+                           const size_t maxSize)
     : m_DataSize(requestedSize),
       m_TotalSize(requestedSize + DATA_OFFSET_BYTES),
+      m_ReadOnly(readOnly),
       m_SemLock(name) {
     SetupSpdlog();
 
@@ -37,17 +39,27 @@ SharedMemory::SharedMemory(const std::string_view name,
         throw std::length_error(
             std::format(fmt, __FILE__, __LINE__, name, nameLen, MAX_NAME_LEN));
     }
-    if (requestedSize < 1 || requestedSize > MAX_SIZE_BYTES) {
+    if (requestedSize < 1 || requestedSize > maxSize) {
         CB_CONSTEXPR_SV fmt =
             "({}:{}) Requested memory region of size {} B is "
             "invalid: size must be between 1 and {} bytes";
-        SPDLOG_ERROR(fmt.substr(8), requestedSize, MAX_SIZE_BYTES);
-        throw std::domain_error(std::format(fmt, __FILE__, __LINE__,
-                                            requestedSize, MAX_SIZE_BYTES));
+        SPDLOG_ERROR(fmt.substr(8), requestedSize, maxSize);
+        throw std::domain_error(
+            std::format(fmt, __FILE__, __LINE__, requestedSize, maxSize));
+    }
+
+    // Read-only views never allocate
+    if (m_ReadOnly && !OpenSharedMemFile(name)) {
+        const int err = errno;
+        CB_CONSTEXPR_SV fmt =
+            "({}:{}) Failed to open shared memory for {} read-only: {}";
+        SPDLOG_ERROR(fmt.substr(8), name, strerror(err));
+        throw std::runtime_error(
+            std::format(fmt, __FILE__, __LINE__, name, strerror(err)));
     }
 
     // If we can't open shared memory at m_Name
-    if (!OpenSharedMemFile(name)) {
+    if (m_FileDes == -1 && !OpenSharedMemFile(name)) {
         // Try to create it
         AllocSharedMem(name);
 
@@ -71,11 +83,18 @@ SharedMemory::SharedMemory(const std::string_view name,
     std::strncpy(m_Name, name.data(), nameLen);
 
     // Increment ref counter
-    const std::atomic_ref<int> refCounter(*m_RefCounter);
-    refCounter.fetch_add(1, std::memory_order_release);
+    if (!m_ReadOnly) {
+        const std::atomic_ref<int> refCounter(*m_RefCounter);
+        refCounter.fetch_add(1, std::memory_order_release);
+    }
 }
 
 SharedMemory::~SharedMemory() {
+    // Read-only views don't own a reference
+    if (m_ReadOnly && m_RefCounter != nullptr) {
+        UnmapSharedMem();
+    }
+
     // Check before dereferencing
     if (m_RefCounter != nullptr) {
         const std::atomic_ref<int> refCounter(*m_RefCounter);
@@ -110,7 +129,8 @@ int SharedMemory::ReferenceCount() const {
 
 bool SharedMemory::OpenSharedMemFile(std::string_view name) {
     // Try to open shared memory file
-    const int fileDesc = shm_open(name.data(), O_RDWR, S_IRUSR + S_IWUSR);
+    const int fileDesc = shm_open(name.data(), m_ReadOnly ? O_RDONLY : O_RDWR,
+                                  S_IRUSR + S_IWUSR);
     if (fileDesc == -1) {
         // Failed
 
@@ -184,9 +204,12 @@ void SharedMemory::AllocSharedMem(std::string_view name) {
     }
 
     // Allocate m_Size bytes
-    if (ftruncate(fileDesc, m_TotalSize) == -1) {
+    const int ret = ftruncate(fileDesc, m_TotalSize);
+    const int err = errno;
+    // Opened again by the caller
+    close(fileDesc);
+    if (ret == -1) {
         // Failed
-        const int err = errno;
         CB_CONSTEXPR_SV fmt =
             "({}:{}) failed to allocate shared memory for name {}: {}";
         SPDLOG_ERROR(fmt.substr(8), name, strerror(err));
@@ -223,8 +246,8 @@ void SharedMemory::FreeSharedMem() noexcept {
 void SharedMemory::MapSharedMem(std::string_view name) {
 #pragma GCC diagnostic pop
     // Map shared memory to our process's virtual memory
-    void *data = mmap(nullptr, m_TotalSize, PROT_READ | PROT_WRITE, MAP_SHARED,
-                      m_FileDes, 0);
+    const int prot = m_ReadOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+    void *data = mmap(nullptr, m_TotalSize, prot, MAP_SHARED, m_FileDes, 0);
     if (data == MAP_FAILED) {
         // Failed to map
         const int err = errno;
@@ -236,8 +259,26 @@ void SharedMemory::MapSharedMem(std::string_view name) {
 
     SPDLOG_DEBUG("Mapped shared memory {}", name);
 
+    // Offset in bytes, not in counters
     m_RefCounter = reinterpret_cast<int *>(data);
-    m_Data = reinterpret_cast<void *>(m_RefCounter + DATA_OFFSET_BYTES);
+    m_Data = static_cast<std::byte *>(data) + DATA_OFFSET_BYTES;
+}
+
+bool SharedMemory::AdviseHugePages() noexcept {
+    if (m_RefCounter == nullptr) {
+        return false;
+    }
+
+    if (madvise(m_RefCounter, m_TotalSize, MADV_HUGEPAGE) == -1) {
+        // Failed
+        const int err = errno;
+        SPDLOG_WARN("Can't back shared memory {} with huge pages: {}", m_Name,
+                    strerror(err));
+        return false;
+    }
+
+    SPDLOG_DEBUG("Advised huge pages for shared memory {}", m_Name);
+    return true;
 }
 
 void SharedMemory::UnmapSharedMem() noexcept {
@@ -0,0 +1,72 @@
+#include "circularbuffer/SlotReader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Copy.hpp"
+#include "circularbuffer/SlotRing.hpp"
+#include "spdlog/spdlog.h"
+
+namespace CircularBuffer {
+
+SlotReader::SlotReader(const SlotSpec &spec) : SlotRing(spec) {
+    CheckGeometry();
+    m_Next = m_Header->published.load(std::memory_order_acquire);
+}
+
+int SlotReader::Read(BufferT readBuffer) {
+    SlotHeader &slot = SlotAt(m_Next);
+    const uint64_t stamp = 2 * m_Next + 2;
+
+    // Older message, or ours being written
+    const uint64_t before = slot.stamp.load(std::memory_order_acquire);
+    if (before < stamp) {
+        return 0;
+    }
+    if (before > stamp) [[unlikely]] {
+        return Lapped();
+    }
+
+    // The size may already be the next lap's: only trust it once the stamp is
+    // checked again
+    const uint32_t size = slot.size.load(std::memory_order_relaxed);
+    if (size > readBuffer.size_bytes() ||
+        size > static_cast<uint32_t>(m_MaxMessageSize)) [[unlikely]] {
+        if (slot.stamp.load(std::memory_order_acquire) != stamp) {
+            return Lapped();
+        }
+        SPDLOG_ERROR("Read buffer of {} B too small for message of {} B",
+                     readBuffer.size_bytes(), size);
+        return -1;
+    }
+    CopyMessage(readBuffer.data(), Payload(slot), size);
+
+    // Payload copied before the stamp is checked again
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.stamp.load(std::memory_order_relaxed) != stamp) [[unlikely]] {
+        return Lapped();
+    }
+
+    m_Next++;
+    return static_cast<int>(size);
+}
+
+int SlotReader::Lapped() noexcept {
+    // Message `published` is next to go in, over message
+    // `published - slotCount`
+    const uint64_t published =
+        m_Header->published.load(std::memory_order_acquire);
+    const uint64_t oldest =
+        published >= SlotCount() ? published - SlotCount() + 1 : 0;
+    const uint64_t next = std::max(m_Next + 1, oldest);
+
+    m_Lost += next - m_Next;
+    m_Next = next;
+    return INT_MIN;
+}
+
+}  // namespace CircularBuffer
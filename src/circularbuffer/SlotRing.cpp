@@ -0,0 +1,73 @@
+#include "circularbuffer/SlotRing.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <stdexcept>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Macros.hpp"
+#include "circularbuffer/SharedMemory.hpp"
+#include "circularbuffer/Utils.hpp"
+#include "spdlog/spdlog.h"
+
+namespace CircularBuffer {
+
+SlotRing::SlotRing(const SlotSpec &spec)
+    : m_SlotSize(spec.slotSize),
+      m_SlotMask(spec.slotCount - 1),
+      m_SlotShift(std::countr_zero(spec.slotSize)),
+      m_MaxMessageSize(static_cast<MessageSizeT>(
+          std::min<size_t>(MAX_MESSAGE_SIZE,
+                           std::max<size_t>(spec.slotSize, SLOT_HEADER_SIZE) -
+                               SLOT_HEADER_SIZE))) {
+    SetupSpdlog();
+
+    if (!std::has_single_bit(spec.slotSize) ||
+        spec.slotSize < static_cast<size_t>(CACHELINE_SIZE)) {
+        CB_CONSTEXPR_SV fmt =
+            "({}:{}) Slot size {} is not a power of two of at least {}";
+        SPDLOG_ERROR(fmt.substr(8), spec.slotSize, CACHELINE_SIZE);
+        throw std::invalid_argument(std::format(fmt, __FILE__, __LINE__,
+                                                spec.slotSize, CACHELINE_SIZE));
+    }
+    if (!std::has_single_bit(spec.slotCount)) {
+        CB_CONSTEXPR_SV fmt = "({}:{}) Slot count {} is not a power of two";
+        SPDLOG_ERROR(fmt.substr(8), spec.slotCount);
+        throw std::invalid_argument(
+            std::format(fmt, __FILE__, __LINE__, spec.slotCount));
+    }
+
+    // Header, then the slots, all on their own cachelines
+    static_assert(sizeof(SlotRingHeader) % CACHELINE_SIZE == 0);
+    m_Region = new SharedMemory(spec.sharedMemoryName,
+                                sizeof(SlotRingHeader) +
+                                    spec.slotCount * spec.slotSize);
+    m_Header = reinterpret_cast<SlotRingHeader *>(
+        m_Region->AsSpan<DataT>().data());
+    m_Slots = reinterpret_cast<DataT *>(m_Header) + sizeof(SlotRingHeader);
+}
+
+SlotRing::~SlotRing() { delete m_Region; }
+
+void SlotRing::CheckGeometry() const {
+    const uint64_t slotSize =
+        m_Header->slotSize.load(std::memory_order_acquire);
+    const uint64_t slotCount =
+        m_Header->slotCount.load(std::memory_order_acquire);
+    if (slotSize == 0 || (slotSize == m_SlotSize && slotCount == SlotCount())) {
+        return;
+    }
+
+    // Same size in shared memory, different slots
+    CB_CONSTEXPR_SV fmt =
+        "({}:{}) Ring has {} slots of {} B, expected {} slots of {} B";
+    SPDLOG_ERROR(fmt.substr(8), slotCount, slotSize, SlotCount(), m_SlotSize);
+    throw std::invalid_argument(std::format(fmt, __FILE__, __LINE__, slotCount,
+                                            slotSize, SlotCount(), m_SlotSize));
+}
+
+}  // namespace CircularBuffer
@@ -0,0 +1,62 @@
+#include "circularbuffer/SlotWriter.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <stdexcept>
+#include <string>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Copy.hpp"
+#include "circularbuffer/SlotRing.hpp"
+#include "spdlog/spdlog.h"
+
+namespace CircularBuffer {
+
+SlotWriter::SlotWriter(const SlotSpec &spec)
+    : SlotRing(spec), m_SemLock(MakeSemName(spec)) {
+    if (!m_SemLock.Acquire()) {
+        throw std::logic_error(std::format(
+            "({}:{}) Another writer has locked the semaphore \"{}\"", __FILE__,
+            __LINE__, m_SemLock.Name()));
+    }
+    CheckGeometry();
+
+    // Stamps must keep increasing under readers of a previous writer, so
+    // continue its message numbers. A slot it left half-written is simply
+    // written again.
+    m_Next = m_Header->published.load(std::memory_order_acquire);
+    m_Header->slotSize.store(m_SlotSize, std::memory_order_relaxed);
+    m_Header->slotCount.store(SlotCount(), std::memory_order_release);
+}
+
+bool SlotWriter::Write(BufferT writeBuffer) {
+    if (writeBuffer.size_bytes() > static_cast<size_t>(m_MaxMessageSize))
+        [[unlikely]] {
+        SPDLOG_ERROR("Can't write message of size {} B: max size is {} B",
+                     writeBuffer.size_bytes(), m_MaxMessageSize);
+        return false;
+    }
+
+    // Seqlock write: odd stamp, payload, even stamp. The fence keeps the odd
+    // stamp ahead of the payload for readers checking the stamp after copying.
+    SlotHeader &slot = SlotAt(m_Next);
+    const uint64_t stamp = 2 * m_Next + 1;
+    slot.stamp.store(stamp, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.size.store(writeBuffer.size_bytes(), std::memory_order_relaxed);
+    CopyMessage(Payload(slot), writeBuffer.data(), writeBuffer.size_bytes());
+    slot.stamp.store(stamp + 1, std::memory_order_release);
+
+    // Only for readers starting up or catching up after being lapped
+    m_Header->published.store(++m_Next, std::memory_order_release);
+    return true;
+}
+
+std::string SlotWriter::MakeSemName(const SlotSpec &spec) {
+    return spec.sharedMemoryName + "-writer";
+}
+
+}  // namespace CircularBuffer
@@ -0,0 +1,106 @@
+#include "circularbuffer/SpscQueue.hpp"
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <span>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Copy.hpp"
+
+namespace CircularBuffer {
+
+namespace {
+
+// Records are [uint32 size][message], padded to 8 bytes so sizes are aligned
+using RecordHeaderT = uint32_t;
+constexpr uint64_t RECORD_ALIGNMENT = 8;
+// Written in place of a size when the next record continues at the start
+constexpr RecordHeaderT SKIP_MARKER = UINT32_MAX;
+
+}  // namespace
+
+SpscQueue::SpscQueue(size_t capacity)
+    : m_Capacity(std::bit_ceil(capacity < MIN_CAPACITY ? MIN_CAPACITY
+                                                       : capacity)) {
+    m_Data = new (std::align_val_t(CACHELINE_SIZE)) DataT[m_Capacity];
+}
+
+SpscQueue::~SpscQueue() {
+    ::operator delete[](m_Data, std::align_val_t(CACHELINE_SIZE));
+}
+
+uint64_t SpscQueue::RecordSize(size_t size) noexcept {
+    return (sizeof(RecordHeaderT) + size + RECORD_ALIGNMENT - 1) &
+           ~(RECORD_ALIGNMENT - 1);
+}
+
+bool SpscQueue::TryPush(std::span<const DataT> message) noexcept {
+    const uint64_t tail = m_Tail.load(std::memory_order_relaxed);
+    const uint64_t index = tail & (m_Capacity - 1);
+    const uint64_t spaceToEnd = m_Capacity - index;
+    const uint64_t recordSize = RecordSize(message.size_bytes());
+
+    // Skip the end of the buffer if the record doesn't fit there
+    const uint64_t skip = recordSize <= spaceToEnd ? 0 : spaceToEnd;
+    const uint64_t needed = skip + recordSize;
+
+    // Check for space, only reloading the consumer position if needed
+    if (tail + needed - m_CachedHead > m_Capacity) {
+        m_CachedHead = m_Head.load(std::memory_order_acquire);
+        if (tail + needed - m_CachedHead > m_Capacity) {
+            return false;
+        }
+    }
+
+    DataT *record = m_Data + index;
+    if (skip != 0) {
+        std::memcpy(record, &SKIP_MARKER, sizeof(RecordHeaderT));
+        record = m_Data;
+    }
+
+    const RecordHeaderT size = message.size_bytes();
+    std::memcpy(record, &size, sizeof(RecordHeaderT));
+    CopyMessage(record + sizeof(RecordHeaderT), message.data(), size);
+
+    m_Tail.store(tail + needed, std::memory_order_release);
+    return true;
+}
+
+bool SpscQueue::Front(std::span<const DataT> &message) noexcept {
+    uint64_t head = m_Head.load(std::memory_order_relaxed);
+
+    // Check for data, only reloading the producer position if needed
+    if (head == m_CachedTail) {
+        m_CachedTail = m_Tail.load(std::memory_order_acquire);
+        if (head == m_CachedTail) {
+            return false;
+        }
+    }
+
+    uint64_t index = head & (m_Capacity - 1);
+    RecordHeaderT size;
+    std::memcpy(&size, m_Data + index, sizeof(RecordHeaderT));
+
+    // Record continues at start of buffer
+    if (size == SKIP_MARKER) {
+        head += m_Capacity - index;
+        m_Head.store(head, std::memory_order_release);
+        index = 0;
+        std::memcpy(&size, m_Data, sizeof(RecordHeaderT));
+    }
+
+    message = {m_Data + index + sizeof(RecordHeaderT), size};
+    m_FrontRecordSize = RecordSize(size);
+    return true;
+}
+
+void SpscQueue::Pop() noexcept {
+    m_Head.store(m_Head.load(std::memory_order_relaxed) + m_FrontRecordSize,
+                 std::memory_order_release);
+}
+
+}  // namespace CircularBuffer
@@ -0,0 +1,68 @@
+#include "circularbuffer/Trace.hpp"
+
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <exception>
+#include <string_view>
+
+#include "circularbuffer/Clock.hpp"
+#include "circularbuffer/SharedMemory.hpp"
+#include "circularbuffer/Utils.hpp"
+#include "spdlog/spdlog.h"
+
+namespace CircularBuffer {
+
+std::atomic<TraceRing *> Tracer::s_Ring{nullptr};
+SharedMemory *Tracer::s_Region{nullptr};
+
+bool Tracer::Start(std::string_view name) noexcept {
+    SetupSpdlog();
+    if (s_Region != nullptr) {
+        SPDLOG_ERROR("Can't trace into {}: already tracing into {}", name,
+                     s_Region->Name());
+        return false;
+    }
+
+    try {
+        s_Region = new SharedMemory(name, sizeof(TraceRing));
+    } catch (const std::exception &e) {
+        SPDLOG_ERROR("Can't trace into {}: {}", name, e.what());
+        return false;
+    }
+    TraceRing *ring = s_Region->AsStruct<TraceRing>();
+
+    // Calibrate once per process
+    static const double nanosPerTick = CalibrateTsc();
+    ring->pid.store(getpid(), std::memory_order_relaxed);
+    ring->nanosPerTick.store(nanosPerTick, std::memory_order_relaxed);
+    ring->startTicks.store(ReadClock(ClockSource::TSC),
+                           std::memory_order_relaxed);
+    ring->startNanos.store(MonotonicNanos(), std::memory_order_relaxed);
+
+    // Drop records left by a previous process, which are on another timeline
+    for (TraceRecord &record : ring->records) {
+        record.stamp.store(0, std::memory_order_relaxed);
+    }
+    ring->head.store(0, std::memory_order_relaxed);
+    s_Ring.store(ring, std::memory_order_release);
+    SPDLOG_INFO("Tracing into {}", name);
+    return true;
+}
+
+void Tracer::Stop() noexcept {
+    s_Ring.store(nullptr, std::memory_order_release);
+    delete s_Region;
+    s_Region = nullptr;
+}
+
+void Tracer::StartFromEnvironment() noexcept {
+    static const bool started = [] {
+        const char *name = std::getenv("CB_TRACE");
+        return name != nullptr && *name != '\0' && Start(name);
+    }();
+    static_cast<void>(started);
+}
+
+}  // namespace CircularBuffer
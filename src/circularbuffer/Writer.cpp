@@ -1,79 +1,301 @@
 #include "circularbuffer/Writer.hpp"
 
+#include <poll.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <cstdint>
 #include <cstring>
+#include <exception>
 #include <format>
+#include <mutex>
 #include <stdexcept>
+#include <thread>
 
 #include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Clock.hpp"
+#include "circularbuffer/Copy.hpp"
+#include "circularbuffer/EventBridge.hpp"
 #include "circularbuffer/IWrapper.hpp"
+#include "circularbuffer/Macros.hpp"
+#include "circularbuffer/Probes.hpp"
+#include "circularbuffer/SeekIndex.hpp"
 #include "circularbuffer/SemaphoreLock.hpp"
+#include "circularbuffer/SharedMemory.hpp"
+#include "circularbuffer/SizeField.hpp"
 #include "circularbuffer/Spec.hpp"
+#include "circularbuffer/State.hpp"
+#include "circularbuffer/Stats.hpp"
+#include "circularbuffer/Trace.hpp"
 #include "circularbuffer/Utils.hpp"
 #include "spdlog/common.h"
 #include "spdlog/spdlog.h"
 
 namespace CircularBuffer {
 
-Writer::Writer(const Spec& spec)
-    : IWrapper(spec), m_SemLock(MakeSemName(spec)) {
+namespace {
+
+// Records up to this size are assembled on the stack and written to the buffer
+// with a single fused copy
+constexpr int FUSED_RECORD_MAX = 32;
+static_assert(FUSED_RECORD_MAX >= MAX_HEADER_SIZE);
+
+// Copies message data into the buffer, bypassing the cache for large messages
+inline void CopyPayload(DataT* dst, const DataT* src, size_t size,
+                        bool streaming) noexcept {
+    if (streaming) {
+        StreamingCopy(dst, src, size);
+    } else {
+        CopyMessage(dst, src, size);
+    }
+}
+
+// How often a standby writer checks on a writer without a heartbeat
+constexpr int STANDBY_POLL_MS = 100;
+
+// Opens a pidfd for process `pid`, -1 if unavailable
+int OpenPidFd(pid_t pid) noexcept {
+#ifdef SYS_pidfd_open
+    return static_cast<int>(syscall(SYS_pidfd_open, pid, 0));
+#else
+    return -1;
+#endif
+}
+
+// True if process `pid` has exited, waiting up to `timeoutMs` for it. Uses its
+// pidfd unless -1, otherwise falls back to signal checks.
+bool WaitForExit(pid_t pid, int pidFd, int timeoutMs) noexcept {
+    if (pidFd != -1) {
+        pollfd pidPoll{pidFd, POLLIN, 0};
+        return poll(&pidPoll, 1, timeoutMs) == 1;
+    }
+    if (kill(pid, 0) == -1 && errno == ESRCH) {
+        return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(timeoutMs));
+    return false;
+}
+
+// Kills process `pid`, through its pidfd unless -1 so that a reused pid is
+// never hit
+void Kill(pid_t pid, int pidFd) noexcept {
+    int ret;
+#ifdef SYS_pidfd_send_signal
+    if (pidFd != -1) {
+        ret = static_cast<int>(
+            syscall(SYS_pidfd_send_signal, pidFd, SIGKILL, nullptr, 0));
+    } else
+#endif
+    {
+        ret = kill(pid, SIGKILL);
+    }
+    if (ret == -1) {
+        const int err = errno;
+        SPDLOG_ERROR("Failed to kill writer {}: {}", pid, strerror(err));
+    }
+}
+
+}  // namespace
+
+template <typename Ring>
+SpecWriter<Ring>::SpecWriter(const Spec& spec)
+    : IWrapper(spec),
+      m_SemLock(MakeSemName(spec)),
+      m_StreamingThreshold(spec.streamingStoreThreshold),
+      m_StatsEnabled(spec.enableStats),
+      m_ReplayEnabled(spec.enableReplay),
+      m_ConflationEnabled(spec.enableConflation),
+      m_SeekInterval(spec.seekInterval),
+      m_NotifyEnabled(spec.enableNotifications) {
     SetupSpdlog();
-    EnsureSingleton();
+    ValidateAlignment(spec);
+    ValidateFeatures(spec);
+    if (spec.standby) {
+        AwaitTakeover();
+    } else {
+        EnsureSingleton(spec.resume);
+    }
 
-    // Writer sets initial shared buffer iterators
-    m_State->readIdx.store(0, std::memory_order_release);
-    m_State->writeIdx.store(0, std::memory_order_release);
-    m_State->seqNum.store(0, std::memory_order_release);
+    // Writer decides record framing
+    SetFraming(spec.sizeField, spec.timestamps, m_SeekInterval != 0,
+               static_cast<int>(spec.recordAlignment), spec.contiguousRecords);
+    UpdateMaxMessageSize();
 
-    m_NextElement = m_CircularBuffer.begin();
+    // Continue the previous writer's stream, or start a new one
+    const bool resumed = (spec.resume || spec.standby) && Resume();
+    if (!resumed) {
+        Reset();
+    }
+
+    // Carry on from the newest record a resumed writer published, rounding
+    // up a version it died in the middle of
+    Latest& latest = m_State->latest;
+    m_LatestVersion =
+        (latest.version.load(std::memory_order_relaxed) + 1) & ~uint64_t{1};
+    latest.enabled.store(m_ConflationEnabled, std::memory_order_release);
+
+    // Readers may already be armed from a previous writer
+    m_State->notification.enabled.store(m_NotifyEnabled,
+                                        std::memory_order_release);
+    m_State->stats.enabled.store(m_StatsEnabled, std::memory_order_release);
+
+    // Announce ourselves last: a new generation means the state was reset
+    Liveness& liveness = m_State->liveness;
+    liveness.heartbeatMs.store(spec.heartbeatMs, std::memory_order_relaxed);
+    liveness.heartbeat.store(MonotonicNanos(), std::memory_order_relaxed);
+    liveness.writerPid.store(getpid(), std::memory_order_release);
+    if (!resumed) {
+        liveness.generation.fetch_add(1, std::memory_order_release);
+    }
+    if (spec.heartbeatMs != 0) {
+        m_HeartbeatThread =
+            std::thread(&SpecWriter::Heartbeat, this, spec.heartbeatMs);
+    }
+
+    m_NextElement = m_CircularBuffer.begin() + m_LocalIndex;
 }
 
-Writer::~Writer() {
+template <typename Ring>
+SpecWriter<Ring>::~SpecWriter() {
+    if (m_HeartbeatThread.joinable()) {
+        {
+            std::lock_guard lock(m_HeartbeatMutex);
+            m_HeartbeatStop = true;
+        }
+        m_HeartbeatCv.notify_one();
+        m_HeartbeatThread.join();
+    }
+
+    // Clean shutdown
+    m_State->liveness.writerPid.store(0, std::memory_order_release);
+
     if (!m_SemLock.Release()) {
         SPDLOG_ERROR("Failed to unlock writer semaphore \"{}\"",
                      m_SemLock.Name());
     }
 }
 
-bool Writer::Write(BufferT writeBuffer) {
+template <typename Ring>
+bool SpecWriter<Ring>::Write(BufferT writeBuffer) {
     static_assert(HEADER_SIZE <= sizeof(int));
 
     // Validate incoming message size
-    if (writeBuffer.size_bytes() > MAX_MESSAGE_SIZE) [[unlikely]] {
+    if (writeBuffer.size_bytes() > static_cast<size_t>(m_MaxMessageSize))
+        [[unlikely]] {
         SPDLOG_ERROR("Can't write message of size {} B: max size is {} B",
-                     writeBuffer.size_bytes(), MAX_MESSAGE_SIZE);
+                     writeBuffer.size_bytes(), m_MaxMessageSize);
         return false;
     }
 
     // Compute some values we'll need
     const MessageSizeT msgSize = writeBuffer.size_bytes();
-    const int totalBytesToWrite = HEADER_SIZE + msgSize;
-    const int spaceToEnd = m_CircularBuffer.size_bytes() - m_LocalIndex;
+    const int payloadOffset = PayloadOffset(msgSize);
+    const int recordBytes = payloadOffset + msgSize;
+    const int totalBytesToWrite = RecordSize(msgSize);
+    // 64-bit, as buffers may be bigger than 2 GiB
+    const IndexT spaceToEnd = m_CircularBuffer.size_bytes() - m_LocalIndex;
+    const bool headerFits = spaceToEnd >= static_cast<IndexT>(m_PayloadOffset);
+    const bool streaming = m_StreamingThreshold != 0 &&
+                           static_cast<size_t>(msgSize) >= m_StreamingThreshold;
+    const IndexT recordIndex = m_LocalIndex;
+    const SeqNumT recordSeqNum = m_LocalSeqNum;
+    CB_PROBE(write_reserve, recordSeqNum, recordIndex, msgSize);
+
+    // Build header: message size, followed by optional timestamp and message
+    // number. Tiny messages are appended so the record can be written in one
+    // go. The buffer is zeroed so fused records carry zero padding and unused
+    // size bytes rather than stale stack contents.
+    DataT header[FUSED_RECORD_MAX]{};
+    const int fieldBytes = EncodeSize(m_SizeField, msgSize, header);
+    const int headerSize = m_HeaderSize - m_SizeFieldBytes + fieldBytes;
+    if (m_Clock != ClockSource::None) {
+        const TimestampT timestamp = ReadClock(m_Clock);
+        std::memcpy(header + fieldBytes, &timestamp, TIMESTAMP_SIZE);
+    }
+    if (m_MessageNumbers) {
+        std::memcpy(header + headerSize - MESSAGE_NUMBER_SIZE,
+                    &m_MessageNumber, MESSAGE_NUMBER_SIZE);
+    }
+
+    // Records that don't fit start over at the start of the buffer if the
+    // header can't fit, or if they are kept contiguous
+    const bool skipToStart =
+        static_cast<IndexT>(totalBytesToWrite) > spaceToEnd &&
+        (!headerFits || m_ContiguousRecords);
+
+    // Evict records from the tail before overwriting them, along with the
+    // space skipped at the end of the buffer
+    if (m_ReplayEnabled) {
+        AdvanceTail(skipToStart ? static_cast<int>(spaceToEnd) +
+                                      totalBytesToWrite
+                                : totalBytesToWrite);
+    }
 
     // Compute the end of the next write region
     m_LocalIndex += totalBytesToWrite;
 
     // Enough space to write
-    if (totalBytesToWrite <= spaceToEnd) [[likely]] {
+    if (static_cast<IndexT>(totalBytesToWrite) <= spaceToEnd) [[likely]] {
         // Advance write index to "reserve" buffer space
         m_State->writeIdx.store(m_LocalIndex, std::memory_order_release);
 
-        // Write message size and data
-        std::memcpy(m_NextElement.base(), &msgSize, HEADER_SIZE);
-        std::memcpy(m_NextElement.base() + HEADER_SIZE, writeBuffer.data(),
-                    msgSize);
+        // Write header and message data
+        if (recordBytes <= FUSED_RECORD_MAX) {
+            CopySmall(header + payloadOffset, writeBuffer.data(), msgSize);
+            CopySmall(m_NextElement.base(), header, recordBytes);
+        } else {
+            CopySmall(m_NextElement.base(), header, headerSize);
+            CopyPayload(m_NextElement.base() + payloadOffset,
+                        writeBuffer.data(), msgSize, streaming);
+        }
 
         // Advance next write element
         m_NextElement += totalBytesToWrite;
     }
     // Wrapping around
     else {
-        // Can fit header
-        if (spaceToEnd >= HEADER_SIZE) [[likely]] {
+        Tracer::Record(TraceEvent::Wrap, recordIndex, spaceToEnd);
+        CB_PROBE(wraparound, recordIndex, spaceToEnd);
+
+        // Contiguous records: leave a copy of the header as a skip record, and
+        // write the record at the start of the buffer. The skipped space
+        // counts towards the sequence number, so that readers detect
+        // overwrites of the record exactly.
+        if (skipToStart && headerFits) {
+            // Move write index to "reserve" buffer space
+            m_LocalIndex = totalBytesToWrite;
+            m_State->writeIdx.store(m_LocalIndex, std::memory_order_release);
+
+            // Write skip record, then header and message
+            CopySmall(m_NextElement.base(), header, headerSize);
+            m_NextElement = m_CircularBuffer.begin();
+            CopySmall(m_NextElement.base(), header, headerSize);
+            CopyPayload(m_NextElement.base() + payloadOffset,
+                        writeBuffer.data(), msgSize, streaming);
+
+            // Advance next write element
+            m_NextElement += totalBytesToWrite;
+            m_LocalSeqNum += spaceToEnd;
+
+            SPDLOG_DEBUG("Wrapped around - skipped end of buffer");
+        }
+        // Can fit header. Always the case for aligned records, as the space
+        // left is a multiple of the alignment.
+        else if (headerFits) [[likely]] {
             // Compute index after wraparound
             m_LocalIndex %= m_CircularBuffer.size_bytes();
 
+            // Less than a record is left before the end
+            const int bytesToEnd = static_cast<int>(spaceToEnd);
             // Track bytes left to write
             int bytesRemaining = totalBytesToWrite;
 #ifdef DEBUG
@@ -85,33 +307,35 @@ bool Writer::Write(BufferT writeBuffer) {
             m_State->writeIdx.store(m_LocalIndex, std::memory_order_release);
 
             // Write header and first part of message
-            std::memcpy(m_NextElement.base(), &msgSize, HEADER_SIZE);
-            std::memcpy(m_NextElement.base() + HEADER_SIZE, writeBuffer.data(),
-                        spaceToEnd - HEADER_SIZE);
+            const int firstPartSize = bytesToEnd - payloadOffset;
+            CopySmall(m_NextElement.base(), header, headerSize);
+            CopyPayload(m_NextElement.base() + payloadOffset,
+                        writeBuffer.data(), firstPartSize, streaming);
 
             // Move pointer to start of buffer
             m_NextElement = m_CircularBuffer.begin();
             // Decrement write countdown
-            bytesRemaining -= spaceToEnd;
+            bytesRemaining -= bytesToEnd;
 
 #ifdef DEBUG
             // Write exactly what was passed to std::memcpy
-            bytesWritten += HEADER_SIZE;
-            bytesWritten += (spaceToEnd - HEADER_SIZE);
+            bytesWritten += payloadOffset;
+            bytesWritten += firstPartSize;
 #endif
 
-            // Write rest of message
-            std::memcpy(m_NextElement.base(),
-                        writeBuffer.data() + bytesRemaining, bytesRemaining);
+            // Write rest of message, skipping trailing padding
+            const int secondPartSize = msgSize - firstPartSize;
+            CopyPayload(m_NextElement.base(), writeBuffer.data() + firstPartSize,
+                        secondPartSize, streaming);
 
             m_NextElement += bytesRemaining;
 
 #ifdef DEBUG
-            bytesWritten += bytesRemaining;
+            bytesWritten += secondPartSize;
             // Make sure we wrote the correct amount of bytes
-            assert(bytesWritten == totalBytesToWrite);
+            assert(bytesWritten == recordBytes);
             // Make sure we tracked remaining bytes correctly
-            assert(bytesRemaining == totalBytesToWrite - spaceToEnd);
+            assert(bytesRemaining == totalBytesToWrite - bytesToEnd);
 #endif
 
             SPDLOG_DEBUG("Wrapped around - split write");
@@ -120,16 +344,16 @@ bool Writer::Write(BufferT writeBuffer) {
         // know to wrap around
         else {
             // Move write index to "reserve" buffer space
-            m_LocalIndex = msgSize + HEADER_SIZE;
+            m_LocalIndex = totalBytesToWrite;
             m_State->writeIdx.store(m_LocalIndex, std::memory_order_release);
 
             // Move write location to beginning of buffer
             m_NextElement = m_CircularBuffer.begin();
 
             // Write header and message
-            std::memcpy(m_NextElement.base(), &msgSize, HEADER_SIZE);
-            std::memcpy(m_NextElement.base() + HEADER_SIZE, writeBuffer.data(),
-                        msgSize);
+            CopySmall(m_NextElement.base(), header, headerSize);
+            CopyPayload(m_NextElement.base() + payloadOffset,
+                        writeBuffer.data(), msgSize, streaming);
 
             // Advance next write element
             m_NextElement += totalBytesToWrite;
@@ -143,27 +367,665 @@ bool Writer::Write(BufferT writeBuffer) {
     assert(m_NextElement.base() == &m_CircularBuffer[m_State->writeIdx]);
 #endif
 
+    // Non-temporal stores are weakly ordered, so they must be fenced before
+    // the release stores below publish them
+    if (streaming) {
+        StoreFence();
+    }
+
     // Update write sequence number
     m_LocalSeqNum += totalBytesToWrite;
     m_State->seqNum.store(m_LocalSeqNum, std::memory_order_release);
 
     // Advance read index to indicate that it's safe to read
     m_State->readIdx.store(m_LocalIndex, std::memory_order_release);
+    Tracer::Record(TraceEvent::Publish, recordIndex, msgSize);
+    CB_PROBE(write_publish, recordSeqNum, recordIndex, msgSize);
+
+    if (m_ConflationEnabled) {
+        PublishLatest(recordIndex, recordSeqNum);
+    }
+
+    // Wake readers waiting for this write
+    if constexpr (Wait::NOTIFIES) {
+        if (m_NotifyEnabled) {
+            Wait::Notify(m_State->notification);
+        }
+    }
+
+    // Statistics are published after the write so they stay off the critical
+    // path
+    if constexpr (Instrumentation::SHARED_STATS) {
+        if (m_StatsEnabled) {
+            UpdateStats(msgSize,
+                        static_cast<IndexT>(totalBytesToWrite) > spaceToEnd);
+        }
+    }
+
+    if (m_MessageNumbers) {
+        if (--m_SeekCountdown == 0) {
+            UpdateSeekIndex(recordIndex, recordSeqNum);
+            m_SeekCountdown = m_SeekInterval;
+        }
+        m_MessageNumber++;
+    }
 
     SPDLOG_DEBUG("Wrte message of size {} bytes", msgSize);
     return true;
 }
 
-std::string Writer::MakeSemName(const Spec& spec) {
+template <typename Ring>
+bool SpecWriter<Ring>::Grow(size_t capacity) {
+    const size_t previousCapacity = m_CircularBuffer.size_bytes();
+    if (capacity <= previousCapacity ||
+        capacity > m_CapacityLimit ||
+        capacity % m_RecordAlignment != 0) [[unlikely]] {
+        SPDLOG_ERROR(
+            "Can't grow {} B buffer to {} B: must be bigger, at most {} B and "
+            "a multiple of the {} B record alignment",
+            previousCapacity, capacity, m_CapacityLimit,
+            m_RecordAlignment);
+        return false;
+    }
+
+    // Map the new region first, so that failing leaves the stream untouched
+    const uint64_t generation = m_DataGeneration + 1;
+    SharedMemory* previousRegion;
+    const BufferT previous = m_CircularBuffer;
+    try {
+        previousRegion = ReplaceDataRegion(generation, capacity, false);
+    } catch (const std::exception& e) {
+        SPDLOG_ERROR("Can't grow buffer to {} B: {}", capacity, e.what());
+        return false;
+    }
+
+    // Mark the end of the old region where the next record would have gone.
+    // Readers still in it read up to the marker, then follow. It isn't
+    // numbered, but carries a timestamp like any other record.
+    IndexT markerIndex = m_LocalIndex;
+    if (previousCapacity - markerIndex < static_cast<IndexT>(m_PayloadOffset)) {
+        markerIndex = 0;
+    }
+    DataT header[MAX_HEADER_SIZE]{};
+    const int fieldBytes = EncodeSize(m_SizeField, GROW_MARKER, header);
+    if (m_Clock != ClockSource::None) {
+        const TimestampT timestamp = ReadClock(m_Clock);
+        std::memcpy(header + fieldBytes, &timestamp, TIMESTAMP_SIZE);
+    }
+    std::memcpy(&previous[markerIndex], header,
+                m_HeaderSize - m_SizeFieldBytes + fieldBytes);
+    m_LocalSeqNum += RecordSize(0);
+    m_State->seqNum.store(m_LocalSeqNum, std::memory_order_release);
+
+    // Publish the new region before moving the indices into it
+    DataRegion& region = m_State->region;
+    region.capacity.store(capacity, std::memory_order_relaxed);
+    region.baseSeqNum.store(m_LocalSeqNum, std::memory_order_relaxed);
+    region.baseMessageNumber.store(m_MessageNumber, std::memory_order_relaxed);
+    region.generation.store(generation, std::memory_order_release);
+    m_State->stats.capacity.store(capacity, std::memory_order_relaxed);
+
+    UpdateMaxMessageSize();
+
+    // Nothing before the new region can be replayed
+    m_LocalIndex = 0;
+    m_NextElement = m_CircularBuffer.begin();
+    if (m_ReplayEnabled) {
+        m_TailIndex = 0;
+        m_TailSeqNum = m_LocalSeqNum;
+        PublishTail();
+    }
+    m_State->writeIdx.store(0, std::memory_order_release);
+    m_State->readGeneration.store(generation, std::memory_order_relaxed);
+    m_State->readIdx.store(0, std::memory_order_release);
+    if constexpr (Wait::NOTIFIES) {
+        if (m_NotifyEnabled) {
+            Wait::Notify(m_State->notification);
+        }
+    }
+
+    // Readers that haven't followed yet keep the old region alive
+    delete previousRegion;
+
+    Tracer::Record(TraceEvent::Grow, capacity, generation);
+    SPDLOG_INFO("Grew buffer from {} B to {} B", previousCapacity, capacity);
+    return true;
+}
+
+template <typename Ring>
+std::string SpecWriter<Ring>::MakeSemName(const Spec& spec) {
     return spec.dataSharedMemoryName + "-writer";
 }
 
-void Writer::EnsureSingleton() {
-    if (!m_SemLock.Acquire()) {
-        throw std::logic_error(std::format(
-            "({}:{}) Another writer has locked the semaphore \"{}\"", __FILE__,
-            __LINE__, m_SemLock.Name()));
+template <typename Ring>
+void SpecWriter<Ring>::UpdateStats(MessageSizeT msgSize,
+                                   bool wrapped) noexcept {
+    // Single writer: no need for RMW operations, just store local counters
+    Stats& stats = m_State->stats;
+
+    stats.messages.store(++m_StatMessages, std::memory_order_relaxed);
+    m_StatBytes += msgSize;
+    stats.bytes.store(m_StatBytes, std::memory_order_relaxed);
+
+    if (wrapped) {
+        stats.wraps.store(++m_StatWraps, std::memory_order_relaxed);
+    }
+
+    if (static_cast<uint64_t>(msgSize) > m_StatMaxMessageSize) {
+        m_StatMaxMessageSize = msgSize;
+        stats.maxMessageSize.store(m_StatMaxMessageSize,
+                                   std::memory_order_relaxed);
     }
 }
 
+template <typename Ring>
+void SpecWriter<Ring>::UpdateMaxMessageSize() noexcept {
+    m_MaxMessageSize =
+        std::min(MAX_MESSAGE_SIZE, MaxEncodableSize(m_SizeField));
+
+    // A contiguous record no bigger than half the buffer never overwrites its
+    // own skip record
+    if (m_ContiguousRecords) {
+        const int halfCapacity = static_cast<int>(std::min<size_t>(
+            (m_CircularBuffer.size_bytes() / 2) & -m_RecordAlignment,
+            INT_MAX));
+        m_MaxMessageSize =
+            std::min(m_MaxMessageSize, halfCapacity - m_PayloadOffset);
+    }
+}
+
+template <typename Ring>
+void SpecWriter<Ring>::AdvanceTail(int overwriteBytes) noexcept {
+    const IndexT capacity = m_CircularBuffer.size_bytes();
+    IndexT tailIndex = m_TailIndex;
+    SeqNumT tailSeqNum = m_TailSeqNum;
+
+    // Walk the headers of the oldest records, which we wrote ourselves, until
+    // we reach one that starts past the region about to be written. A record
+    // starting exactly at its end is evicted too, so that the tail only
+    // coincides with the write index when the buffer is empty.
+    while (tailSeqNum != m_LocalSeqNum) {
+        // Header can't fit - record is at start of buffer
+        if (capacity - tailIndex < static_cast<IndexT>(m_PayloadOffset)) {
+            tailIndex = 0;
+        }
+
+        IndexT distance = tailIndex + capacity - m_LocalIndex;
+        if (distance >= capacity) {
+            distance -= capacity;
+        }
+        if (distance > static_cast<IndexT>(overwriteBytes)) {
+            break;
+        }
+
+        int fieldBytes;
+        const MessageSizeT msgSize = LoadSize(tailIndex, fieldBytes);
+
+        // Skip record - record is at start of buffer
+        if (IsSkipRecord(tailIndex, msgSize)) {
+            tailSeqNum += capacity - tailIndex;
+            tailIndex = 0;
+            continue;
+        }
+
+        const int recordSize = RecordSize(msgSize);
+
+        // Split records continue at start of buffer
+        tailIndex += recordSize;
+        if (tailIndex >= capacity) {
+            tailIndex -= capacity;
+        }
+        tailSeqNum += recordSize;
+    }
+
+    if (tailSeqNum == m_TailSeqNum) {
+        return;
+    }
+    m_TailIndex = tailIndex;
+    m_TailSeqNum = tailSeqNum;
+    PublishTail();
+}
+
+template <typename Ring>
+void SpecWriter<Ring>::PublishTail() noexcept {
+    // Publish under seqlock so readers never see a torn index/sequence pair
+    Tail& tail = m_State->tail;
+    tail.version.store(++m_TailVersion, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    tail.index.store(m_TailIndex, std::memory_order_relaxed);
+    tail.seqNum.store(m_TailSeqNum, std::memory_order_relaxed);
+    tail.version.store(++m_TailVersion, std::memory_order_release);
+}
+
+template <typename Ring>
+void SpecWriter<Ring>::PublishLatest(IndexT index, SeqNumT seqNum) noexcept {
+    // Same as the tail: odd version while the fields are being updated
+    Latest& latest = m_State->latest;
+    latest.version.store(++m_LatestVersion, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    latest.generation.store(m_DataGeneration, std::memory_order_relaxed);
+    latest.index.store(index, std::memory_order_relaxed);
+    latest.seqNum.store(seqNum, std::memory_order_relaxed);
+    latest.version.store(++m_LatestVersion, std::memory_order_release);
+}
+
+template <typename Ring>
+void SpecWriter<Ring>::UpdateSeekIndex(IndexT index, SeqNumT seqNum) noexcept {
+    SeekEntry& entry =
+        m_State->seekIndex
+            .entries[(m_MessageNumber / m_SeekInterval) % SEEK_INDEX_SIZE];
+
+    // Publish under seqlock so readers never see a torn entry
+    const uint64_t version = entry.version.load(std::memory_order_relaxed);
+    entry.version.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    entry.messageNumber.store(m_MessageNumber, std::memory_order_relaxed);
+    entry.index.store(index, std::memory_order_relaxed);
+    entry.seqNum.store(seqNum, std::memory_order_relaxed);
+    entry.version.store(version + 2, std::memory_order_release);
+}
+
+template <typename Ring>
+void SpecWriter<Ring>::Heartbeat(size_t heartbeatMs) noexcept {
+    std::unique_lock lock(m_HeartbeatMutex);
+    while (!m_HeartbeatCv.wait_for(lock, std::chrono::milliseconds(heartbeatMs),
+                                   [this] { return m_HeartbeatStop; })) {
+        m_State->liveness.heartbeat.store(MonotonicNanos(),
+                                          std::memory_order_release);
+    }
+}
+
+template <typename Ring>
+void SpecWriter<Ring>::ValidateAlignment(const Spec& spec) {
+    const size_t alignment = spec.recordAlignment;
+    if (alignment <= 1) {
+        return;
+    }
+
+    const size_t headerSize =
+        MaxSizeFieldBytes(spec.sizeField) +
+        (spec.timestamps != ClockSource::None ? TIMESTAMP_SIZE : 0) +
+        (spec.seekInterval != 0 ? MESSAGE_NUMBER_SIZE : 0);
+    const bool powerOfTwo = (alignment & (alignment - 1)) == 0;
+    if (!powerOfTwo || alignment < headerSize ||
+        alignment > static_cast<size_t>(MAX_MESSAGE_SIZE) ||
+        m_CircularBuffer.size_bytes() % alignment != 0) {
+        CB_CONSTEXPR_SV fmt =
+            "({}:{}) Record alignment of {} B is invalid: must be a power of "
+            "two no smaller than the {} B header that divides the {} B buffer";
+        SPDLOG_ERROR(fmt.substr(8), alignment, headerSize,
+                     m_CircularBuffer.size_bytes());
+        throw std::invalid_argument(std::format(fmt, __FILE__, __LINE__,
+                                                alignment, headerSize,
+                                                m_CircularBuffer.size_bytes()));
+    }
+}
+
+template <typename Ring>
+void SpecWriter<Ring>::ValidateFeatures(const Spec& spec) {
+    if ((spec.enableNotifications && !Wait::NOTIFIES) ||
+        (spec.enableStats && !Instrumentation::SHARED_STATS)) {
+        CB_CONSTEXPR_SV fmt =
+            "({}:{}) Notifications ({}) and statistics ({}) need a ring with "
+            "EventWait and SharedStats policies";
+        SPDLOG_ERROR(fmt.substr(8), spec.enableNotifications,
+                     spec.enableStats);
+        throw std::invalid_argument(std::format(fmt, __FILE__, __LINE__,
+                                                spec.enableNotifications,
+                                                spec.enableStats));
+    }
+}
+
+template <typename Ring>
+void SpecWriter<Ring>::EnsureSingleton(bool takeOverDead) {
+    if (m_SemLock.Acquire()) {
+        return;
+    }
+
+    // A writer that died holding the lock leaves it locked
+    const pid_t writerPid =
+        m_State->liveness.writerPid.load(std::memory_order_acquire);
+    if (takeOverDead && writerPid != 0) {
+        const int writerFd = OpenPidFd(writerPid);
+        const bool exited = WaitForExit(writerPid, writerFd, 0);
+        if (writerFd != -1) {
+            close(writerFd);
+        }
+        if (exited && TakeOver(writerPid)) {
+            return;
+        }
+    }
+
+    throw std::logic_error(std::format(
+        "({}:{}) Another writer has locked the semaphore \"{}\"", __FILE__,
+        __LINE__, m_SemLock.Name()));
+}
+
+template <typename Ring>
+void SpecWriter<Ring>::AwaitTakeover() {
+    const Liveness& liveness = m_State->liveness;
+    for (;;) {
+        // No writer, or it shut down cleanly
+        if (m_SemLock.Acquire()) {
+            return;
+        }
+
+        // Writer starting up or shutting down
+        const pid_t writerPid =
+            liveness.writerPid.load(std::memory_order_acquire);
+        if (writerPid == 0) {
+            std::this_thread::sleep_for(
+                std::chrono::milliseconds(STANDBY_POLL_MS));
+            continue;
+        }
+
+        // Wait for the writer to exit, checking its heartbeat in between.
+        // A hung writer is killed first: it must not wake up and write after
+        // we take over.
+        SPDLOG_INFO("Standing by for writer {}", writerPid);
+        const uint32_t heartbeatMs =
+            liveness.heartbeatMs.load(std::memory_order_relaxed);
+        const int pollMs =
+            heartbeatMs != 0 ? static_cast<int>(heartbeatMs) : STANDBY_POLL_MS;
+        const int writerFd = OpenPidFd(writerPid);
+        bool exited;
+        while (!(exited = WaitForExit(writerPid, writerFd, pollMs)) &&
+               liveness.writerPid.load(std::memory_order_acquire) ==
+                   writerPid) {
+            if (HeartbeatMissed(liveness)) {
+                SPDLOG_WARN("Writer {} missed its heartbeat: killing it",
+                            writerPid);
+                Kill(writerPid, writerFd);
+            }
+        }
+        if (writerFd != -1) {
+            close(writerFd);
+        }
+
+        // Another standby may have beaten us to it
+        if (exited && TakeOver(writerPid)) {
+            return;
+        }
+    }
+}
+
+template <typename Ring>
+bool SpecWriter<Ring>::TakeOver(pid_t deadPid) noexcept {
+    // Only one process can swap in its pid
+    pid_t expected = deadPid;
+    if (!m_State->liveness.writerPid.compare_exchange_strong(
+            expected, getpid(), std::memory_order_acq_rel)) {
+        return false;
+    }
+
+    m_SemLock.Adopt();
+    SPDLOG_INFO("Took over from dead writer {}", deadPid);
+    return true;
+}
+
+template <typename Ring>
+void SpecWriter<Ring>::Reset() {
+    // Publish framing for readers
+    if (m_Clock == ClockSource::TSC) {
+        // Calibrate once per process
+        static const double nanosPerTick = CalibrateTsc();
+        m_State->config.nanosPerTick.store(nanosPerTick,
+                                           std::memory_order_relaxed);
+    }
+    m_State->config.recordAlignment.store(m_RecordAlignment,
+                                          std::memory_order_relaxed);
+    m_State->config.messageNumbers.store(m_MessageNumbers,
+                                         std::memory_order_relaxed);
+    m_State->config.sizeField.store(m_SizeField, std::memory_order_relaxed);
+    m_State->config.contiguousRecords.store(m_ContiguousRecords,
+                                            std::memory_order_relaxed);
+    m_State->config.clock.store(m_Clock, std::memory_order_release);
+
+    // Writer sets initial shared buffer iterators
+    m_LocalIndex = 0;
+    m_LocalSeqNum = 0;
+    m_State->readGeneration.store(m_DataGeneration, std::memory_order_relaxed);
+    // The generation we announce once constructed
+    m_State->readWriterGeneration.store(
+        m_State->liveness.generation.load(std::memory_order_relaxed) + 1,
+        std::memory_order_relaxed);
+    m_State->readIdx.store(0, std::memory_order_release);
+    m_State->writeIdx.store(0, std::memory_order_release);
+    m_State->seqNum.store(0, std::memory_order_release);
+
+    // Keep the data region, grown or not, but start it over
+    DataRegion& region = m_State->region;
+    region.baseSeqNum.store(0, std::memory_order_relaxed);
+    region.baseMessageNumber.store(0, std::memory_order_release);
+
+    // Reset tail
+    Tail& tail = m_State->tail;
+    tail.version.store(0, std::memory_order_relaxed);
+    tail.index.store(0, std::memory_order_relaxed);
+    tail.seqNum.store(0, std::memory_order_relaxed);
+    tail.enabled.store(m_ReplayEnabled, std::memory_order_release);
+
+    // Nothing written yet
+    Latest& latest = m_State->latest;
+    latest.version.store(0, std::memory_order_relaxed);
+    latest.generation.store(0, std::memory_order_relaxed);
+    latest.index.store(0, std::memory_order_relaxed);
+    latest.seqNum.store(0, std::memory_order_release);
+
+    // Reset seek index
+    SeekIndex& seekIndex = m_State->seekIndex;
+    for (SeekEntry& entry : seekIndex.entries) {
+        entry.version.store(0, std::memory_order_relaxed);
+        entry.messageNumber.store(INVALID_MESSAGE_NUMBER,
+                                  std::memory_order_relaxed);
+    }
+    seekIndex.interval.store(m_SeekInterval, std::memory_order_release);
+
+    // Message numbers restart, and so do consumer groups
+    for (ConsumerGroup& group : m_State->groups) {
+        group.cursor.store(0, std::memory_order_release);
+    }
+
+    // Reset writer statistics
+    Stats& stats = m_State->stats;
+    stats.capacity.store(m_CircularBuffer.size_bytes(),
+                         std::memory_order_relaxed);
+    stats.messages.store(0, std::memory_order_relaxed);
+    stats.bytes.store(0, std::memory_order_relaxed);
+    stats.wraps.store(0, std::memory_order_relaxed);
+    stats.maxMessageSize.store(0, std::memory_order_relaxed);
+}
+
+template <typename Ring>
+bool SpecWriter<Ring>::Resume() noexcept {
+    const Config& config = m_State->config;
+    const IndexT capacity = m_CircularBuffer.size_bytes();
+    if (m_State->liveness.generation.load(std::memory_order_acquire) == 0) {
+        SPDLOG_INFO("No stream to resume: starting a new one");
+        return false;
+    }
+    if (DataRegionCreated()) {
+        SPDLOG_WARN("Can't resume stream: its data region was freed. "
+                    "Resetting buffer.");
+        return false;
+    }
+    if (config.clock.load(std::memory_order_acquire) != m_Clock ||
+        config.sizeField.load(std::memory_order_relaxed) != m_SizeField ||
+        config.recordAlignment.load(std::memory_order_relaxed) !=
+            static_cast<uint32_t>(m_RecordAlignment) ||
+        (config.messageNumbers.load(std::memory_order_relaxed) != 0) !=
+            m_MessageNumbers ||
+        (config.contiguousRecords.load(std::memory_order_relaxed) != 0) !=
+            m_ContiguousRecords ||
+        m_State->seekIndex.interval.load(std::memory_order_relaxed) !=
+            m_SeekInterval ||
+        m_State->stats.capacity.load(std::memory_order_relaxed) != capacity) {
+        SPDLOG_WARN("Can't resume stream: framing differs from the previous "
+                    "writer's. Resetting buffer.");
+        return false;
+    }
+
+    // Find the end of the stream by walking the last records, which also
+    // checks them. Only records published to readers are walked: a write in
+    // progress when the previous writer died is discarded.
+    const IndexT readIdx = m_State->readIdx.load(std::memory_order_acquire);
+    const SeqNumT seqNum = m_State->seqNum.load(std::memory_order_acquire);
+    Tail& tail = m_State->tail;
+    const bool tailIntact =
+        tail.enabled.load(std::memory_order_relaxed) != 0 &&
+        tail.version.load(std::memory_order_acquire) % 2 == 0;
+    bool valid;
+    if (readIdx > capacity) {
+        valid = false;
+    } else if (m_MessageNumbers) {
+        LoadLatestSeekEntry();
+        valid = ValidateRecords(readIdx, seqNum);
+    } else if (tailIntact) {
+        m_LocalIndex = tail.index.load(std::memory_order_relaxed);
+        m_LocalSeqNum = tail.seqNum.load(std::memory_order_relaxed);
+        valid = ValidateRecords(readIdx, seqNum);
+    } else {
+        // Nothing to walk from: trust the published state, unless a write
+        // was in progress, as the sequence number may already count it
+        m_LocalIndex = readIdx;
+        m_LocalSeqNum = seqNum;
+        valid = m_State->writeIdx.load(std::memory_order_acquire) == readIdx;
+    }
+    if (!valid) {
+        SPDLOG_WARN("Can't resume stream: last records are corrupt. "
+                    "Resetting buffer.");
+        return false;
+    }
+
+    // Republish the end of the stream, dropping any write in progress
+    m_State->writeIdx.store(m_LocalIndex, std::memory_order_release);
+    m_State->seqNum.store(m_LocalSeqNum, std::memory_order_release);
+    m_State->readGeneration.store(m_DataGeneration, std::memory_order_relaxed);
+    m_State->readIdx.store(m_LocalIndex, std::memory_order_release);
+
+    // Keep the tail if intact, otherwise nothing before this point can be
+    // replayed
+    if (tailIntact && m_LocalSeqNum -
+                              tail.seqNum.load(std::memory_order_relaxed) <=
+                          capacity) {
+        m_TailIndex = tail.index.load(std::memory_order_relaxed);
+        m_TailSeqNum = tail.seqNum.load(std::memory_order_relaxed);
+        m_TailVersion = tail.version.load(std::memory_order_relaxed);
+    } else {
+        m_TailIndex = m_LocalIndex;
+        m_TailSeqNum = m_LocalSeqNum;
+        m_TailVersion = (tail.version.load(std::memory_order_relaxed) + 1) & ~1;
+        PublishTail();
+    }
+    tail.enabled.store(m_ReplayEnabled, std::memory_order_release);
+
+    // Next seek index entry is at the next multiple of the interval
+    if (m_MessageNumbers) {
+        const uint64_t offset = m_MessageNumber % m_SeekInterval;
+        m_SeekCountdown = offset == 0 ? 1 : m_SeekInterval - offset + 1;
+    }
+
+    // Carry on counting
+    const Stats& stats = m_State->stats;
+    m_StatMessages = stats.messages.load(std::memory_order_relaxed);
+    m_StatBytes = stats.bytes.load(std::memory_order_relaxed);
+    m_StatWraps = stats.wraps.load(std::memory_order_relaxed);
+    m_StatMaxMessageSize = stats.maxMessageSize.load(std::memory_order_relaxed);
+
+    SPDLOG_INFO("Resumed stream at message {}: write={}, seq={}",
+                m_MessageNumber, m_LocalIndex, m_LocalSeqNum);
+    return true;
+}
+
+template <typename Ring>
+void SpecWriter<Ring>::LoadLatestSeekEntry() noexcept {
+    // Without an entry in this data region, walk from its first message
+    const DataRegion& region = m_State->region;
+    const SeqNumT baseSeqNum =
+        region.baseSeqNum.load(std::memory_order_acquire);
+    m_LocalIndex = 0;
+    m_LocalSeqNum = baseSeqNum;
+    m_MessageNumber = region.baseMessageNumber.load(std::memory_order_relaxed);
+
+    // No writer is running, so entries are only torn if it died updating
+    // them. Those are dropped, as readers would spin on them forever.
+    for (SeekEntry& entry : m_State->seekIndex.entries) {
+        const uint64_t version = entry.version.load(std::memory_order_acquire);
+        const MessageNumberT number =
+            entry.messageNumber.load(std::memory_order_relaxed);
+        if (version % 2 != 0) {
+            entry.messageNumber.store(INVALID_MESSAGE_NUMBER,
+                                      std::memory_order_relaxed);
+            entry.version.store(version + 1, std::memory_order_release);
+        } else if (number != INVALID_MESSAGE_NUMBER &&
+                   number >= m_MessageNumber &&
+                   entry.seqNum.load(std::memory_order_relaxed) >=
+                       baseSeqNum) {
+            m_LocalIndex = entry.index.load(std::memory_order_relaxed);
+            m_LocalSeqNum = entry.seqNum.load(std::memory_order_relaxed);
+            m_MessageNumber = number;
+        }
+    }
+}
+
+template <typename Ring>
+bool SpecWriter<Ring>::ValidateRecords(IndexT readIdx,
+                                       SeqNumT seqNum) noexcept {
+    const IndexT capacity = m_CircularBuffer.size_bytes();
+    while (m_LocalIndex != readIdx) {
+        // Walked past the end of the stream, or over overwritten records
+        if (m_LocalIndex > capacity || seqNum - m_LocalSeqNum > capacity) {
+            return false;
+        }
+
+        // Header can't fit - record is at start of buffer
+        if (capacity - m_LocalIndex < static_cast<IndexT>(m_PayloadOffset)) {
+            m_LocalIndex = 0;
+        }
+
+        int fieldBytes;
+        const MessageSizeT msgSize = LoadSize(m_LocalIndex, fieldBytes);
+        if (msgSize < 0 || msgSize > m_MaxMessageSize) {
+            return false;
+        }
+
+        // Skip record - record is at start of buffer
+        if (IsSkipRecord(m_LocalIndex, msgSize)) {
+            m_LocalSeqNum += capacity - m_LocalIndex;
+            m_LocalIndex = 0;
+            continue;
+        }
+
+        // Numbers must follow on, and entries the previous writer didn't get
+        // to are filled in
+        if (m_MessageNumbers) {
+            MessageNumberT headerNumber;
+            std::memcpy(&headerNumber,
+                        &m_CircularBuffer[m_LocalIndex +
+                                          MessageNumberOffset(fieldBytes)],
+                        MESSAGE_NUMBER_SIZE);
+            if (headerNumber != m_MessageNumber) {
+                return false;
+            }
+            if (m_MessageNumber % m_SeekInterval == 0) {
+                UpdateSeekIndex(m_LocalIndex, m_LocalSeqNum);
+            }
+            m_MessageNumber++;
+        }
+
+        const int recordSize = RecordSize(msgSize);
+        m_LocalIndex += recordSize;
+        if (m_LocalIndex > capacity) {
+            m_LocalIndex -= capacity;
+        }
+        m_LocalSeqNum += recordSize;
+    }
+
+    return true;
+}
+
+// `Writer` and `LeanWriter`
+template class SpecWriter<SpecRing>;
+template class SpecWriter<LeanSpecRing>;
+
 }  // namespace CircularBuffer
@@ -0,0 +1,175 @@
+#include "circularbuffer/AsyncReader.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Spec.hpp"
+#include "circularbuffer/Writer.hpp"
+
+namespace CB = CircularBuffer;
+using CB::AsyncReader;
+using CB::DataT;
+using CB::Scheduler;
+using CB::Task;
+
+namespace {
+
+constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+// One ring per channel
+class Channels {
+public:
+    Channels(Scheduler& scheduler, int count) {
+        for (int i = 0; i < count; i++) {
+            const std::string n = std::to_string(i);
+            const CB::Spec spec{"/testing-index-" + n, "/testing-data-" + n,
+                                BUFFER_SIZE};
+            writers.push_back(new CB::Writer(spec));
+            readers.push_back(new AsyncReader(scheduler, spec));
+        }
+    }
+
+    ~Channels() {
+        for (AsyncReader* reader : readers) {
+            delete reader;
+        }
+        for (CB::Writer* writer : writers) {
+            delete writer;
+        }
+    }
+
+    std::vector<CB::Writer*> writers;
+    std::vector<AsyncReader*> readers;
+};
+
+void WriteInt(CB::Writer& writer, int value) {
+    writer.Write({reinterpret_cast<DataT*>(&value), sizeof(int)});
+}
+
+// Writes `count` messages to every channel, yielding after each round
+Task Producer(Scheduler& scheduler, Channels& channels, int count) {
+    for (int i = 0; i < count; i++) {
+        for (CB::Writer* writer : channels.writers) {
+            WriteInt(*writer, i);
+        }
+        co_await scheduler.Yield();
+    }
+}
+
+// Reads `count` messages, checking they arrive in order
+Task Consumer(AsyncReader& reader, int count, int& received) {
+    DataT buffer[64];
+    for (int i = 0; i < count; i++) {
+        const int ret = co_await reader.Next(buffer);
+        EXPECT_EQ(ret, sizeof(int));
+
+        int value;
+        std::memcpy(&value, buffer, sizeof(int));
+        EXPECT_EQ(value, i);
+        received++;
+    }
+}
+
+Task Thrower(AsyncReader& reader) {
+    DataT buffer[64];
+    co_await reader.Next(buffer);
+    throw std::runtime_error("consumer failed");
+}
+
+}  // namespace
+
+TEST(AsyncReader, ManyChannels) {
+    Scheduler scheduler;
+    const int numChannels = 32;
+    const int count = 1000;
+    Channels channels(scheduler, numChannels);
+
+    std::vector<int> received(numChannels, 0);
+    for (int i = 0; i < numChannels; i++) {
+        scheduler.Spawn(Consumer(*channels.readers[i], count, received[i]));
+    }
+    scheduler.Spawn(Producer(scheduler, channels, count));
+    EXPECT_EQ(scheduler.Size(), numChannels + 1);
+
+    // Runs until every consumer has read everything
+    scheduler.Run();
+    EXPECT_EQ(scheduler.Size(), 0);
+    for (int i = 0; i < numChannels; i++) {
+        EXPECT_EQ(received[i], count);
+    }
+}
+
+TEST(AsyncReader, ResumeOnlyReady) {
+    Scheduler scheduler;
+    Channels channels(scheduler, 3);
+
+    std::vector<int> received(3, 0);
+    for (int i = 0; i < 3; i++) {
+        scheduler.Spawn(Consumer(*channels.readers[i], 2, received[i]));
+    }
+
+    // First poll starts every coroutine, which then waits for data
+    EXPECT_EQ(scheduler.Poll(), 3);
+    EXPECT_EQ(scheduler.Poll(), 0);
+
+    // Only the consumer whose ring has data is resumed
+    WriteInt(*channels.writers[1], 0);
+    EXPECT_EQ(scheduler.Poll(), 1);
+    EXPECT_EQ(received, std::vector<int>({0, 1, 0}));
+    EXPECT_EQ(scheduler.Poll(), 0);
+
+    // Data already there: no suspension
+    WriteInt(*channels.writers[1], 1);
+    WriteInt(*channels.writers[2], 0);
+    WriteInt(*channels.writers[2], 1);
+    EXPECT_EQ(scheduler.Poll(), 2);
+    EXPECT_EQ(received, std::vector<int>({0, 2, 2}));
+    EXPECT_EQ(scheduler.Size(), 1);
+
+    // Scheduler destroys the consumer still waiting
+}
+
+TEST(AsyncReader, NoResumeWithoutMessage) {
+    Scheduler scheduler;
+    Channels channels(scheduler, 1);
+
+    int received = 0;
+    scheduler.Spawn(Consumer(*channels.readers[0], 1, received));
+    EXPECT_EQ(scheduler.Poll(), 1);
+
+    // Growing makes the ring look ready with no message to read yet: the
+    // consumer keeps waiting rather than resuming with 0
+    ASSERT_TRUE(channels.writers[0]->Grow(2 * BUFFER_SIZE));
+    EXPECT_TRUE(channels.readers[0]->Available());
+    EXPECT_EQ(scheduler.Poll(), 0);
+    EXPECT_EQ(received, 0);
+
+    WriteInt(*channels.writers[0], 0);
+    EXPECT_EQ(scheduler.Poll(), 1);
+    EXPECT_EQ(received, 1);
+    EXPECT_EQ(scheduler.Size(), 0);
+}
+
+TEST(AsyncReader, ExceptionPropagates) {
+    Scheduler scheduler;
+    Channels channels(scheduler, 2);
+
+    int received = 0;
+    scheduler.Spawn(Thrower(*channels.readers[0]));
+    scheduler.Spawn(Consumer(*channels.readers[1], 1, received));
+    scheduler.Poll();
+
+    // Both resumed in the same poll: the second isn't lost
+    WriteInt(*channels.writers[0], 0);
+    WriteInt(*channels.writers[1], 0);
+    EXPECT_THROW(scheduler.Poll(), std::runtime_error);
+    EXPECT_EQ(scheduler.Size(), 1);
+    scheduler.Poll();
+    EXPECT_EQ(received, 1);
+    EXPECT_EQ(scheduler.Size(), 0);
+}
@@ -0,0 +1,246 @@
+#include "circularbuffer/BasicRing.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "Utils.hpp"
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Reader.hpp"
+#include "circularbuffer/RingPolicies.hpp"
+#include "circularbuffer/Spec.hpp"
+#include "circularbuffer/Writer.hpp"
+
+namespace CB = CircularBuffer;
+using CB::BufferT;
+using CB::DataT;
+
+namespace {
+
+constexpr size_t capacity = 4096;
+constexpr char ringName[] = "/testing-basic-ring";
+
+using Lossy = CB::LossyRing<capacity>;
+using Lossless = CB::LosslessRing;
+// Lossy, with counters and compact headers
+using CountingLossy =
+    CB::BasicRing<CB::Size16Header, CB::DynamicCapacity, CB::Overwrite,
+                  CB::SpinWait, CB::CountingInstrumentation>;
+
+// Unused instrumentation takes up no space
+static_assert(sizeof(CB::BasicRing<CB::Size32Header, CB::DynamicCapacity,
+                                   CB::Block, CB::FutexWait>::Reader) +
+                  sizeof(CB::CountingInstrumentation) ==
+              sizeof(Lossless::Reader));
+
+// `Writer` and `Reader` are the spec-framed ring with every feature kept
+static_assert(std::is_same_v<CB::Writer, CB::SpecRing::Writer>);
+static_assert(std::is_same_v<CB::Reader, CB::SpecRing::Reader>);
+static_assert(std::is_same_v<CB::LeanReader, CB::LeanSpecRing::Reader>);
+
+CB::BasicRingSpec MakeSpec() { return {ringName, capacity}; }
+
+CB::Spec MakeLeanSpec() {
+    return {"/testing-basic-ring-index", "/testing-basic-ring-data", capacity};
+}
+
+constexpr size_t maxMessageSize = 300;
+
+template <typename Ring>
+class BasicRingTest : public testing::Test {};
+
+using Rings = testing::Types<Lossy, Lossless, CountingLossy>;
+TYPED_TEST_SUITE(BasicRingTest, Rings);
+
+}  // namespace
+
+TEST(BasicRing, Constructor) {
+    // Capacity must be a power of two of at least a cacheline, or the fixed
+    // one
+    EXPECT_THROW(Lossless::Writer({ringName, 96}), std::invalid_argument);
+    EXPECT_THROW(Lossless::Writer({ringName, CB::CACHELINE_SIZE / 2}),
+                 std::invalid_argument);
+    EXPECT_THROW(Lossy::Writer({ringName, capacity * 2}),
+                 std::invalid_argument);
+
+    Lossless::Writer writer(MakeSpec());
+    EXPECT_EQ(writer.Capacity(), capacity);
+    EXPECT_EQ(writer.MaxMessageSize(), capacity / 2 - sizeof(uint32_t));
+
+    // One writer, and one lossless reader, at a time
+    EXPECT_THROW(Lossless::Writer{MakeSpec()}, std::logic_error);
+    Lossless::Reader reader(MakeSpec());
+    EXPECT_THROW(Lossless::Reader{MakeSpec()}, std::logic_error);
+
+    // Same size in shared memory, other policies
+    EXPECT_THROW(Lossy::Reader({ringName, 0}), std::invalid_argument);
+}
+
+TYPED_TEST(BasicRingTest, WriteRead) {
+    typename TypeParam::Writer writer(MakeSpec());
+    typename TypeParam::Reader reader(MakeSpec());
+    std::vector<DataT> readBuffer(writer.MaxMessageSize());
+
+    // Nothing written yet
+    EXPECT_EQ(reader.Read(readBuffer), 0);
+
+    // Too big
+    std::vector<DataT> tooBig(writer.MaxMessageSize() + 1);
+    EXPECT_FALSE(writer.Write(tooBig));
+
+    // Messages come out in order across many laps, skipping the end of the
+    // ring whenever a record doesn't fit
+    for (uint64_t i = 0; i < 1000; i++) {
+        WriteMessages(writer, i, 1, maxMessageSize);
+        const int ret = reader.Read(readBuffer);
+        ASSERT_TRUE(CheckMessage(i, readBuffer, ret, maxMessageSize)) << i;
+    }
+    EXPECT_EQ(reader.Position(), writer.Head());
+    EXPECT_GT(writer.Head(), 30 * capacity);
+    EXPECT_EQ(reader.Read(readBuffer), 0);
+
+    // Read buffer too small: the message stays
+    WriteMessages(writer, 1000, 1, maxMessageSize);
+    std::vector<DataT> smallBuffer(4);
+    EXPECT_EQ(reader.Read(smallBuffer), -1);
+    EXPECT_TRUE(CheckMessage(1000, readBuffer, reader.ReadWait(readBuffer),
+                             maxMessageSize));
+}
+
+TEST(BasicRing, Overwritten) {
+    CountingLossy::Writer writer(MakeSpec());
+    CountingLossy::Reader reader(MakeSpec());
+    std::vector<DataT> readBuffer(writer.MaxMessageSize());
+
+    // Lapped reader skips to the next message written
+    WriteMessages(writer, 0, 100, maxMessageSize);
+    EXPECT_EQ(reader.Read(readBuffer), INT_MIN);
+    EXPECT_EQ(reader.Read(readBuffer), 0);
+    WriteMessages(writer, 100, 1, maxMessageSize);
+    EXPECT_TRUE(CheckMessage(100, readBuffer, reader.Read(readBuffer),
+                             maxMessageSize));
+
+    EXPECT_EQ(writer.Instruments().messages, 101u);
+    EXPECT_EQ(reader.Instruments().messages, 1u);
+    EXPECT_EQ(reader.Instruments().overwrites, 1u);
+}
+
+TEST(BasicRing, Blocking) {
+    constexpr uint64_t numMessages = 20000;
+    Lossless::Reader reader(MakeSpec());
+
+    // The writer waits for the reader: every message arrives, in order
+    std::thread thread([&] {
+        Lossless::Writer writer(MakeSpec());
+        WriteMessages(writer, 0, numMessages, maxMessageSize);
+        EXPECT_EQ(writer.Instruments().messages, numMessages);
+        EXPECT_GT(writer.Instruments().waits, 0u);
+    });
+
+    std::vector<DataT> readBuffer(capacity);
+    for (uint64_t i = 0; i < numMessages; i++) {
+        // Slow reader to start with, so the writer fills the ring
+        if (i == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        const int ret = reader.ReadWait(readBuffer);
+        ASSERT_TRUE(CheckMessage(i, readBuffer, ret, maxMessageSize)) << i;
+    }
+    thread.join();
+    EXPECT_EQ(reader.Instruments().messages, numMessages);
+}
+
+TEST(BasicRing, ReaderRestart) {
+    Lossless::Writer writer(MakeSpec());
+    std::vector<DataT> readBuffer(capacity);
+    WriteMessages(writer, 0, 10, maxMessageSize);
+
+    // A new lossless reader picks up where the last one stopped
+    for (uint64_t i = 0; i < 10; i++) {
+        Lossless::Reader reader(MakeSpec());
+        ASSERT_TRUE(CheckMessage(i, readBuffer, reader.Read(readBuffer),
+                                 maxMessageSize));
+    }
+
+    // A new lossy reader starts at the next message
+    Lossy::Writer lossyWriter({"/testing-basic-ring-lossy", 0});
+    WriteMessages(lossyWriter, 0, 10, maxMessageSize);
+    Lossy::Reader lossyReader({"/testing-basic-ring-lossy", 0});
+    EXPECT_EQ(lossyReader.Read(readBuffer), 0);
+    EXPECT_EQ(lossyReader.Position(), lossyWriter.Head());
+}
+
+TEST(BasicRing, Concurrent) {
+    constexpr uint64_t numMessages = 200000;
+    Lossy::Writer writer(MakeSpec());
+    Lossy::Reader reader(MakeSpec());
+    std::atomic<bool> done{false};
+
+    // Readers are lapped all the time, but never see a torn message
+    std::thread thread([&] {
+        std::vector<DataT> readBuffer(capacity);
+        uint64_t last = 0;
+        bool first = true;
+        while (!done.load(std::memory_order_acquire)) {
+            const int ret = reader.Read(readBuffer);
+            if (ret <= 0) {
+                continue;
+            }
+            uint64_t i;
+            std::memcpy(&i, readBuffer.data(), sizeof(i));
+            ASSERT_TRUE(CheckMessage(i, readBuffer, ret, maxMessageSize)) << i;
+            ASSERT_TRUE(first || i > last) << i;
+            first = false;
+            last = i;
+        }
+    });
+
+    WriteMessages(writer, 0, numMessages, maxMessageSize);
+    done.store(true, std::memory_order_release);
+    thread.join();
+}
+
+TEST(BasicRing, LeanSpecRing) {
+    CB::LeanWriter writer(MakeLeanSpec());
+    CB::LeanReader reader(MakeLeanSpec());
+    std::vector<DataT> readBuffer(capacity);
+
+    WriteMessages(writer, 0, 10, maxMessageSize);
+    for (uint64_t i = 0; i < 10; i++) {
+        const int ret = reader.Read(readBuffer);
+        ASSERT_TRUE(CheckMessage(i, readBuffer, ret, maxMessageSize)) << i;
+    }
+    EXPECT_EQ(reader.Read(readBuffer), 0);
+
+    // Full-featured readers share the layout
+    CB::Reader fullReader(MakeLeanSpec());
+    WriteMessages(writer, 10, 1, maxMessageSize);
+    EXPECT_TRUE(CheckMessage(10, readBuffer, fullReader.Read(readBuffer),
+                             maxMessageSize));
+}
+
+TEST(BasicRing, LeanSpecRingFeatures) {
+    // Notifications and statistics are compiled out
+    CB::Spec spec = MakeLeanSpec();
+    spec.enableNotifications = true;
+    EXPECT_THROW(CB::LeanWriter{spec}, std::invalid_argument);
+    spec.enableNotifications = false;
+    spec.enableStats = true;
+    EXPECT_THROW(CB::LeanWriter{spec}, std::invalid_argument);
+
+    // So there's no event fd, even if the writer sends notifications
+    spec.enableStats = false;
+    spec.enableNotifications = true;
+    CB::Writer writer(spec);
+    CB::LeanReader reader(spec, {.eventFd = true});
+    EXPECT_EQ(reader.EventFd(), -1);
+    EXPECT_FALSE(reader.Arm());
+}
@@ -0,0 +1,221 @@
+#include <arpa/inet.h>
+#include <gtest/gtest.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+#include "Utils.hpp"
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Bridge.hpp"
+#include "circularbuffer/BridgePublisher.hpp"
+#include "circularbuffer/BridgeSubscriber.hpp"
+#include "circularbuffer/Reader.hpp"
+#include "circularbuffer/Spec.hpp"
+#include "circularbuffer/Writer.hpp"
+
+namespace CB = CircularBuffer;
+using CB::BufferT;
+using CB::DataT;
+
+namespace {
+
+constexpr size_t bufferSize = 1024 * 1024;
+
+CB::Spec PublisherSpec() {
+    CB::Spec spec{"/testing-index", "/testing-data", bufferSize};
+    spec.seekInterval = 16;
+    return spec;
+}
+
+const CB::Spec subscriberSpec{"/testing-index-2", "/testing-data-2",
+                              bufferSize};
+const CB::BridgeSubscriberOptions subscriberOptions{.reconnectDelayMs = 10};
+
+// Message `i` carries its index, with a size depending on `i`
+int MessageSize(int i) { return sizeof(int) + (i * 37) % 1001; }
+
+void WriteMessages(CB::Writer &writer, int first, int count) {
+    BufferT buffer = MakeBuffer(MessageSize(0) + 1000, '\1');
+    for (int i = first; i < first + count; i++) {
+        std::memcpy(buffer.data(), &i, sizeof(int));
+        writer.Write(buffer.data(), MessageSize(i));
+    }
+    delete[] buffer.data();
+}
+
+// Reads messages `first` to `first + count - 1`, checking their contents
+void ReadMessages(CB::Reader &reader, int first, int count) {
+    BufferT buffer = MakeBuffer(MessageSize(0) + 1000);
+    for (int i = first; i < first + count; i++) {
+        int ret;
+        const auto start = std::chrono::steady_clock::now();
+        while ((ret = reader.Read(buffer)) == 0) {
+            ASSERT_LT(std::chrono::steady_clock::now() - start,
+                      std::chrono::seconds(10))
+                << "timed out waiting for message " << i;
+            std::this_thread::yield();
+        }
+        ASSERT_EQ(ret, MessageSize(i));
+        int index;
+        std::memcpy(&index, buffer.data(), sizeof(int));
+        ASSERT_EQ(index, i);
+        if (ret > static_cast<int>(sizeof(int))) {
+            ASSERT_EQ(buffer[ret - 1], DataT{'\1'});
+        }
+    }
+    delete[] buffer.data();
+}
+
+void WaitFor(const std::function<bool()> &condition) {
+    const auto start = std::chrono::steady_clock::now();
+    while (!condition()) {
+        ASSERT_LT(std::chrono::steady_clock::now() - start,
+                  std::chrono::seconds(10));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+}  // namespace
+
+TEST(Bridge, Constructor) {
+    // Writer doesn't number messages
+    {
+        const CB::Spec spec{"/testing-index", "/testing-data", bufferSize};
+        CB::Writer writer(spec);
+        EXPECT_THROW(CB::BridgePublisher(spec, 0), std::logic_error);
+    }
+
+    const CB::Spec spec = PublisherSpec();
+    CB::Writer writer(spec);
+    EXPECT_THROW(CB::BridgePublisher(spec, 0, {.address = "localhost"}),
+                 std::invalid_argument);
+
+    // Any free port, which can't then be listened on twice
+    CB::BridgePublisher publisher(spec, 0, {.address = "127.0.0.1"});
+    EXPECT_NE(publisher.Port(), 0);
+    EXPECT_THROW(
+        CB::BridgePublisher(spec, publisher.Port(), {.address = "127.0.0.1"}),
+        std::runtime_error);
+}
+
+TEST(Bridge, Loopback) {
+    const CB::Spec spec = PublisherSpec();
+    CB::Writer writer(spec);
+    CB::BridgePublisher publisher(spec, 0, {.batchBytes = 4096});
+    CB::BridgeSubscriber subscriber(subscriberSpec, "localhost",
+                                    publisher.Port(), subscriberOptions);
+    CB::Reader reader(subscriberSpec);
+
+    // Messages written before and after the subscriber connects arrive
+    // intact, in order, in the subscriber's ring
+    WriteMessages(writer, 0, 100);
+    WaitFor([&] { return publisher.Connections() == 1; });
+    ReadMessages(reader, 0, 100);
+    // In chunks the subscriber's ring can hold
+    for (int i = 100; i < 10100; i += 1000) {
+        WriteMessages(writer, i, 1000);
+        ReadMessages(reader, i, 1000);
+    }
+
+    EXPECT_EQ(subscriber.Received(), 10100);
+    EXPECT_EQ(subscriber.Missed(), 0);
+    EXPECT_EQ(publisher.Sent(), 10100);
+}
+
+TEST(Bridge, ReconnectResume) {
+    const CB::Spec spec = PublisherSpec();
+    CB::Writer writer(spec);
+    auto *publisher = new CB::BridgePublisher(spec, 0);
+    const uint16_t port = publisher->Port();
+    CB::BridgeSubscriber subscriber(subscriberSpec, "localhost", port,
+                                    subscriberOptions);
+    CB::Reader reader(subscriberSpec);
+
+    WriteMessages(writer, 0, 1000);
+    ReadMessages(reader, 0, 1000);
+
+    // Messages written while the publisher is down are resent once the
+    // subscriber reconnects
+    delete publisher;
+    WriteMessages(writer, 1000, 1000);
+    publisher = new CB::BridgePublisher(spec, port);
+    WaitFor([&] { return subscriber.Connections() == 2; });
+    ReadMessages(reader, 1000, 1000);
+    EXPECT_EQ(subscriber.Missed(), 0);
+
+    // Messages overwritten while the publisher is down are reported missing
+    delete publisher;
+    const int lapped = 3 * bufferSize / 500;
+    WriteMessages(writer, 2000, lapped);
+    publisher = new CB::BridgePublisher(spec, port);
+    WaitFor([&] { return subscriber.Connections() == 3; });
+    WriteMessages(writer, 2000 + lapped, 10);
+    ReadMessages(reader, 2000 + lapped, 10);
+    EXPECT_EQ(subscriber.Missed(), lapped);
+    EXPECT_EQ(subscriber.Received(), 2010);
+
+    delete publisher;
+}
+
+TEST(Bridge, PartialHello) {
+    const CB::Spec spec = PublisherSpec();
+    CB::Writer writer(spec);
+    CB::BridgePublisher publisher(spec, 0);
+
+    // A client that stalls partway through its hello is dropped
+    const int fd = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_NE(fd, -1);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(publisher.Port());
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ASSERT_EQ(connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)),
+              0);
+    const uint32_t partial = 0;
+    ASSERT_EQ(send(fd, &partial, sizeof(partial), 0), sizeof(partial));
+
+    // And the publisher goes on to serve a real subscriber
+    CB::BridgeSubscriber subscriber(subscriberSpec, "localhost",
+                                    publisher.Port(), subscriberOptions);
+    CB::Reader reader(subscriberSpec);
+    WaitFor([&] { return publisher.Connections() == 1; });
+    WriteMessages(writer, 0, 100);
+    ReadMessages(reader, 0, 100);
+
+    close(fd);
+}
+
+TEST(Bridge, Dropped) {
+    const CB::Spec spec = PublisherSpec();
+    CB::Writer writer(spec);
+    CB::BridgePublisher publisher(spec, 0);
+
+    // Contiguous records limit messages to half the subscriber's ring
+    constexpr size_t smallCapacity = 1024;
+    CB::Spec smallSpec{"/testing-index-2", "/testing-data-2", smallCapacity};
+    smallSpec.contiguousRecords = true;
+    CB::BridgeSubscriber subscriber(smallSpec, "localhost", publisher.Port(),
+                                    subscriberOptions);
+
+    // Messages the local ring rejects are counted, not received
+    constexpr int count = 100;
+    constexpr int maxSize = smallCapacity / 2 - CB::HEADER_SIZE;
+    int tooBig = 0;
+    for (int i = 0; i < count; i++) {
+        tooBig += MessageSize(i) > maxSize ? 1 : 0;
+    }
+    ASSERT_GT(tooBig, 0);
+    WriteMessages(writer, 0, count);
+    WaitFor([&] {
+        return subscriber.Received() + subscriber.Dropped() == count;
+    });
+    EXPECT_EQ(subscriber.Dropped(), tooBig);
+    EXPECT_EQ(subscriber.Missed(), 0);
+}
@@ -0,0 +1,49 @@
+#include "circularbuffer/Copy.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+TEST(Copy, StreamingCopy) {
+    // Cover every combination of small misalignments and tail sizes
+    std::vector<char> src(4096 + 128);
+    for (size_t i = 0; i < src.size(); i++) {
+        src[i] = static_cast<char>(i % 251);
+    }
+
+    for (size_t offset = 0; offset < 64; offset += 7) {
+        for (size_t size : {0UL, 1UL, 15UL, 16UL, 63UL, 64UL, 65UL, 1000UL,
+                            4096UL}) {
+            std::vector<char> dst(src.size() + 64, '\0');
+            CircularBuffer::StreamingCopy(dst.data() + offset, src.data(),
+                                          size);
+            CircularBuffer::StoreFence();
+
+            EXPECT_EQ(std::memcmp(dst.data() + offset, src.data(), size), 0)
+                << "offset=" << offset << " size=" << size;
+            // Nothing written past the end
+            EXPECT_EQ(dst[offset + size], '\0');
+        }
+    }
+}
+
+TEST(Copy, CopySmall) {
+    std::vector<char> src(CircularBuffer::SMALL_COPY_MAX);
+    for (size_t i = 0; i < src.size(); i++) {
+        src[i] = static_cast<char>(i + 1);
+    }
+
+    // Every size class, at an odd destination offset
+    for (size_t size = 0; size <= CircularBuffer::SMALL_COPY_MAX; size++) {
+        std::vector<char> dst(CircularBuffer::SMALL_COPY_MAX + 2, '\0');
+        CircularBuffer::CopySmall(dst.data() + 1, src.data(), size);
+
+        EXPECT_EQ(std::memcmp(dst.data() + 1, src.data(), size), 0)
+            << "size=" << size;
+        // Nothing written outside the destination range
+        EXPECT_EQ(dst[0], '\0');
+        EXPECT_EQ(dst[size + 1], '\0');
+    }
+}
@@ -0,0 +1,105 @@
+#include "circularbuffer/Dispatcher.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Spec.hpp"
+#include "circularbuffer/Writer.hpp"
+
+namespace CB = CircularBuffer;
+using CB::DataT;
+
+namespace {
+
+// Messages carry a key and a per-key sequence number
+struct Message {
+    uint64_t key;
+    uint64_t seq;
+};
+
+uint64_t ExtractKey(std::span<const DataT> message) {
+    uint64_t key;
+    std::memcpy(&key, message.data(), sizeof(key));
+    return key;
+}
+
+}  // namespace
+
+TEST(Dispatcher, Constructor) {
+    const CB::Spec spec{"/testing-index", "/testing-data", 1024 * 1024};
+    CB::Writer writer(spec);
+
+    const auto handler = [](std::span<const DataT>, int) {};
+    EXPECT_NO_THROW(CB::Dispatcher(spec, ExtractKey, handler, {.workers = 4}));
+    EXPECT_THROW(CB::Dispatcher(spec, ExtractKey, handler, {.workers = 0}),
+                 std::invalid_argument);
+}
+
+TEST(Dispatcher, PerKeyOrder) {
+    const CB::Spec spec{"/testing-index", "/testing-data", 1024 * 1024};
+    CB::Writer writer(spec);
+
+    const int numWorkers = 4;
+    const int numKeys = 37;
+    const int count = 20000;
+
+    // Each key is only ever touched by its worker, so no locking needed
+    std::vector<uint64_t> nextSeq(numKeys, 0);
+    std::vector<int> keyWorker(numKeys, -1);
+    std::vector<uint64_t> workerMessages(numWorkers, 0);
+    bool inOrder = true;
+    bool sameWorker = true;
+
+    CB::Dispatcher dispatcher(
+        spec, ExtractKey,
+        [&](std::span<const DataT> data, int worker) {
+            Message message;
+            std::memcpy(&message, data.data(), sizeof(message));
+            inOrder &= message.seq == nextSeq[message.key]++;
+            if (keyWorker[message.key] == -1) {
+                keyWorker[message.key] = worker;
+            }
+            sameWorker &= keyWorker[message.key] == worker;
+            workerMessages[worker]++;
+        },
+        {.workers = numWorkers});
+    dispatcher.Start();
+
+    // Write in batches the dispatcher can keep up with
+    std::vector<uint64_t> seq(numKeys, 0);
+    for (int i = 0; i < count; i++) {
+        const uint64_t key = i * 7 % numKeys;
+        Message message{key, seq[key]++};
+        writer.Write(reinterpret_cast<DataT*>(&message), sizeof(message));
+
+        if (i % 1000 == 999) {
+            while (dispatcher.Dispatched() < static_cast<uint64_t>(i + 1)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+    while (dispatcher.Dispatched() < count) {
+        std::this_thread::yield();
+    }
+
+    // Stop waits for workers to drain their queues
+    dispatcher.Stop();
+    EXPECT_EQ(dispatcher.Handled(), count);
+    EXPECT_FALSE(dispatcher.Overwritten());
+
+    // Per-key ordering preserved, every key handled by one worker, and work
+    // spread over all workers
+    EXPECT_TRUE(inOrder);
+    EXPECT_TRUE(sameWorker);
+    EXPECT_EQ(nextSeq, seq);
+    for (int i = 0; i < numWorkers; i++) {
+        EXPECT_GT(workerMessages[i], 0);
+    }
+}
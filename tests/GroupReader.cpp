@@ -0,0 +1,194 @@
+#include "circularbuffer/GroupReader.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "Utils.hpp"
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/SharedMemory.hpp"
+#include "circularbuffer/Spec.hpp"
+#include "circularbuffer/State.hpp"
+#include "circularbuffer/Writer.hpp"
+
+namespace CB = CircularBuffer;
+using CB::BufferT;
+using CB::DataT;
+
+namespace {
+
+constexpr size_t bufferSize = 1024 * 1024;
+constexpr int interval = 16;
+
+CB::Spec MakeSpec() {
+    CB::Spec spec{"/testing-index", "/testing-data", bufferSize};
+    spec.seekInterval = interval;
+    return spec;
+}
+
+// Writes messages carrying their index
+void WriteMessages(CB::Writer &writer, int first, int count) {
+    for (int i = first; i < first + count; i++) {
+        writer.Write(reinterpret_cast<DataT *>(&i), sizeof(i));
+    }
+}
+
+int MessageIndex(BufferT buffer) {
+    int index;
+    std::memcpy(&index, buffer.data(), sizeof(index));
+    return index;
+}
+
+}  // namespace
+
+TEST(GroupReader, Constructor) {
+    // Writer doesn't number messages
+    {
+        const CB::Spec spec{"/testing-index", "/testing-data", bufferSize};
+        CB::Writer writer(spec);
+        EXPECT_THROW(CB::GroupReader(spec, 0), std::logic_error);
+    }
+
+    const CB::Spec spec = MakeSpec();
+    CB::Writer writer(spec);
+    EXPECT_NO_THROW(CB::GroupReader(spec, 0));
+    EXPECT_NO_THROW(CB::GroupReader(spec, CB::MAX_CONSUMER_GROUPS - 1, 1));
+    EXPECT_THROW(CB::GroupReader(spec, -1), std::invalid_argument);
+    EXPECT_THROW(CB::GroupReader(spec, CB::MAX_CONSUMER_GROUPS),
+                 std::invalid_argument);
+    EXPECT_THROW(CB::GroupReader(spec, 0, 0), std::invalid_argument);
+}
+
+TEST(GroupReader, SplitBatches) {
+    const CB::Spec spec = MakeSpec();
+    CB::Writer writer(spec);
+    const int batch = 4;
+    CB::GroupReader member1(spec, 0, batch);
+    CB::GroupReader member2(spec, 0, batch);
+    // Other groups and plain readers are independent
+    CB::GroupReader otherGroup(spec, 1, batch);
+    CB::Reader reader(spec);
+
+    BufferT buffer = MakeBuffer(sizeof(int));
+
+    // Nothing written yet: members claim the first two batches and wait
+    EXPECT_EQ(member1.Read(buffer), 0);
+    EXPECT_EQ(member2.Read(buffer), 0);
+
+    // Each member gets its own batch, in order
+    WriteMessages(writer, 0, 100);
+    for (int i = 0; i < batch; i++) {
+        ASSERT_EQ(member1.Read(buffer), sizeof(int));
+        EXPECT_EQ(MessageIndex(buffer), i);
+        EXPECT_EQ(member1.LastMessageNumber(), i);
+        ASSERT_EQ(member2.Read(buffer), sizeof(int));
+        EXPECT_EQ(MessageIndex(buffer), batch + i);
+    }
+
+    // Member 1 drains the rest alone, starting with the next unclaimed batch
+    for (int i = 2 * batch; i < 100; i++) {
+        ASSERT_EQ(member1.Read(buffer), sizeof(int));
+        EXPECT_EQ(MessageIndex(buffer), i);
+    }
+    EXPECT_EQ(member1.Read(buffer), 0);
+    EXPECT_EQ(member2.Read(buffer), 0);
+    SharedMemory stateShMem(spec.indexSharedMemoryName, sizeof(CB::State));
+    EXPECT_EQ(stateShMem.AsStruct<CB::State>()->groups[0].cursor,
+              100 + 2 * batch);
+
+    // Other group and plain reader see every message
+    for (int i = 0; i < 100; i++) {
+        ASSERT_EQ(otherGroup.Read(buffer), sizeof(int));
+        EXPECT_EQ(MessageIndex(buffer), i);
+        ASSERT_EQ(reader.Read(buffer), sizeof(int));
+        EXPECT_EQ(MessageIndex(buffer), i);
+    }
+
+    delete[] buffer.data();
+}
+
+TEST(GroupReader, Threads) {
+    const CB::Spec spec = MakeSpec();
+    CB::Writer writer(spec);
+
+    const int numMembers = 4;
+    const int count = 50000;
+    std::vector<std::atomic<int>> received(count);
+    std::atomic<int> total{0};
+
+    // Members wait for messages, each read exactly once across the group
+    std::vector<std::thread> members;
+    for (int m = 0; m < numMembers; m++) {
+        members.emplace_back([&, m] {
+            CB::GroupReader member(spec, 0, m + 1);
+            BufferT buffer = MakeBuffer(sizeof(int));
+            int last = -1;
+            while (total.load() < count) {
+                const int ret = member.Read(buffer);
+                if (ret == 0) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                ASSERT_EQ(ret, sizeof(int));
+                // Each member sees increasing messages
+                const int index = MessageIndex(buffer);
+                ASSERT_GT(index, last);
+                last = index;
+                received[index]++;
+                total++;
+            }
+            delete[] buffer.data();
+        });
+    }
+
+    // Write in batches that can't overwrite unread messages
+    for (int i = 0; i < count; i += 1000) {
+        while (total.load() < i - 10000) {
+            std::this_thread::yield();
+        }
+        WriteMessages(writer, i, 1000);
+    }
+
+    for (std::thread &member : members) {
+        member.join();
+    }
+    EXPECT_EQ(total, count);
+    for (int i = 0; i < count; i++) {
+        ASSERT_EQ(received[i], 1) << "message " << i;
+    }
+}
+
+TEST(GroupReader, SkipOverwritten) {
+    const CB::Spec spec = MakeSpec();
+    CB::Writer writer(spec);
+    CB::GroupReader member(spec, 0, 8);
+    BufferT buffer = MakeBuffer(sizeof(int));
+
+    // Claim the first batch, then lap the member
+    WriteMessages(writer, 0, 10);
+    ASSERT_EQ(member.Read(buffer), sizeof(int));
+    const int written = 3 * bufferSize / (CB::HEADER_SIZE +
+                                          CB::MESSAGE_NUMBER_SIZE + sizeof(int));
+    WriteMessages(writer, 10, written - 10);
+
+    // Overwrite reported once, then the group resumes at the oldest indexed
+    // message still in the buffer
+    EXPECT_EQ(member.Read(buffer), INT_MIN);
+    ASSERT_EQ(member.Read(buffer), sizeof(int));
+    const int resumed = MessageIndex(buffer);
+    EXPECT_EQ(resumed % interval, 0);
+    EXPECT_GT(resumed, written - static_cast<int>(bufferSize / 16));
+    for (int i = resumed + 1; i < written; i++) {
+        ASSERT_EQ(member.Read(buffer), sizeof(int));
+        ASSERT_EQ(MessageIndex(buffer), i);
+    }
+    EXPECT_EQ(member.Read(buffer), 0);
+
+    delete[] buffer.data();
+}
@@ -0,0 +1,60 @@
+#include "circularbuffer/LatencyHistogram.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+
+using CircularBuffer::LatencyHistogram;
+using CircularBuffer::LatencySnapshot;
+
+TEST(LatencyHistogram, BucketBounds) {
+    // Every value falls within its bucket's bounds
+    for (uint64_t value : {0UL, 1UL, 15UL, 16UL, 17UL, 31UL, 32UL, 1000UL,
+                           123'456'789UL, UINT64_MAX}) {
+        const size_t index = LatencySnapshot::BucketIndex(value);
+        ASSERT_LT(index, LatencySnapshot::NUM_BUCKETS);
+        EXPECT_LE(LatencySnapshot::BucketLowerBound(index), value);
+        if (index + 1 < LatencySnapshot::NUM_BUCKETS) {
+            EXPECT_GT(LatencySnapshot::BucketLowerBound(index + 1), value);
+        }
+    }
+}
+
+TEST(LatencyHistogram, Empty) {
+    LatencyHistogram histogram;
+    const LatencySnapshot snapshot = histogram.Snapshot();
+
+    EXPECT_EQ(snapshot.count, 0);
+    EXPECT_EQ(snapshot.Percentile(50), 0);
+    EXPECT_EQ(snapshot.Mean(), 0.0);
+}
+
+TEST(LatencyHistogram, Percentiles) {
+    LatencyHistogram histogram;
+    for (uint64_t i = 1; i <= 1000; i++) {
+        histogram.Record(i);
+    }
+
+    const LatencySnapshot snapshot = histogram.Snapshot();
+    EXPECT_EQ(snapshot.count, 1000);
+    EXPECT_EQ(snapshot.min, 1);
+    EXPECT_EQ(snapshot.max, 1000);
+    EXPECT_DOUBLE_EQ(snapshot.Mean(), 500.5);
+
+    // Within bucket precision (1/16)
+    EXPECT_NEAR(snapshot.Percentile(50), 500, 500 / 16);
+    EXPECT_NEAR(snapshot.Percentile(99), 990, 990 / 16);
+    EXPECT_EQ(snapshot.Percentile(100), 1000);
+    EXPECT_EQ(snapshot.Percentile(0), 1);
+}
+
+TEST(LatencyHistogram, Reset) {
+    LatencyHistogram histogram;
+    histogram.Record(42);
+    histogram.Reset();
+
+    const LatencySnapshot snapshot = histogram.Snapshot();
+    EXPECT_EQ(snapshot.count, 0);
+    EXPECT_EQ(snapshot.buckets[LatencySnapshot::BucketIndex(42)], 0);
+}
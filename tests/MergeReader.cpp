@@ -0,0 +1,261 @@
+#include "circularbuffer/MergeReader.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Utils.hpp"
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Clock.hpp"
+#include "circularbuffer/Reader.hpp"
+#include "circularbuffer/Spec.hpp"
+#include "circularbuffer/Writer.hpp"
+
+namespace CB = CircularBuffer;
+using CB::BufferT;
+using CB::DataT;
+
+namespace {
+
+constexpr size_t bufferSize = 1024 * 1024;
+constexpr int numInputs = 3;
+
+CB::Spec MakeSpec(int i, CB::ClockSource clock = CB::ClockSource::Monotonic) {
+    const std::string suffix = std::format("-{}", i);
+    CB::Spec spec{"/testing-index" + suffix, "/testing-data" + suffix,
+                  bufferSize};
+    spec.timestamps = clock;
+    return spec;
+}
+
+std::vector<CB::Spec> MakeSpecs() {
+    std::vector<CB::Spec> specs;
+    for (int i = 0; i < numInputs; i++) {
+        specs.push_back(MakeSpec(i));
+    }
+    return specs;
+}
+
+class Writers {
+public:
+    explicit Writers(const std::vector<CB::Spec> &specs) {
+        for (const CB::Spec &spec : specs) {
+            m_Writers.push_back(new CB::Writer(spec));
+        }
+    }
+    ~Writers() {
+        for (CB::Writer *writer : m_Writers) {
+            delete writer;
+        }
+    }
+
+    // Writes message `index` to input `input`
+    void Write(int input, int index) {
+        m_Writers[input]->Write(reinterpret_cast<DataT *>(&index),
+                                sizeof(index));
+    }
+
+private:
+    std::vector<CB::Writer *> m_Writers;
+};
+
+// Reads a message, waiting for the merge to emit it
+int ReadNext(CB::MergeReader &merge, BufferT buffer) {
+    const auto start = std::chrono::steady_clock::now();
+    int ret;
+    while ((ret = merge.Read(buffer)) == 0 &&
+           std::chrono::steady_clock::now() - start < std::chrono::seconds(5)) {
+    }
+    return ret;
+}
+
+int MessageIndex(BufferT buffer) {
+    int index;
+    std::memcpy(&index, buffer.data(), sizeof(index));
+    return index;
+}
+
+}  // namespace
+
+TEST(MergeReader, Constructor) {
+    EXPECT_THROW(CB::MergeReader(std::vector<CB::Spec>{}),
+                 std::invalid_argument);
+
+    // Inputs must be timestamped with the same clock
+    {
+        Writers writers({MakeSpec(0), MakeSpec(1, CB::ClockSource::None)});
+        EXPECT_THROW(CB::MergeReader({MakeSpec(0), MakeSpec(1)}),
+                     std::logic_error);
+    }
+    {
+        Writers writers({MakeSpec(0), MakeSpec(1, CB::ClockSource::TSC)});
+        EXPECT_THROW(CB::MergeReader({MakeSpec(0), MakeSpec(1)}),
+                     std::logic_error);
+    }
+
+    Writers writers(MakeSpecs());
+    EXPECT_NO_THROW(CB::MergeReader{MakeSpecs()});
+}
+
+TEST(MergeReader, TimestampOrder) {
+    const std::vector<CB::Spec> specs = MakeSpecs();
+    Writers writers(specs);
+    CB::MergeReader merge(specs);
+    BufferT buffer = MakeBuffer(sizeof(int));
+
+    // Messages written to inputs in a scrambled order come out in the order
+    // they were written
+    const int count = 10000;
+    std::vector<int> inputs(count);
+    for (int i = 0; i < count; i++) {
+        inputs[i] = (i * 7919 + i / 5) % numInputs;
+        writers.Write(inputs[i], i);
+    }
+    for (int i = 0; i < count; i++) {
+        ASSERT_EQ(ReadNext(merge, buffer), sizeof(int));
+        ASSERT_EQ(MessageIndex(buffer), i);
+        ASSERT_EQ(merge.LastInput(), static_cast<size_t>(inputs[i]));
+    }
+    EXPECT_EQ(merge.Read(buffer), 0);
+
+    delete[] buffer.data();
+}
+
+TEST(MergeReader, HoldBack) {
+    const std::vector<CB::Spec> specs = {MakeSpec(0), MakeSpec(1)};
+    Writers writers(specs);
+    CB::MergeReader merge(specs, {.maxDelayNanos = 60'000'000'000});
+    BufferT buffer = MakeBuffer(sizeof(int));
+
+    // An empty input holds back the other, as it could still produce an
+    // older message
+    writers.Write(0, 0);
+    EXPECT_EQ(merge.Read(buffer), 0);
+    writers.Write(1, 1);
+    ASSERT_EQ(merge.Read(buffer), sizeof(int));
+    EXPECT_EQ(MessageIndex(buffer), 0);
+    EXPECT_EQ(merge.Read(buffer), 0);
+
+    // Too small a buffer leaves the message pending
+    writers.Write(0, 2);
+    BufferT smallBuffer = MakeBuffer(sizeof(int) - 1);
+    EXPECT_EQ(merge.Read(smallBuffer), -1);
+    ASSERT_EQ(merge.Read(buffer), sizeof(int));
+    EXPECT_EQ(MessageIndex(buffer), 1);
+    EXPECT_EQ(merge.LastInput(), 1);
+
+    delete[] buffer.data();
+    delete[] smallBuffer.data();
+}
+
+TEST(MergeReader, Forward) {
+    const std::vector<CB::Spec> specs = MakeSpecs();
+    Writers writers(specs);
+    CB::MergeReader merge(specs, {.maxDelayNanos = 0});
+    const CB::Spec outputSpec = MakeSpec(numInputs);
+    CB::Writer output(outputSpec);
+    CB::Reader reader(outputSpec);
+    BufferT buffer = MakeBuffer(sizeof(int));
+
+    // Merged stream published as a ring
+    const int count = 1000;
+    for (int i = 0; i < count; i++) {
+        writers.Write(i % numInputs, i);
+    }
+    int forwarded = 0;
+    while (forwarded < count) {
+        const int ret = merge.Forward(output);
+        ASSERT_GE(ret, 0);
+        forwarded += ret;
+    }
+    for (int i = 0; i < count; i++) {
+        ASSERT_EQ(reader.Read(buffer), sizeof(int));
+        ASSERT_EQ(MessageIndex(buffer), i);
+    }
+    EXPECT_EQ(reader.Read(buffer), 0);
+
+    delete[] buffer.data();
+}
+
+TEST(MergeReader, ForwardRejected) {
+    const std::vector<CB::Spec> specs = {MakeSpec(0)};
+    CB::Writer input(specs.front());
+    CB::MergeReader merge(specs, {.maxDelayNanos = 0});
+    // Output ring can't hold messages over half its capacity
+    CB::Spec outputSpec = MakeSpec(numInputs);
+    outputSpec.bufferCapacity = 4096;
+    outputSpec.contiguousRecords = true;
+    CB::Writer output(outputSpec);
+    CB::Reader reader(outputSpec);
+
+    const size_t bigSize = 3000;
+    BufferT big = MakeBuffer(bigSize);
+    BufferT buffer = MakeBuffer(bigSize);
+    int index = 0;
+    input.Write(reinterpret_cast<DataT *>(&index), sizeof(index));
+    ASSERT_TRUE(input.Write(big));
+    index = 1;
+    input.Write(reinterpret_cast<DataT *>(&index), sizeof(index));
+
+    // Messages before the rejected one are forwarded, which then stays pending
+    EXPECT_EQ(merge.Forward(output), -1);
+    EXPECT_EQ(merge.Forward(output), -1);
+    ASSERT_EQ(reader.Read(buffer), sizeof(int));
+    EXPECT_EQ(MessageIndex(buffer), 0);
+    EXPECT_EQ(reader.Read(buffer), 0);
+
+    // Taken with Read() instead, after which forwarding carries on
+    EXPECT_EQ(merge.Read(buffer), bigSize);
+    EXPECT_EQ(merge.Forward(output), 1);
+    ASSERT_EQ(reader.Read(buffer), sizeof(int));
+    EXPECT_EQ(MessageIndex(buffer), 1);
+
+    delete[] big.data();
+    delete[] buffer.data();
+}
+
+TEST(MergeReader, Lapped) {
+    const std::vector<CB::Spec> specs = {MakeSpec(0), MakeSpec(1)};
+    CB::Writer lapped(specs[0]);
+    CB::Writer other(specs[1]);
+    CB::MergeReader merge(specs, {.maxDelayNanos = 0});
+    BufferT buffer = MakeBuffer(sizeof(int));
+
+    // Input 0 gets lapped while input 1 has a message pending
+    BufferT big = MakeBuffer(CB::MAX_MESSAGE_SIZE);
+    for (size_t written = 0; written <= 2 * bufferSize;
+         written += big.size_bytes()) {
+        ASSERT_TRUE(lapped.Write(big));
+    }
+    int index = 0;
+    other.Write(reinterpret_cast<DataT *>(&index), sizeof(index));
+
+    // Reported once, after which input 0 resumes at its latest message and
+    // the merge carries on
+    EXPECT_EQ(merge.Read(buffer), INT_MIN);
+    ASSERT_EQ(ReadNext(merge, buffer), sizeof(int));
+    EXPECT_EQ(MessageIndex(buffer), 0);
+    EXPECT_EQ(merge.LastInput(), 1);
+    for (index = 1; index < 10; index++) {
+        CB::Writer &writer = index % 2 == 0 ? other : lapped;
+        writer.Write(reinterpret_cast<DataT *>(&index), sizeof(index));
+    }
+    for (index = 1; index < 10; index++) {
+        ASSERT_EQ(ReadNext(merge, buffer), sizeof(int));
+        ASSERT_EQ(MessageIndex(buffer), index);
+        ASSERT_EQ(merge.LastInput(),
+                  static_cast<size_t>(index % 2 == 0 ? 1 : 0));
+    }
+    EXPECT_EQ(merge.Read(buffer), 0);
+
+    delete[] big.data();
+    delete[] buffer.data();
+}
@@ -1,19 +1,32 @@
 #include "circularbuffer/Reader.hpp"
 
 #include <gtest/gtest.h>
+#include <poll.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
+#include <chrono>
+#include <climits>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <span>
+#include <thread>
 
 #include "Reader.hpp"
 #include "Utils.hpp"
 #include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Stats.hpp"
 
 namespace CB = CircularBuffer;
 using CB::BufferT;
 using CB::DataT;
 using CB::HEADER_SIZE;
 using CB::MAX_MESSAGE_SIZE;
+using CB::SeqNumT;
 
 TEST_F(Reader, Constructor) {
     // Construct successfully
@@ -131,3 +144,905 @@ TEST_F(Reader, ReadFailBufferTooSmall) {
     delete[] readBuffer.data();
     delete[] writeBuffer.data();
 }
+
+TEST_F(Reader, Stats) {
+    // Replace writer with one that publishes statistics
+    delete writer;
+    spec.enableStats = true;
+    writer = new CB::Writer(spec);
+
+    CB::Reader reader1(spec);
+
+    // Reader claimed the first slot
+    const CB::ReaderStats& slot = state->stats.readers[0];
+    EXPECT_EQ(slot.pid, getpid());
+    EXPECT_EQ(slot.messages, 0);
+
+    {
+        // Second reader gets its own slot and releases it on destruction
+        CB::Reader reader2(spec);
+        EXPECT_EQ(state->stats.readers[1].pid, getpid());
+    }
+    EXPECT_EQ(state->stats.readers[1].pid, 0);
+
+    // A reader that dies holding its slot leaves it to the next reader
+    const pid_t child = fork();
+    ASSERT_NE(child, -1);
+    if (child == 0) {
+        _exit(0);
+    }
+    ASSERT_EQ(waitpid(child, nullptr, 0), child);
+    state->stats.readers[1].pid = child;
+    {
+        CB::Reader reader2(spec);
+        EXPECT_EQ(state->stats.readers[1].pid, getpid());
+    }
+
+    // Read a message and check lag is tracked
+    const int msgSize = 128;
+    BufferT writeBuffer = MakeBuffer(msgSize, '\1');
+    BufferT readBuffer = MakeBuffer(MAX_MESSAGE_SIZE);
+
+    writer->Write(writeBuffer);
+    writer->Write(writeBuffer);
+    EXPECT_EQ(reader1.Read(readBuffer), msgSize);
+    EXPECT_EQ(slot.messages, 1);
+    EXPECT_EQ(state->seqNum - slot.seqNum, msgSize + HEADER_SIZE);
+
+    // Lap the reader and check the overwrite is counted once
+    BufferT bigBuffer = MakeBuffer(MAX_MESSAGE_SIZE, '\1');
+    for (size_t written = 0; written <= bufferSize;
+         written += HEADER_SIZE + MAX_MESSAGE_SIZE) {
+        writer->Write(bigBuffer);
+    }
+    EXPECT_EQ(reader1.Read(readBuffer), INT_MIN);
+    EXPECT_EQ(reader1.Read(readBuffer), INT_MIN);
+    EXPECT_EQ(slot.overwrites, 1);
+
+    delete[] bigBuffer.data();
+    delete[] readBuffer.data();
+    delete[] writeBuffer.data();
+}
+
+TEST_F(Reader, WraparoundSplitMessageContent) {
+    CB::Reader reader(spec);
+
+    // Message with distinct bytes so a misplaced split is detected
+    const int msgSize = MAX_MESSAGE_SIZE;
+    BufferT writeBuffer = MakeBuffer(msgSize);
+    for (int i = 0; i < msgSize; i++) {
+        writeBuffer[i] = static_cast<DataT>(i % 251);
+    }
+    BufferT readBuffer = MakeBuffer(msgSize);
+
+    // Write until the message has wrapped
+    const int writesToWrap = bufferSize / (HEADER_SIZE + msgSize) + 1;
+    for (int i = 0; i < writesToWrap; i++) {
+        writer->Write(writeBuffer);
+        EXPECT_EQ(reader.Read(readBuffer), msgSize);
+        EXPECT_EQ(std::memcmp(readBuffer.data(), writeBuffer.data(), msgSize),
+                  0);
+    }
+
+    delete[] writeBuffer.data();
+    delete[] readBuffer.data();
+}
+
+TEST_F(Reader, AlignedRecords) {
+    struct Framing {
+        size_t alignment;
+        CB::ClockSource clock;
+    };
+
+    for (const Framing framing : {Framing{8, CB::ClockSource::None},
+                                  Framing{16, CB::ClockSource::Monotonic},
+                                  Framing{64, CB::ClockSource::None},
+                                  Framing{64, CB::ClockSource::Monotonic}}) {
+        // Replace writer with one that pads records
+        delete writer;
+        spec.recordAlignment = framing.alignment;
+        spec.timestamps = framing.clock;
+        writer = new CB::Writer(spec);
+
+        CB::Reader reader(spec);
+
+        // Odd sizes so that every record needs padding
+        const int maxMsgSize = 301;
+        BufferT writeBuffer = MakeBuffer(maxMsgSize);
+        for (int i = 0; i < maxMsgSize; i++) {
+            writeBuffer[i] = static_cast<DataT>(i % 251);
+        }
+        BufferT readBuffer = MakeBuffer(maxMsgSize);
+
+        // Wrap around a few times, splitting some messages
+        SeqNumT written = 0;
+        for (int i = 0; written < 3 * bufferSize; i++) {
+            const int msgSize = 1 + (i * 37) % maxMsgSize;
+            ASSERT_TRUE(writer->Write({writeBuffer.data(), size_t(msgSize)}));
+            written = state->seqNum;
+
+            // Records start aligned
+            EXPECT_EQ(state->readIdx % framing.alignment, 0);
+            EXPECT_EQ(written % framing.alignment, 0);
+
+            ASSERT_EQ(reader.Read(readBuffer), msgSize);
+            ASSERT_EQ(
+                std::memcmp(readBuffer.data(), writeBuffer.data(), msgSize), 0);
+        }
+        EXPECT_EQ(reader.Read(readBuffer), 0);
+
+        delete[] writeBuffer.data();
+        delete[] readBuffer.data();
+    }
+}
+
+TEST_F(Reader, ContiguousRecords) {
+    // Records may be split: no zero-copy reads
+    {
+        CB::Reader reader(spec);
+        std::span<const DataT> view;
+        EXPECT_EQ(reader.ReadView(view), -1);
+    }
+
+    for (const size_t alignment : {1, 16}) {
+        // Replace writer with one that keeps records contiguous, and tracks
+        // them in every way that walks records
+        delete writer;
+        spec.recordAlignment = alignment;
+        spec.contiguousRecords = true;
+        spec.enableReplay = true;
+        spec.seekInterval = 16;
+        writer = new CB::Writer(spec);
+
+        CB::Reader reader(spec);
+        BufferT writeBuffer = MakeBuffer(MessageSize(0) + 300, '\1');
+        BufferT readBuffer = MakeBuffer(writeBuffer.size_bytes());
+
+        // Wrap around a few times, alternating copies and views. Views hold
+        // whole messages. Records regularly don't fit at the end of the
+        // buffer.
+        int written = 0;
+        while (state->seqNum < 3 * bufferSize) {
+            WriteMessage(written);
+            if (written % 2 == 0) {
+                ExpectRead(reader, written);
+            } else {
+                std::span<const DataT> view;
+                ASSERT_EQ(reader.ReadView(view), MessageSize(written));
+                int index;
+                std::memcpy(&index, view.data(), sizeof(int));
+                ASSERT_EQ(index, written);
+                ASSERT_EQ(std::memcmp(view.data() + sizeof(int),
+                                      writeBuffer.data() + sizeof(int),
+                                      view.size() - sizeof(int)),
+                          0);
+                ASSERT_TRUE(reader.ViewIntact());
+                ASSERT_EQ(reader.LastMessageNumber(), written);
+            }
+            written++;
+        }
+        EXPECT_EQ(reader.Read(readBuffer), 0);
+
+        // Replay reads every message from the oldest to the latest
+        CB::Reader replayer(spec, {.replay = true});
+        const int oldest = [&] {
+            EXPECT_GT(replayer.Read(readBuffer), 0);
+            return static_cast<int>(replayer.LastMessageNumber());
+        }();
+        EXPECT_GT(oldest, 0);
+        for (int i = oldest + 1; i < written; i++) {
+            ExpectRead(replayer, i);
+        }
+
+        // Seeking hops over skipped space
+        for (int target = written - 1; target > written - 200; target -= 13) {
+            ASSERT_TRUE(reader.Seek(target));
+            std::span<const DataT> view;
+            ASSERT_EQ(reader.ReadView(view), MessageSize(target));
+            ASSERT_EQ(reader.LastMessageNumber(), target);
+        }
+
+        // Lapped views are detected, before or after the fact
+        std::span<const DataT> view;
+        ASSERT_TRUE(reader.Seek(written - 1));
+        ASSERT_EQ(reader.ReadView(view), MessageSize(written - 1));
+        while (state->seqNum < 5 * bufferSize) {
+            ASSERT_TRUE(writer->Write({writeBuffer.data(), 100}));
+        }
+        EXPECT_FALSE(reader.ViewIntact());
+        EXPECT_EQ(reader.ReadView(view), INT_MIN);
+
+        delete[] writeBuffer.data();
+        delete[] readBuffer.data();
+    }
+}
+
+TEST_F(Reader, Replay) {
+    // Writer doesn't track the tail: replaying readers start at the latest
+    // message
+    BufferT writeBuffer = MakeBuffer(sizeof(int) + 300);
+    BufferT readBuffer = MakeBuffer(writeBuffer.size_bytes());
+    writer->Write({writeBuffer.data(), sizeof(int)});
+    {
+        CB::Reader reader(spec, {.replay = true});
+        EXPECT_EQ(reader.Read(readBuffer), 0);
+    }
+
+    for (const size_t alignment : {1, 16}) {
+        // Replace writer with one that tracks the tail
+        delete writer;
+        spec.enableReplay = true;
+        spec.recordAlignment = alignment;
+        writer = new CB::Writer(spec);
+
+        const size_t payloadOffset =
+            (HEADER_SIZE + alignment - 1) & -alignment;
+        const auto recordSize = [&](int i) {
+            return (payloadOffset + MessageSize(i) + alignment - 1) &
+                   -alignment;
+        };
+
+        // Nothing written yet
+        {
+            CB::Reader reader(spec, {.replay = true});
+            EXPECT_EQ(reader.Read(readBuffer), 0);
+        }
+
+        int written = 0;
+        for (int lap = 0; lap < 3; lap++) {
+            // Write at least a buffer's worth
+            const SeqNumT target = state->seqNum + bufferSize;
+            while (state->seqNum < target) {
+                WriteMessage(written++);
+            }
+
+            // Replay reads every message from the oldest to the latest
+            CB::Reader reader(spec, {.replay = true});
+            int first = -1;
+            for (int i = 0;; i++) {
+                const int ret = reader.Read(readBuffer);
+                if (ret == 0) {
+                    break;
+                }
+
+                int index;
+                std::memcpy(&index, readBuffer.data(), sizeof(int));
+                if (first == -1) {
+                    first = index;
+                }
+                ASSERT_EQ(index, first + i);
+                ASSERT_EQ(ret, MessageSize(index));
+            }
+            ASSERT_GT(first, 0);
+
+            // The replayed records fit in the buffer, and the one before the
+            // oldest (almost) doesn't
+            size_t replayed = 0;
+            for (int i = first; i < written; i++) {
+                replayed += recordSize(i);
+            }
+            EXPECT_LE(replayed, bufferSize);
+            EXPECT_GE(replayed + recordSize(first - 1),
+                      bufferSize - HEADER_SIZE);
+        }
+    }
+
+    delete[] writeBuffer.data();
+    delete[] readBuffer.data();
+}
+
+TEST_F(Reader, Conflate) {
+    BufferT readBuffer = MakeBuffer(MessageSize(0) + 300);
+    int written = 0;
+    const auto write = [&](int count) {
+        for (int i = 0; i < count; i++) {
+            WriteMessage(written++);
+        }
+    };
+
+    // Writer doesn't publish the newest record: the reader falls behind
+    {
+        CB::Reader reader(spec, {.conflateLag = 4096});
+        write(10000);
+        EXPECT_EQ(reader.Read(readBuffer), INT_MIN);
+        EXPECT_EQ(reader.Conflations(), 0);
+    }
+
+    delete writer;
+    spec.enableConflation = true;
+    written = 0;
+    writer = new CB::Writer(spec);
+    CB::Reader reader(spec, {.conflateLag = 4096});
+    CB::Reader lapped(spec);
+
+    // Nothing written yet
+    EXPECT_EQ(reader.Read(readBuffer), 0);
+
+    // Within the threshold, every message is read
+    write(10);
+    for (int i = 0; i < 10; i++) {
+        ExpectRead(reader, i);
+    }
+    EXPECT_EQ(reader.Conflations(), 0);
+
+    // Behind by more: skip to the newest message, across several laps too
+    for (const int count : {100, 10000, 100000}) {
+        write(count);
+        ExpectRead(reader, written - 1);
+        EXPECT_EQ(reader.Read(readBuffer), 0);
+    }
+    EXPECT_EQ(reader.Conflations(), 3);
+    EXPECT_EQ(lapped.Read(readBuffer), INT_MIN);
+
+    // Newest record survives a writer resuming the stream
+    delete writer;
+    spec.resume = true;
+    writer = new CB::Writer(spec);
+    write(20000);
+    ExpectRead(reader, written - 1);
+    EXPECT_EQ(reader.Conflations(), 4);
+
+    // A lag beyond the buffer size is clamped, so the reader skips ahead
+    // before it can be overwritten
+    CB::Reader farReader(spec, {.conflateLag = 2 * bufferSize});
+    const SeqNumT start = state->seqNum;
+    write(10000);
+    ASSERT_GT(state->seqNum - start, bufferSize);
+    ASSERT_LT(state->seqNum - start, 2 * bufferSize);
+    ExpectRead(farReader, written - 1);
+    EXPECT_EQ(farReader.Conflations(), 1);
+
+    delete[] readBuffer.data();
+}
+
+TEST_F(Reader, SizeField) {
+    // Message `i` carries its index, with sizes taking up 1, 2 and 3-byte
+    // varints in turn
+    const auto msgSize = [](int i) {
+        const int sizes[] = {i % 100, 200 + (i * 37) % 1000,
+                             16384 + (i * 37) % 1000};
+        return static_cast<int>(sizeof(int)) + sizes[i % 3];
+    };
+    BufferT writeBuffer = MakeBuffer(msgSize(2) + 1000);
+    BufferT readBuffer = MakeBuffer(writeBuffer.size_bytes());
+
+    for (const CB::SizeField field :
+         {CB::SizeField::Uint16, CB::SizeField::Varint}) {
+        // Plain, timestamped and numbered with replay, then aligned records
+        for (int framing = 0; framing < 3; framing++) {
+            delete writer;
+            spec.sizeField = field;
+            spec.timestamps = framing == 1 ? CB::ClockSource::Monotonic
+                                           : CB::ClockSource::None;
+            spec.seekInterval = framing == 1 ? 4 : 0;
+            spec.enableReplay = framing == 1;
+            spec.recordAlignment = framing == 2 ? 8 : 1;
+            writer = new CB::Writer(spec);
+            CB::Reader reader(spec);
+
+            // Header is as small as the field
+            if (framing == 0) {
+                writer->Write({writeBuffer.data(), 1});
+                EXPECT_EQ(state->readIdx,
+                          (field == CB::SizeField::Uint16 ? 2 : 1) + 1);
+                EXPECT_EQ(reader.Read(readBuffer), 1);
+            }
+
+            // Wrap around a few times
+            const SeqNumT start = state->seqNum;
+            int written = 0;
+            while (state->seqNum - start < 3 * bufferSize) {
+                WriteMessage(written, msgSize(written));
+                ExpectRead(reader, written, msgSize(written));
+                written++;
+            }
+            EXPECT_EQ(reader.Read(readBuffer), 0);
+
+            // Seek and replay decode the headers too
+            if (framing == 1) {
+                ASSERT_TRUE(reader.Seek(written - 6));
+                for (int i = written - 6; i < written; i++) {
+                    ExpectRead(reader, i, msgSize(i));
+                }
+
+                CB::Reader replayer(spec, {.replay = true});
+                int i = replayer.Read(readBuffer) > 0
+                            ? static_cast<int>(replayer.LastMessageNumber())
+                            : written;
+                EXPECT_LT(i, written - 10);
+                while (++i < written) {
+                    ExpectRead(replayer, i, msgSize(i));
+                }
+            }
+        }
+    }
+
+    // Messages must fit the field
+    EXPECT_EQ(writer->MaxMessageSize(), MAX_MESSAGE_SIZE);
+    delete writer;
+    spec.sizeField = CB::SizeField::Uint16;
+    writer = new CB::Writer(spec);
+    EXPECT_EQ(writer->MaxMessageSize(), UINT16_MAX - 1);
+    BufferT maxBuffer = MakeBuffer(UINT16_MAX);
+    EXPECT_FALSE(writer->Write(maxBuffer));
+    EXPECT_TRUE(writer->Write({maxBuffer.data(), UINT16_MAX - 1}));
+
+    delete[] writeBuffer.data();
+    delete[] readBuffer.data();
+    delete[] maxBuffer.data();
+}
+
+TEST_F(Reader, Seek) {
+    // Writer doesn't number messages
+    {
+        CB::Reader reader(spec);
+        EXPECT_FALSE(reader.Seek(0));
+    }
+
+    // Replace writer with one that numbers messages
+    delete writer;
+    const int interval = 16;
+    spec.seekInterval = interval;
+    spec.timestamps = CB::ClockSource::Monotonic;
+    writer = new CB::Writer(spec);
+
+    CB::Reader reader(spec);
+
+    BufferT writeBuffer = MakeBuffer(MessageSize(0) + 300);
+    BufferT readBuffer = MakeBuffer(writeBuffer.size_bytes());
+
+    // Header includes message number
+    writer->Write({writeBuffer.data(), sizeof(int)});
+    EXPECT_EQ(state->readIdx, HEADER_SIZE + CB::TIMESTAMP_SIZE +
+                                  CB::MESSAGE_NUMBER_SIZE + sizeof(int));
+    EXPECT_EQ(reader.Read(readBuffer), sizeof(int));
+    EXPECT_EQ(reader.LastMessageNumber(), 0);
+
+    // Wrap around a few times
+    int written = 1;
+    while (state->seqNum < 3 * bufferSize) {
+        WriteMessage(written++);
+    }
+
+    // Seek anywhere among the most recent messages, back and forth
+    const int oldest = written - 2000;
+    for (const int target :
+         {written - 1, oldest, written - interval, oldest + interval + 1,
+          written - 2 * interval - 7}) {
+        ASSERT_TRUE(reader.Seek(target));
+        for (int i = target; i < written; i++) {
+            ExpectRead(reader, i);
+        }
+        EXPECT_EQ(reader.Read(readBuffer), 0);
+    }
+
+    // Overwritten and future messages can't be seeked to, and leave the
+    // position unchanged
+    EXPECT_FALSE(reader.Seek(1));
+    EXPECT_FALSE(reader.Seek(written));
+    EXPECT_FALSE(reader.Seek(written + interval));
+    WriteMessage(written);
+    ExpectRead(reader, written);
+
+    delete[] writeBuffer.data();
+    delete[] readBuffer.data();
+}
+
+TEST_F(Reader, Grow) {
+    // Replace writer with a small one that numbers messages
+    delete writer;
+    const size_t capacity = 4096;
+    const int interval = 4;
+    spec.bufferCapacity = capacity;
+    spec.seekInterval = interval;
+    spec.enableReplay = true;
+    writer = new CB::Writer(spec);
+
+    // 112 B records with the header
+    const int msgSize = sizeof(int) + 96;
+    BufferT readBuffer = MakeBuffer(msgSize);
+    int written = 0;
+
+    // Can only grow
+    EXPECT_FALSE(writer->Grow(capacity));
+    EXPECT_FALSE(writer->Grow(capacity / 2));
+
+    // One reader lags three quarters of the buffer behind, the other is
+    // caught up
+    CB::Reader lagging(spec);
+    CB::Reader caughtUp(spec);
+    while (written < 27) {
+        WriteMessage(written++, msgSize);
+    }
+    for (int i = 0; i < written; i++) {
+        ExpectRead(caughtUp, i, msgSize);
+    }
+
+    // Writing several times the old capacity after growing overwrites neither
+    ASSERT_TRUE(writer->Grow(16 * capacity));
+    EXPECT_EQ(state->stats.capacity, 16 * capacity);
+    const int grownAt = written;
+    while (written < grownAt + 100) {
+        WriteMessage(written++, msgSize);
+    }
+    for (int i = 0; i < written; i++) {
+        ExpectRead(lagging, i, msgSize);
+    }
+    for (int i = grownAt; i < written; i++) {
+        ExpectRead(caughtUp, i, msgSize);
+    }
+    EXPECT_EQ(lagging.Read(readBuffer), 0);
+    EXPECT_EQ(caughtUp.Read(readBuffer), 0);
+
+    // New readers map the new region, which replay starts at. Messages
+    // written before growing can no longer be seeked to.
+    {
+        CB::Reader replayer(spec, {.replay = true});
+        ExpectRead(replayer, grownAt, msgSize);
+        ASSERT_TRUE(replayer.Seek(written - interval - 1));
+        for (int i = written - interval - 1; i < written; i++) {
+            ExpectRead(replayer, i, msgSize);
+        }
+        EXPECT_FALSE(replayer.Seek(grownAt - 1));
+    }
+
+    // A reader that missed two growths is overwritten
+    ASSERT_TRUE(writer->Grow(32 * capacity));
+    ASSERT_TRUE(writer->Grow(64 * capacity));
+    WriteMessage(written++, msgSize);
+    EXPECT_EQ(lagging.Read(readBuffer), INT_MIN);
+
+    // A restarted writer resumes in the grown region, kept alive by a reader
+    // that followed the writer there
+    CB::Reader reader(spec);
+    ASSERT_TRUE(writer->Grow(128 * capacity));
+    WriteMessage(written++, msgSize);
+    WriteMessage(written++, msgSize);
+    ExpectRead(reader, written - 2, msgSize);
+    ExpectRead(reader, written - 1, msgSize);
+    delete writer;
+    spec.resume = true;
+    writer = new CB::Writer(spec);
+    EXPECT_EQ(state->stats.capacity, 128 * capacity);
+    WriteMessage(written++, msgSize);
+    ExpectRead(reader, written - 1, msgSize);
+    EXPECT_EQ(reader.Read(readBuffer), 0);
+
+    delete[] readBuffer.data();
+}
+
+TEST_F(Reader, GrowCaughtUp) {
+    // Replace writer with a small one that sends notifications
+    delete writer;
+    const size_t capacity = 4096;
+    spec.bufferCapacity = capacity;
+    spec.enableNotifications = true;
+    writer = new CB::Writer(spec);
+    CB::Reader reader(spec, {.eventFd = true});
+
+    // 104 B records with the header
+    const int msgSize = sizeof(int) + 96;
+    BufferT readBuffer = MakeBuffer(msgSize);
+    int written = 0;
+
+    // Caught up
+    for (int i = 0; i < 3; i++) {
+        WriteMessage(written++, msgSize);
+        ExpectRead(reader, i, msgSize);
+    }
+    EXPECT_FALSE(reader.Available());
+    EXPECT_EQ(reader.Read(readBuffer), 0);
+
+    // Growing moves the read index back to the start, which is data to read
+    // even before anything is written
+    ASSERT_TRUE(writer->Grow(2 * capacity));
+    EXPECT_TRUE(reader.Available());
+    EXPECT_FALSE(reader.Arm());
+
+    // Then the writer gets back to the reader's index in the new region: the
+    // reader still follows it there and reads every message
+    for (int i = 0; i < 3; i++) {
+        WriteMessage(written++, msgSize);
+    }
+    EXPECT_EQ(state->readIdx, 3 * (HEADER_SIZE + msgSize));
+    EXPECT_TRUE(reader.Available());
+    EXPECT_FALSE(reader.Arm());
+    for (int i = 3; i < written; i++) {
+        ExpectRead(reader, i, msgSize);
+    }
+    EXPECT_FALSE(reader.Available());
+    EXPECT_EQ(reader.Read(readBuffer), 0);
+    EXPECT_TRUE(reader.Arm());
+
+    delete[] readBuffer.data();
+}
+
+TEST_F(Reader, LargeBuffer) {
+    // Replace writer with one whose buffer is above the default size limit,
+    // and too big for 32-bit offsets. Pages are only allocated when written.
+    delete writer;
+    const size_t capacity = size_t{3} << 30;
+    spec.bufferCapacity = capacity;
+    spec.maxBufferCapacity = capacity;
+    spec.hugePages = true;
+    writer = new CB::Writer(spec);
+
+    const int msgSize = sizeof(int) + 96;
+    int written = 0;
+
+    // More than 2 GiB to the end of the buffer
+    CB::Reader reader(spec);
+    for (int i = 0; i < 10; i++) {
+        WriteMessage(written++, msgSize);
+        ExpectRead(reader, i, msgSize);
+    }
+
+    // Restart the writer just short of the end of the buffer, so that the
+    // next records wrap around. The reader keeps the buffer alive.
+    delete writer;
+    const CB::IndexT end = capacity - 50;
+    state->writeIdx = end;
+    state->readIdx = end;
+    state->seqNum = end;
+    spec.resume = true;
+    writer = new CB::Writer(spec);
+
+    CB::Reader wrapping(spec);
+    const int resumedAt = written;
+    for (int i = 0; i < 3; i++) {
+        WriteMessage(written++, msgSize);
+    }
+    for (int i = resumedAt; i < written; i++) {
+        ExpectRead(wrapping, i, msgSize);
+    }
+    EXPECT_EQ(state->readIdx, 3 * (HEADER_SIZE + msgSize) - 50);
+}
+
+TEST_F(Reader, EventFd) {
+    // Writer doesn't send notifications
+    {
+        CB::Reader reader(spec, {.eventFd = true});
+        EXPECT_EQ(reader.EventFd(), -1);
+    }
+
+    // Replace writer with one that does
+    delete writer;
+    spec.enableNotifications = true;
+    writer = new CB::Writer(spec);
+
+    CB::Reader reader(spec, {.eventFd = true});
+    ASSERT_NE(reader.EventFd(), -1);
+    const int epollFd = epoll_create1(0);
+    epoll_event event{.events = EPOLLIN, .data = {}};
+    ASSERT_EQ(epoll_ctl(epollFd, EPOLL_CTL_ADD, reader.EventFd(), &event), 0);
+
+    const int msgSize = 64;
+    BufferT writeBuffer = MakeBuffer(msgSize, '\1');
+    BufferT readBuffer = MakeBuffer(msgSize);
+
+    // No one armed: writer doesn't wake anyone
+    const uint32_t sequence = state->notification.sequence;
+    writer->Write(writeBuffer);
+    EXPECT_EQ(state->notification.sequence, sequence);
+    EXPECT_EQ(epoll_wait(epollFd, &event, 1, 0), 0);
+
+    // Data to read: arming fails
+    EXPECT_FALSE(reader.Arm());
+    EXPECT_EQ(state->notification.armed, 0);
+    EXPECT_EQ(reader.Read(readBuffer), msgSize);
+    EXPECT_EQ(reader.Read(readBuffer), 0);
+
+    for (int i = 0; i < 10; i++) {
+        ASSERT_TRUE(reader.Arm());
+        EXPECT_EQ(state->notification.armed, 1);
+        EXPECT_EQ(epoll_wait(epollFd, &event, 1, 0), 0);
+
+        // Eventfd becomes readable once another thread writes
+        std::thread writerThread([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            writer->Write(writeBuffer);
+        });
+        EXPECT_EQ(epoll_wait(epollFd, &event, 1, 1000), 1);
+        writerThread.join();
+
+        EXPECT_EQ(reader.Read(readBuffer), msgSize);
+        EXPECT_EQ(reader.Read(readBuffer), 0);
+    }
+
+    // Readers destroyed while armed stop counting as waiting
+    {
+        CB::Reader armedReader(spec, {.eventFd = true});
+        EXPECT_TRUE(armedReader.Arm());
+        EXPECT_TRUE(armedReader.Arm());
+        EXPECT_EQ(state->notification.armed, 1);
+    }
+    EXPECT_EQ(state->notification.armed, 0);
+
+    close(epollFd);
+    delete[] writeBuffer.data();
+    delete[] readBuffer.data();
+}
+
+TEST_F(Reader, WriterAlive) {
+    // Alive until shut down
+    {
+        CB::Reader reader(spec);
+        EXPECT_TRUE(reader.WriterAlive());
+        EXPECT_NE(reader.WriterFd(), -1);
+        delete writer;
+        writer = nullptr;
+        EXPECT_FALSE(reader.WriterAlive());
+    }
+
+    // Replaced by a new writer
+    writer = new CB::Writer(spec);
+    {
+        CB::Reader reader(spec);
+        delete writer;
+        writer = new CB::Writer(spec);
+        EXPECT_FALSE(reader.WriterAlive());
+        EXPECT_TRUE(CB::Reader(spec).WriterAlive());
+    }
+
+    // Writer in another process, stopped then killed
+    CB::Spec childSpec{"/testing-alive-index", "/testing-alive-data",
+                       bufferSize};
+    childSpec.heartbeatMs = 5;
+    int ready[2];
+    ASSERT_EQ(pipe(ready), 0);
+    const pid_t child = fork();
+    ASSERT_NE(child, -1);
+    if (child == 0) {
+        CB::Writer childWriter(childSpec);
+        const char byte = 1;
+        (void)!::write(ready[1], &byte, 1);
+        for (;;) {
+            pause();
+        }
+    }
+    char byte;
+    ASSERT_EQ(::read(ready[0], &byte, 1), 1);
+    close(ready[0]);
+    close(ready[1]);
+
+    CB::Reader reader(childSpec);
+    EXPECT_TRUE(reader.WriterAlive());
+
+    // Missed heartbeats give away a stopped writer
+    kill(child, SIGSTOP);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(reader.WriterAlive());
+    kill(child, SIGCONT);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_TRUE(reader.WriterAlive());
+
+    // Pidfd becomes readable as soon as the writer dies
+    kill(child, SIGKILL);
+    pollfd writerPoll{reader.WriterFd(), POLLIN, 0};
+    EXPECT_EQ(poll(&writerPoll, 1, 1000), 1);
+    EXPECT_FALSE(reader.WriterAlive());
+    waitpid(child, nullptr, 0);
+
+    // Clean up after the dead writer
+    sem_unlink("/testing-alive-data-writer");
+    FreeSharedMem(childSpec.indexSharedMemoryName.c_str());
+    FreeSharedMem(childSpec.dataSharedMemoryName.c_str());
+}
+
+TEST_F(Reader, Timestamps) {
+    for (CB::ClockSource clock :
+         {CB::ClockSource::Monotonic, CB::ClockSource::TSC}) {
+        // Replace writer with one that timestamps messages
+        delete writer;
+        spec.timestamps = clock;
+        writer = new CB::Writer(spec);
+
+        CB::Reader reader(spec, {.latencyHistogram = true});
+        CB::Reader plainReader(spec);
+
+        const int msgSize = 128;
+        const int iter = 100;
+        BufferT writeBuffer = MakeBuffer(msgSize, '\1');
+        BufferT readBuffer = MakeBuffer(MAX_MESSAGE_SIZE);
+
+        for (int i = 0; i < iter; i++) {
+            const CB::TimestampT before = CB::ReadClock(clock);
+            writer->Write(writeBuffer);
+
+            // Header includes timestamp
+            EXPECT_EQ(state->readIdx,
+                      (i + 1) * (HEADER_SIZE + CB::TIMESTAMP_SIZE + msgSize));
+
+            EXPECT_EQ(reader.Read(readBuffer), msgSize);
+            EXPECT_GE(reader.LastTimestamp(), before);
+            EXPECT_EQ(readBuffer[0], DataT{'\1'});
+            EXPECT_EQ(plainReader.Read(readBuffer), msgSize);
+        }
+
+        // Only the opted-in reader keeps a histogram
+        const CB::LatencySnapshot latency = reader.Latency();
+        EXPECT_EQ(latency.count, iter);
+        EXPECT_LE(latency.min, latency.Percentile(50));
+        EXPECT_LE(latency.Percentile(50), latency.Percentile(99));
+        EXPECT_LE(latency.Percentile(99), latency.max);
+        EXPECT_EQ(plainReader.Latency().count, 0);
+
+        delete[] writeBuffer.data();
+        delete[] readBuffer.data();
+    }
+}
+
+TEST_F(Reader, ReaderBeforeWriter) {
+    const int msgSize = 128;
+    BufferT writeBuffer = MakeBuffer(msgSize, '\1');
+    BufferT readBuffer = MakeBuffer(MAX_MESSAGE_SIZE);
+
+    // Nothing to decode until a writer publishes its framing
+    CB::Spec lateSpec{"/testing-index-late", "/testing-data-late", bufferSize};
+    lateSpec.timestamps = CB::ClockSource::Monotonic;
+    CB::Reader reader(lateSpec, {.latencyHistogram = true});
+    EXPECT_EQ(reader.Read(readBuffer), 0);
+
+    {
+        CB::Writer lateWriter(lateSpec);
+        EXPECT_TRUE(reader.WriterAlive());
+
+        const CB::TimestampT before = CB::ReadClock(lateSpec.timestamps);
+        lateWriter.Write(writeBuffer);
+        EXPECT_EQ(reader.Read(readBuffer), msgSize);
+        EXPECT_EQ(reader.TimestampClock(), CB::ClockSource::Monotonic);
+        EXPECT_GE(reader.LastTimestamp(), before);
+        EXPECT_EQ(reader.Latency().count, 1);
+    }
+
+    // A new writer resetting the buffer with different framing is followed
+    // from the start of its stream
+    lateSpec.timestamps = CB::ClockSource::None;
+    lateSpec.sizeField = CB::SizeField::Varint;
+    lateSpec.seekInterval = 1;
+    CB::Writer lateWriter(lateSpec);
+    for (int i = 0; i < 3; i++) {
+        lateWriter.Write(writeBuffer);
+    }
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(reader.Read(readBuffer), msgSize);
+        EXPECT_EQ(reader.LastMessageNumber(), i);
+        EXPECT_EQ(readBuffer[msgSize - 1], DataT{'\1'});
+    }
+    EXPECT_EQ(reader.Read(readBuffer), 0);
+    EXPECT_EQ(reader.TimestampClock(), CB::ClockSource::None);
+    EXPECT_EQ(reader.Latency().count, 1);
+
+    delete[] writeBuffer.data();
+    delete[] readBuffer.data();
+}
+
+TEST_F(Reader, StreamingStores) {
+    // Replace writer with one that streams messages of at least 1 KiB
+    delete writer;
+    spec.streamingStoreThreshold = 1024;
+    writer = new CB::Writer(spec);
+
+    CB::Reader reader(spec);
+
+    BufferT writeBuffer = MakeBuffer(MAX_MESSAGE_SIZE);
+    for (int i = 0; i < MAX_MESSAGE_SIZE; i++) {
+        writeBuffer[i] = static_cast<DataT>(i % 251);
+    }
+    BufferT readBuffer = MakeBuffer(MAX_MESSAGE_SIZE);
+
+    // Mix of regular and streamed messages, enough to wrap
+    size_t written = 0;
+    for (int msgSize = 1; written <= 2 * bufferSize;
+         msgSize = msgSize * 3 % MAX_MESSAGE_SIZE + 1) {
+        writer->Write({writeBuffer.data(), static_cast<size_t>(msgSize)});
+        written += HEADER_SIZE + msgSize;
+
+        EXPECT_EQ(reader.Read(readBuffer), msgSize);
+        EXPECT_EQ(std::memcmp(readBuffer.data(), writeBuffer.data(), msgSize),
+                  0);
+    }
+
+    delete[] writeBuffer.data();
+    delete[] readBuffer.data();
+}
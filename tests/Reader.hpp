@@ -4,6 +4,9 @@
 
 #include <cstring>
 
+#include "Utils.hpp"
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Reader.hpp"
 #include "circularbuffer/SharedMemory.hpp"
 #include "circularbuffer/Spec.hpp"
 #include "circularbuffer/State.hpp"
@@ -21,18 +24,52 @@ protected:
         m_StateShMem =
             new SharedMemory(spec.indexSharedMemoryName, sizeof(CB::State));
         state = m_StateShMem->AsStruct<CB::State>();
+        m_WriteBuffer = MakeBuffer(CB::MAX_MESSAGE_SIZE, '\1');
+        m_ReadBuffer = MakeBuffer(CB::MAX_MESSAGE_SIZE);
     }
 
     void TearDown() override {
+        delete[] m_WriteBuffer.data();
+        delete[] m_ReadBuffer.data();
         state = nullptr;
         delete m_StateShMem;
         delete writer;
     }
 
+    // Size of message `i`, such that the writer regularly can't fit the
+    // header or record at the end of the buffer
+    static int MessageSize(int i) {
+        return static_cast<int>(sizeof(int)) + (i * 37) % 301;
+    }
+
+    // Writes message `i`, which carries its index
+    void WriteMessage(int i) { WriteMessage(i, MessageSize(i)); }
+    void WriteMessage(int i, int size) {
+        std::memcpy(m_WriteBuffer.data(), &i, sizeof(int));
+        ASSERT_TRUE(writer->Write({m_WriteBuffer.data(), size_t(size)}));
+    }
+
+    // Reads message `i` with `reader`, checking its number if the writer
+    // numbers messages
+    void ExpectRead(CB::Reader& reader, int i) {
+        ExpectRead(reader, i, MessageSize(i));
+    }
+    void ExpectRead(CB::Reader& reader, int i, int size) {
+        ASSERT_EQ(reader.Read(m_ReadBuffer), size);
+        int index;
+        std::memcpy(&index, m_ReadBuffer.data(), sizeof(int));
+        ASSERT_EQ(index, i);
+        if (reader.MessageNumbers()) {
+            ASSERT_EQ(reader.LastMessageNumber(), i);
+        }
+    }
+
     CB::Spec spec;
     CB::Writer* writer{nullptr};
     CB::State* state{nullptr};
 
 private:
     SharedMemory* m_StateShMem{nullptr};
+    CB::BufferT m_WriteBuffer;
+    CB::BufferT m_ReadBuffer;
 };
@@ -108,9 +108,18 @@ TEST(SharedMemory, ConstructorFailInvalidSizeRequested) {
     // Size too big
     EXPECT_THROW(SharedMemory(g_ValidName, SharedMemory::MAX_SIZE_BYTES + 1),
                  std::domain_error);
+    EXPECT_THROW(SharedMemory(g_ValidName, 1024, false, 1023),
+                 std::domain_error);
 
     // Check that shared memory was not created
     EXPECT_FALSE(SharedMemExists(g_ValidName));
+
+    // Size above the default limit if raised
+    {
+        const size_t size = SharedMemory::MAX_SIZE_BYTES + 1;
+        SharedMemory shm(g_ValidName, size, false, size);
+        EXPECT_EQ(shm.AsSpan<char>().size(), size);
+    }
 }
 
 TEST(SharedMemory, ConstructorFailExistingMemoryWrongSize) {
@@ -244,3 +253,33 @@ TEST(SharedMemory, ConstructMultipleMemoryActuallyShared) {
         EXPECT_EQ(byte, std::byte('b'));
     }
 }
+
+TEST(SharedMemory, ReadOnly) {
+    // Unlink shared memory if it already exists
+    if (SharedMemExists(g_ValidName)) {
+        FreeSharedMem(g_ValidName);
+    }
+
+    // Read-only view can't create memory
+    EXPECT_THROW(SharedMemory(g_ValidName, g_Size, true), std::runtime_error);
+    EXPECT_FALSE(SharedMemExists(g_ValidName));
+
+    {
+        SharedMemory shmem1(g_ValidName, g_Size);
+        std::memset(shmem1.AsSpan<DataT>().data(), 'a', g_Size);
+
+        {
+            // Read-only view sees the data but doesn't take a reference
+            SharedMemory shmem2(g_ValidName, g_Size, true);
+            EXPECT_TRUE(shmem2.ReadOnly());
+            EXPECT_EQ(shmem1.ReferenceCount(), 1);
+            EXPECT_EQ(shmem2.AsSpan<const DataT>()[0], std::byte('a'));
+        }
+
+        // Destroying the view doesn't release anything
+        EXPECT_EQ(shmem1.ReferenceCount(), 1);
+        EXPECT_TRUE(SharedMemExists(g_ValidName));
+    }
+
+    EXPECT_FALSE(SharedMemExists(g_ValidName));
+}
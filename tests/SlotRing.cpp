@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "Utils.hpp"
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/SlotReader.hpp"
+#include "circularbuffer/SlotRing.hpp"
+#include "circularbuffer/SlotWriter.hpp"
+
+namespace CB = CircularBuffer;
+using CB::BufferT;
+using CB::DataT;
+
+namespace {
+
+constexpr size_t slotSize = 128;
+constexpr size_t slotCount = 16;
+
+CB::SlotSpec MakeSpec() { return {"/testing-slots", slotSize, slotCount}; }
+
+constexpr size_t maxMessageSize = slotSize - CB::SLOT_HEADER_SIZE;
+
+}  // namespace
+
+TEST(SlotRing, Constructor) {
+    // Geometry must be powers of two, slots at least a cacheline
+    EXPECT_THROW(CB::SlotWriter({"/testing-slots", 96, slotCount}),
+                 std::invalid_argument);
+    EXPECT_THROW(CB::SlotWriter({"/testing-slots", CB::CACHELINE_SIZE / 2,
+                                 slotCount}),
+                 std::invalid_argument);
+    EXPECT_THROW(CB::SlotWriter({"/testing-slots", slotSize, 12}),
+                 std::invalid_argument);
+
+    CB::SlotWriter writer(MakeSpec());
+    EXPECT_EQ(writer.SlotSize(), slotSize);
+    EXPECT_EQ(writer.SlotCount(), slotCount);
+    EXPECT_EQ(writer.MaxMessageSize(), slotSize - CB::SLOT_HEADER_SIZE);
+
+    // One writer at a time
+    EXPECT_THROW(CB::SlotWriter{MakeSpec()}, std::logic_error);
+
+    // Same ring size, different slots
+    EXPECT_THROW(
+        CB::SlotReader({"/testing-slots", slotSize * 2, slotCount / 2}),
+        std::invalid_argument);
+    EXPECT_NO_THROW(CB::SlotReader{MakeSpec()});
+}
+
+TEST(SlotRing, WriteRead) {
+    CB::SlotWriter writer(MakeSpec());
+    CB::SlotReader reader(MakeSpec());
+    std::vector<DataT> readBuffer(writer.MaxMessageSize());
+
+    // Nothing written yet
+    EXPECT_FALSE(reader.Available());
+    EXPECT_EQ(reader.Read(readBuffer), 0);
+
+    // Too big for a slot
+    std::vector<DataT> tooBig(writer.MaxMessageSize() + 1);
+    EXPECT_FALSE(writer.Write(tooBig));
+
+    // Messages come out in order across many laps
+    for (uint64_t i = 0; i < 10 * slotCount; i++) {
+        WriteMessages(writer, i, 1, maxMessageSize);
+        ASSERT_TRUE(reader.Available());
+        const int ret = reader.Read(readBuffer);
+        ASSERT_TRUE(CheckMessage(i, readBuffer, ret, maxMessageSize));
+    }
+    EXPECT_EQ(writer.Published(), 10 * slotCount);
+    EXPECT_EQ(reader.Next(), 10 * slotCount);
+    EXPECT_EQ(reader.Read(readBuffer), 0);
+
+    // Read buffer too small: the message stays
+    WriteMessages(writer, 10 * slotCount, 1, maxMessageSize);
+    std::vector<DataT> smallBuffer(4);
+    EXPECT_EQ(reader.Read(smallBuffer), -1);
+    const int ret = reader.Read(readBuffer);
+    EXPECT_TRUE(CheckMessage(10 * slotCount, readBuffer, ret, maxMessageSize));
+}
+
+TEST(SlotRing, Lapped) {
+    CB::SlotWriter writer(MakeSpec());
+    CB::SlotReader reader(MakeSpec());
+    std::vector<DataT> readBuffer(writer.MaxMessageSize());
+
+    // Writer laps the reader: it skips to the oldest message still there
+    WriteMessages(writer, 0, 2 * slotCount + 3, maxMessageSize);
+    EXPECT_TRUE(reader.Available());
+    EXPECT_EQ(reader.Read(readBuffer), INT_MIN);
+    EXPECT_EQ(reader.Next(), slotCount + 4);
+    EXPECT_EQ(reader.Lost(), slotCount + 4);
+
+    for (uint64_t i = slotCount + 4; i < 2 * slotCount + 3; i++) {
+        const int ret = reader.Read(readBuffer);
+        ASSERT_TRUE(CheckMessage(i, readBuffer, ret, maxMessageSize));
+    }
+    EXPECT_EQ(reader.Read(readBuffer), 0);
+}
+
+TEST(SlotRing, WriterRestart) {
+    CB::SlotReader reader(MakeSpec());
+    std::vector<DataT> readBuffer(slotSize);
+
+    // A new writer continues the message numbers of the last, so readers
+    // carry on
+    for (int w = 0; w < 3; w++) {
+        CB::SlotWriter writer(MakeSpec());
+        EXPECT_EQ(writer.Published(), w * slotCount / 4);
+        WriteMessages(writer, w * slotCount / 4, slotCount / 4, maxMessageSize);
+    }
+    for (uint64_t i = 0; i < 3 * slotCount / 4; i++) {
+        const int ret = reader.Read(readBuffer);
+        ASSERT_TRUE(CheckMessage(i, readBuffer, ret, maxMessageSize)) << i;
+    }
+
+    // New readers start at the next message
+    CB::SlotReader lateReader(MakeSpec());
+    EXPECT_EQ(lateReader.Next(), 3 * slotCount / 4);
+}
+
+TEST(SlotRing, Concurrent) {
+    constexpr uint64_t numMessages = 500000;
+    CB::SlotWriter writer(MakeSpec());
+    CB::SlotReader reader(MakeSpec());
+    std::atomic<bool> done{false};
+
+    // Readers are lapped all the time, but never see a torn message
+    std::thread thread([&] {
+        std::vector<DataT> readBuffer(slotSize);
+        uint64_t read = 0;
+        while (!done.load(std::memory_order_acquire) || reader.Available()) {
+            const uint64_t next = reader.Next();
+            const int ret = reader.Read(readBuffer);
+            if (ret == 0 || ret == INT_MIN) {
+                continue;
+            }
+            ASSERT_TRUE(CheckMessage(next, readBuffer, ret, maxMessageSize))
+                << next;
+            read++;
+        }
+        EXPECT_EQ(read + reader.Lost(), numMessages);
+    });
+
+    WriteMessages(writer, 0, numMessages, maxMessageSize);
+    done.store(true, std::memory_order_release);
+    thread.join();
+}
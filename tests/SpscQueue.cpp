@@ -0,0 +1,91 @@
+#include "circularbuffer/SpscQueue.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "Utils.hpp"
+#include "circularbuffer/Aliases.hpp"
+
+namespace CB = CircularBuffer;
+using CB::DataT;
+using CB::SpscQueue;
+
+namespace {
+
+// Empty messages included
+constexpr size_t maxMessageSize = 2999;
+
+}  // namespace
+
+TEST(SpscQueue, Constructor) {
+    // Capacity rounded up to a power of two, at least the minimum
+    EXPECT_EQ(SpscQueue(1).Capacity(), std::bit_ceil(SpscQueue::MIN_CAPACITY));
+    EXPECT_EQ(SpscQueue(3 * 1024 * 1024).Capacity(), 4 * 1024 * 1024);
+}
+
+TEST(SpscQueue, PushPop) {
+    SpscQueue queue(1);
+    std::span<const DataT> message;
+
+    // Empty
+    EXPECT_FALSE(queue.Front(message));
+
+    // Fill up
+    uint32_t pushed = 0;
+    while (queue.TryPush(MakeMessage(pushed, maxMessageSize, 0))) {
+        pushed++;
+    }
+    EXPECT_GT(pushed, queue.Capacity() / 3000);
+
+    // Messages come out in order, and wrap around as space is freed
+    uint32_t popped = 0;
+    for (int i = 0; i < 10000; i++) {
+        ASSERT_TRUE(queue.Front(message));
+        ASSERT_TRUE(CheckMessage(popped, message, maxMessageSize, 0));
+        queue.Pop();
+        popped++;
+
+        while (queue.TryPush(MakeMessage(pushed, maxMessageSize, 0))) {
+            pushed++;
+        }
+    }
+
+    // Drain
+    while (queue.Front(message)) {
+        ASSERT_TRUE(CheckMessage(popped, message, maxMessageSize, 0));
+        queue.Pop();
+        popped++;
+    }
+    EXPECT_EQ(popped, pushed);
+}
+
+TEST(SpscQueue, Threads) {
+    SpscQueue queue(1);
+    const uint32_t count = 100000;
+
+    std::thread producer([&] {
+        for (uint32_t i = 0; i < count; i++) {
+            const std::vector<DataT> message =
+                MakeMessage(i, maxMessageSize, 0);
+            while (!queue.TryPush(message)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::span<const DataT> message;
+    for (uint32_t i = 0; i < count; i++) {
+        while (!queue.Front(message)) {
+            std::this_thread::yield();
+        }
+        ASSERT_TRUE(CheckMessage(i, message, maxMessageSize, 0));
+        queue.Pop();
+    }
+    EXPECT_FALSE(queue.Front(message));
+
+    producer.join();
+}
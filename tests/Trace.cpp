@@ -0,0 +1,125 @@
+#include "circularbuffer/Trace.hpp"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Reader.hpp"
+#include "circularbuffer/SharedMemory.hpp"
+#include "circularbuffer/Spec.hpp"
+#include "circularbuffer/Writer.hpp"
+
+namespace CB = CircularBuffer;
+using CB::DataT;
+using CB::TraceEvent;
+using CB::TraceRecord;
+using CB::TraceRing;
+using CB::Tracer;
+
+namespace {
+
+constexpr size_t bufferSize = 4096;
+constexpr char traceName[] = "/testing-trace";
+
+CB::Spec MakeSpec() {
+    return CB::Spec{"/testing-index", "/testing-data", bufferSize};
+}
+
+// Events recorded from position `first` on
+std::vector<TraceEvent> Events(const TraceRing &ring, uint64_t first) {
+    std::vector<TraceEvent> events;
+    const uint64_t head = ring.head.load(std::memory_order_acquire);
+    for (uint64_t i = first; i < head; i++) {
+        const TraceRecord &record = ring.records[i % CB::TRACE_RING_CAPACITY];
+        EXPECT_EQ(record.stamp.load(std::memory_order_acquire), i + 1);
+        events.push_back(record.event.load(std::memory_order_relaxed));
+    }
+    return events;
+}
+
+}  // namespace
+
+// Runs first: tracing is only started from the environment once per process
+TEST(Trace, Environment) {
+    setenv("CB_TRACE", traceName, 1);
+    {
+        CB::Writer writer(MakeSpec());
+        EXPECT_TRUE(Tracer::Enabled());
+    }
+    unsetenv("CB_TRACE");
+    Tracer::Stop();
+    EXPECT_FALSE(Tracer::Enabled());
+}
+
+TEST(Trace, Events) {
+    const CB::Spec spec = MakeSpec();
+    CB::Writer writer(spec);
+    CB::Reader reader(spec);
+    std::vector<DataT> message(100);
+
+    // Nothing recorded until tracing starts
+    writer.Write(message);
+    ASSERT_TRUE(Tracer::Start(traceName));
+    EXPECT_FALSE(Tracer::Start(traceName));
+
+    SharedMemory shmem(traceName, sizeof(TraceRing), true);
+    const TraceRing &ring = *shmem.AsStruct<const TraceRing>();
+    EXPECT_EQ(ring.pid.load(), getpid());
+    EXPECT_GT(ring.nanosPerTick.load(), 0.0);
+    EXPECT_EQ(ring.head.load(), 0u);
+
+    // Publish and read, with index and size
+    EXPECT_EQ(reader.Read(message), 100);
+    writer.Write(message);
+    EXPECT_EQ(reader.Read(message), 100);
+    EXPECT_EQ(Events(ring, 0),
+              (std::vector{TraceEvent::Read, TraceEvent::Publish,
+                           TraceEvent::Read}));
+    const TraceRecord &publish = ring.records[1];
+    EXPECT_EQ(publish.index.load(), 104u);
+    EXPECT_EQ(publish.size.load(), 100u);
+    EXPECT_LE(ring.records[0].ticks.load(), publish.ticks.load());
+
+    // Wraparound recorded before its publish
+    uint64_t first = ring.head.load();
+    do {
+        writer.Write(message);
+    } while (ring.records[(ring.head.load() - 2) % CB::TRACE_RING_CAPACITY]
+                 .event.load() != TraceEvent::Wrap);
+    std::vector<TraceEvent> events = Events(ring, first);
+    EXPECT_EQ(events[events.size() - 2], TraceEvent::Wrap);
+    EXPECT_EQ(events.back(), TraceEvent::Publish);
+
+    // Overwrite recorded once, however many times it is reported
+    first = ring.head.load();
+    for (int i = 0; i < 50; i++) {
+        writer.Write(message);
+    }
+    const uint64_t written = ring.head.load();
+    EXPECT_EQ(reader.Read(message), INT_MIN);
+    EXPECT_EQ(reader.Read(message), INT_MIN);
+    events = Events(ring, written);
+    EXPECT_EQ(events, std::vector{TraceEvent::Overwrite});
+    EXPECT_GT(ring.records[written % CB::TRACE_RING_CAPACITY].size.load(),
+              bufferSize);
+
+    // Ring keeps the newest records
+    for (size_t i = 0; i < CB::TRACE_RING_CAPACITY; i++) {
+        writer.Write(message);
+    }
+    const uint64_t head = ring.head.load();
+    EXPECT_EQ(Events(ring, head - CB::TRACE_RING_CAPACITY).size(),
+              CB::TRACE_RING_CAPACITY);
+
+    // Nothing recorded once stopped
+    Tracer::Stop();
+    EXPECT_FALSE(Tracer::Enabled());
+    writer.Write(message);
+    EXPECT_EQ(ring.head.load(), head);
+}
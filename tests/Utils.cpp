@@ -4,9 +4,11 @@
 #include <sys/mman.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
 #include <format>
+#include <span>
 #include <stdexcept>
 
 bool SharedMemExists(const char *name) {
@@ -43,3 +45,24 @@ BufferT MakeBuffer(const size_t size, char fill) {
     }
     return BufferT{data, size};
 }
+
+std::vector<DataT> MakeMessage(uint64_t i, size_t maxSize, size_t minSize) {
+    const size_t size = minSize + i * 7919 % (maxSize - minSize + 1);
+    std::vector<DataT> message(size, static_cast<DataT>(i));
+    std::memcpy(message.data(), &i, std::min(sizeof(i), size));
+    return message;
+}
+
+bool CheckMessage(uint64_t i, std::span<const DataT> message, size_t maxSize,
+                  size_t minSize) {
+    const std::vector<DataT> expected = MakeMessage(i, maxSize, minSize);
+    return message.size() == expected.size() &&
+           std::memcmp(message.data(), expected.data(), message.size()) == 0;
+}
+
+bool CheckMessage(uint64_t i, BufferT buffer, int size, size_t maxSize,
+                  size_t minSize) {
+    return size >= 0 && static_cast<size_t>(size) <= buffer.size_bytes() &&
+           CheckMessage(i, std::span<const DataT>(buffer.data(), size),
+                        maxSize, minSize);
+}
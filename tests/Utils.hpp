@@ -1,6 +1,11 @@
 #pragma once
 
+#include <gtest/gtest.h>
+
 #include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
 
 #include "circularbuffer/Aliases.hpp"
 
@@ -9,3 +14,23 @@ void RequestSharedMem(const char *name, size_t size);
 void FreeSharedMem(const char *name);
 
 CircularBuffer::BufferT MakeBuffer(size_t size, char fill = '\0');
+
+// Message `i` is `i` repeated to a size from `minSize` to `maxSize` depending
+// on `i`, starting with as much of `i` itself as fits
+std::vector<CircularBuffer::DataT> MakeMessage(uint64_t i, size_t maxSize,
+                                               size_t minSize = 1);
+bool CheckMessage(uint64_t i, std::span<const CircularBuffer::DataT> message,
+                  size_t maxSize, size_t minSize = 1);
+// As above, for a message of `size` B read into `buffer`, or a read error
+bool CheckMessage(uint64_t i, CircularBuffer::BufferT buffer, int size,
+                  size_t maxSize, size_t minSize = 1);
+
+// Writes messages `first` to `first + count - 1`
+template <typename Writer>
+void WriteMessages(Writer &writer, uint64_t first, uint64_t count,
+                   size_t maxSize) {
+    for (uint64_t i = first; i < first + count; i++) {
+        std::vector<CircularBuffer::DataT> message = MakeMessage(i, maxSize);
+        ASSERT_TRUE(writer.Write(message));
+    }
+}
@@ -1,13 +1,19 @@
 #include "circularbuffer/Writer.hpp"
 
 #include <gtest/gtest.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
+#include <cstdint>
 #include <cstring>
 #include <stdexcept>
 
 #include "Utils.hpp"
 #include "Writer.hpp"
 #include "circularbuffer/Aliases.hpp"
+#include "circularbuffer/Reader.hpp"
 #include "circularbuffer/Spec.hpp"
 #include "circularbuffer/State.hpp"
 
@@ -31,6 +37,27 @@ TEST_F(Writer, ConstructorFailIfMultipleWriters) {
     EXPECT_THROW(CB::Writer{spec}, std::logic_error);
 }
 
+TEST_F(Writer, ConstructorFailIfRecordAlignmentInvalid) {
+    // Not a power of two
+    spec.recordAlignment = 24;
+    EXPECT_THROW(CB::Writer{spec}, std::invalid_argument);
+
+    // Smaller than the timestamped header
+    spec.recordAlignment = 8;
+    spec.timestamps = CB::ClockSource::Monotonic;
+    EXPECT_THROW(CB::Writer{spec}, std::invalid_argument);
+
+    // Doesn't divide the buffer
+    spec.timestamps = CB::ClockSource::None;
+    spec.recordAlignment = 64;
+    spec.bufferCapacity = 1000;
+    EXPECT_THROW(CB::Writer{spec}, std::invalid_argument);
+
+    // Writer can be constructed once the spec is fixed
+    spec.bufferCapacity = 1024;
+    EXPECT_NO_THROW(CB::Writer{spec});
+}
+
 TEST_F(Writer, WriteSingleMessage) {
     CB::Writer writer(spec);
 
@@ -85,6 +112,53 @@ TEST_F(Writer, WrapAround) {
     delete[] writeBuffer.data();
 }
 
+TEST_F(Writer, WrapAroundContiguousRecords) {
+    spec.bufferCapacity = 4096;
+    spec.seekInterval = 4;
+    spec.enableReplay = true;
+    spec.contiguousRecords = true;
+    CB::Writer* writer = new CB::Writer(spec);
+    CB::Reader reader(spec);
+
+    // Half the buffer, less the header
+    const int headerSize = HEADER_SIZE + CB::MESSAGE_NUMBER_SIZE;
+    EXPECT_EQ(writer->MaxMessageSize(), 2048 - headerSize);
+    BufferT tooBig = MakeBuffer(2048 - headerSize + 1, '\1');
+    EXPECT_FALSE(writer->Write(tooBig));
+
+    // The last record doesn't fit, but its header does: the rest of the
+    // buffer is skipped, and counted
+    const size_t msgSize = 100;
+    const int recordSize = headerSize + msgSize;
+    const int recordsPerLap = spec.bufferCapacity / recordSize;
+    BufferT writeBuffer = MakeBuffer(msgSize, '\1');
+    for (int i = 0; i <= recordsPerLap; i++) {
+        EXPECT_TRUE(writer->Write(writeBuffer));
+    }
+    EXPECT_EQ(state->seqNum, spec.bufferCapacity + recordSize);
+    EXPECT_EQ(state->writeIdx, recordSize);
+    EXPECT_EQ(state->readIdx, recordSize);
+    EXPECT_EQ(state->tail.index, 2 * recordSize);
+    EXPECT_EQ(state->tail.seqNum, 2 * recordSize);
+    delete writer;
+
+    // A resumed writer walks over the skipped space
+    spec.resume = true;
+    writer = new CB::Writer(spec);
+    EXPECT_EQ(state->seqNum, spec.bufferCapacity + recordSize);
+    EXPECT_EQ(state->writeIdx, recordSize);
+    delete writer;
+
+    // Nothing to resume with records split again
+    spec.contiguousRecords = false;
+    writer = new CB::Writer(spec);
+    EXPECT_EQ(state->seqNum, 0);
+    delete writer;
+
+    delete[] tooBig.data();
+    delete[] writeBuffer.data();
+}
+
 TEST_F(Writer, WriteFailIfMessageTooBig) {
     CB::Writer writer(spec);
 
@@ -94,3 +168,229 @@ TEST_F(Writer, WriteFailIfMessageTooBig) {
 
     delete[] buffer.data();
 }
+
+TEST_F(Writer, Stats) {
+    spec.enableStats = true;
+    CB::Writer writer(spec);
+
+    // Writer publishes capacity and enables stats
+    EXPECT_NE(state->stats.enabled, 0);
+    EXPECT_EQ(state->stats.capacity, bufferSize);
+    EXPECT_EQ(state->stats.messages, 0);
+
+    // Write enough max-size messages to wrap once
+    const size_t msgSize = MAX_MESSAGE_SIZE;
+    BufferT writeBuffer = MakeBuffer(msgSize, '\1');
+    const int writesToWrap = bufferSize / (HEADER_SIZE + msgSize) + 1;
+    for (int i = 0; i < writesToWrap; i++) {
+        EXPECT_TRUE(writer.Write(writeBuffer));
+    }
+
+    // Small message doesn't change max size
+    EXPECT_TRUE(writer.Write({writeBuffer.data(), 1}));
+
+    EXPECT_EQ(state->stats.messages, writesToWrap + 1);
+    EXPECT_EQ(state->stats.bytes, writesToWrap * msgSize + 1);
+    EXPECT_EQ(state->stats.wraps, 1);
+    EXPECT_EQ(state->stats.maxMessageSize, msgSize);
+
+    delete[] writeBuffer.data();
+}
+
+TEST_F(Writer, StatsDisabled) {
+    CB::Writer writer(spec);
+
+    BufferT writeBuffer = MakeBuffer(128, '\1');
+    EXPECT_TRUE(writer.Write(writeBuffer));
+
+    // Nothing published
+    EXPECT_EQ(state->stats.enabled, 0);
+    EXPECT_EQ(state->stats.messages, 0);
+
+    delete[] writeBuffer.data();
+}
+
+// Forks a writer process that writes `messages` messages and stops itself
+static pid_t ForkStoppedWriter(const CB::Spec& spec, int messages) {
+    const pid_t child = fork();
+    if (child == 0) {
+        CB::Writer writer(spec);
+        BufferT writeBuffer = MakeBuffer(100, '\1');
+        for (int i = 0; i < messages; i++) {
+            writer.Write(writeBuffer);
+        }
+        raise(SIGSTOP);
+        for (;;) {
+            pause();
+        }
+    }
+
+    int status;
+    if (child != -1 && (waitpid(child, &status, WUNTRACED) != child ||
+                        !WIFSTOPPED(status))) {
+        return -1;
+    }
+    return child;
+}
+
+TEST_F(Writer, Resume) {
+    spec.bufferCapacity = 4096;
+    spec.seekInterval = 4;
+    spec.enableReplay = true;
+    spec.enableStats = true;
+    BufferT writeBuffer = MakeBuffer(100, '\1');
+    BufferT readBuffer = MakeBuffer(MAX_MESSAGE_SIZE);
+
+    // Reader keeps up with a writer that wraps around
+    CB::Writer* writer = new CB::Writer(spec);
+    CB::Reader reader(spec);
+    for (int i = 0; i < 50; i++) {
+        EXPECT_TRUE(writer->Write(writeBuffer));
+        EXPECT_EQ(reader.Read(readBuffer), 100);
+    }
+    const uint64_t generation = state->liveness.generation;
+    const SeqNumT seqNum = state->seqNum;
+    delete writer;
+
+    // Restarted writer continues the stream under the reader
+    spec.resume = true;
+    writer = new CB::Writer(spec);
+    EXPECT_EQ(state->liveness.generation, generation);
+    EXPECT_EQ(state->seqNum, seqNum);
+    EXPECT_EQ(state->stats.messages, 50);
+    EXPECT_TRUE(reader.WriterAlive());
+    for (CB::MessageNumberT i = 50; i < 100; i++) {
+        EXPECT_TRUE(writer->Write(writeBuffer));
+        EXPECT_EQ(reader.Read(readBuffer), 100);
+        EXPECT_EQ(reader.LastMessageNumber(), i);
+    }
+
+    // Replay and seek still work across the restart
+    CB::Reader replayer(spec, {.replay = true});
+    EXPECT_EQ(replayer.Read(readBuffer), 100);
+    const CB::MessageNumberT oldest = replayer.LastMessageNumber();
+    EXPECT_GT(oldest, 50);
+    for (CB::MessageNumberT number = oldest + 1; number < 100; number++) {
+        EXPECT_EQ(replayer.Read(readBuffer), 100);
+        EXPECT_EQ(replayer.LastMessageNumber(), number);
+    }
+    EXPECT_TRUE(replayer.Seek(97));
+    EXPECT_EQ(replayer.Read(readBuffer), 100);
+    EXPECT_EQ(replayer.LastMessageNumber(), 97);
+    delete writer;
+
+    // Nothing to resume with a different framing
+    spec.seekInterval = 0;
+    writer = new CB::Writer(spec);
+    EXPECT_EQ(state->liveness.generation, generation + 1);
+    EXPECT_EQ(state->seqNum, 0);
+    EXPECT_FALSE(reader.WriterAlive());
+    delete writer;
+
+    delete[] writeBuffer.data();
+    delete[] readBuffer.data();
+}
+
+TEST_F(Writer, ResumeChecksLastRecords) {
+    spec.seekInterval = 4;
+    BufferT writeBuffer = MakeBuffer(100, '\1');
+    CB::Writer* writer = new CB::Writer(spec);
+    CB::Reader reader(spec);
+    for (int i = 0; i < 10; i++) {
+        EXPECT_TRUE(writer->Write(writeBuffer));
+    }
+    const uint64_t generation = state->liveness.generation;
+    const IndexT readIdx = state->readIdx;
+    delete writer;
+
+    // Write in progress when the writer died is dropped
+    state->writeIdx.store(readIdx + 50);
+    spec.resume = true;
+    writer = new CB::Writer(spec);
+    EXPECT_EQ(state->liveness.generation, generation);
+    EXPECT_EQ(state->writeIdx, readIdx);
+    EXPECT_TRUE(writer->Write(writeBuffer));
+    delete writer;
+
+    // Records that don't lead up to the published end reset the buffer
+    state->readIdx.store(state->readIdx + 8);
+    writer = new CB::Writer(spec);
+    EXPECT_EQ(state->liveness.generation, generation + 1);
+    EXPECT_EQ(state->readIdx, 0);
+    delete writer;
+
+    delete[] writeBuffer.data();
+}
+
+TEST_F(Writer, ResumeAfterCrash) {
+    CB::Spec crashSpec{"/testing-crash-index", "/testing-crash-data",
+                       bufferSize};
+    crashSpec.seekInterval = 1;
+    const pid_t child = ForkStoppedWriter(crashSpec, 10);
+    ASSERT_NE(child, -1);
+    CB::Reader reader(crashSpec);
+
+    // Dead writer's lock is only taken over by a writer resuming the stream
+    kill(child, SIGKILL);
+    waitpid(child, nullptr, 0);
+    EXPECT_THROW(CB::Writer{crashSpec}, std::logic_error);
+    crashSpec.resume = true;
+    {
+        CB::Writer writer(crashSpec);
+        BufferT writeBuffer = MakeBuffer(100, '\1');
+        BufferT readBuffer = MakeBuffer(MAX_MESSAGE_SIZE);
+        EXPECT_TRUE(writer.Write(writeBuffer));
+        EXPECT_EQ(reader.Read(readBuffer), 100);
+        EXPECT_EQ(reader.LastMessageNumber(), 10);
+        EXPECT_TRUE(reader.WriterAlive());
+        delete[] writeBuffer.data();
+        delete[] readBuffer.data();
+    }
+
+    // Clean up after the dead writer
+    sem_unlink("/testing-crash-data-writer");
+    FreeSharedMem(crashSpec.indexSharedMemoryName.c_str());
+    FreeSharedMem(crashSpec.dataSharedMemoryName.c_str());
+}
+
+TEST_F(Writer, Standby) {
+    CB::Spec standbySpec{"/testing-standby-index", "/testing-standby-data",
+                         bufferSize};
+    standbySpec.seekInterval = 1;
+    standbySpec.heartbeatMs = 5;
+    const pid_t child = ForkStoppedWriter(standbySpec, 10);
+    ASSERT_NE(child, -1);
+    CB::Reader reader(standbySpec);
+
+    // Standby kills the hung writer once it misses its heartbeat, and takes
+    // over its stream
+    standbySpec.standby = true;
+    {
+        CB::Writer standby(standbySpec);
+        int status;
+        ASSERT_EQ(waitpid(child, &status, 0), child);
+        EXPECT_TRUE(WIFSIGNALED(status));
+        EXPECT_EQ(WTERMSIG(status), SIGKILL);
+
+        BufferT writeBuffer = MakeBuffer(100, '\1');
+        BufferT readBuffer = MakeBuffer(MAX_MESSAGE_SIZE);
+        EXPECT_TRUE(standby.Write(writeBuffer));
+        EXPECT_EQ(reader.Read(readBuffer), 100);
+        EXPECT_EQ(reader.LastMessageNumber(), 10);
+        EXPECT_TRUE(reader.WriterAlive());
+        delete[] writeBuffer.data();
+        delete[] readBuffer.data();
+    }
+
+    // Standby becomes the writer straight away if there is none, and resumes
+    // the stream
+    {
+        CB::Writer standby(standbySpec);
+        EXPECT_TRUE(reader.WriterAlive());
+    }
+
+    // Clean up after the dead writer
+    sem_unlink("/testing-standby-data-writer");
+    FreeSharedMem(standbySpec.indexSharedMemoryName.c_str());
+    FreeSharedMem(standbySpec.dataSharedMemoryName.c_str());
+}